@@ -4,19 +4,58 @@
 
 #include "AIPlayer.h"
 #include "Board.h"
-#include <random>
+#include "MNKBoard.h"
+#include "OpeningBook.h"
+#include <bit>
+#include <chrono>
 
 // Constructor
 // =====================
 
-AIPlayer::AIPlayer(char symbol, const std::string& name)
+AIPlayer::AIPlayer(char symbol, std::string_view name)
     : Player(symbol, name) {
     // Nothing else needed here
 }
 
+void AIPlayer::makeMove(Board& board) {
+    if (tryWinningMove(board)) {return;}
+    else if (tryBlockingMove(board)) {return;}
+    else if (tryTakeCenter(board)) {return;}
+    else {playRandomMove(board); return;}
+}
+
+void AIPlayer::makeMove(MNKBoard& board) {
+    if (tryWinningMove(board)) {return;}
+    else if (tryBlockingMove(board)) {return;}
+    else if (tryTakeCenter(board)) {return;}
+    else {playRandomMove(board); return;}
+}
+
 // Protected helpers
 // =====================
 
+bool AIPlayer::tryBookMove(Board& board) {
+    if (book == nullptr) {
+        return false;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    int row = -1;
+    int col = -1;
+    if (findWinningMove(board, symbol, row, col) || findWinningMove(board, getOpponentSymbol(), row, col)) {
+        return false;   // win or block first, whatever the book says
+    }
+    const int cell = book->bestMove(board);
+    if (cell < 0) {
+        return false;
+    }
+    lastStats.reset();
+    lastStats.principalVariation.emplace_back(cell / 3, cell % 3);
+    board.applyMove(cell / 3, cell % 3, symbol);
+    lastStats.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    return true;
+}
+
 bool AIPlayer::tryWinningMove(Board& board) {
     int row = -1;
     int col = -1;
@@ -94,35 +133,23 @@ bool AIPlayer::tryTakeEdge(Board& board) {
 }
 
 bool AIPlayer::playRandomMove(Board& board) {
-    std::vector<std::pair<int, int>> validMoves;
-
-    // Collect all valid moves
-    for (int r = 0; r < 3; ++r) {
-        for (int c = 0; c < 3; ++c) {
-            if (board.isValidMove(r, c)) {
-                validMoves.emplace_back(r, c);
-            }
-        }
-    }
+    unsigned empty = board.getEmptyMask();
+    int count = std::popcount(empty);
 
     // Safety: if somehow there are no valid moves, just return.
     // In normal game flow, this shouldn't happen because tie/win is checked before calling makeMove.
-    if (validMoves.empty()) {
+    if (count == 0) {
         return false;
     }
 
-    // Randomly select one of the valid moves.
-    std::random_device rd;
-    std::mt19937 rng(rd());
-    std::uniform_int_distribution<int> dist(0,
-        static_cast<int>(validMoves.size()) - 1);
+    // Randomly select one of the empty cells: drop the lowest set bit `skip` times.
+    for (int skip = rng.below(count); skip > 0; --skip) {
+        empty &= empty - 1;
+    }
 
     // Apply said move.
-    const auto& choice = validMoves[dist(rng)];
-    int row = choice.first;
-    int col = choice.second;
-
-    board.applyMove(row, col, symbol);
+    int cell = std::countr_zero(empty);
+    board.applyMove(cell / 3, cell % 3, symbol);
     return true;
 }
 
@@ -141,12 +168,11 @@ bool AIPlayer::wouldWinIfPlayed(Board& board, int row, int col, char s) const {
     if (!board.isValidMove(row, col)) {return false;}
 
     else {
-        // Copy the board and try the move
-        Board temp = board;
-        temp.applyMove(row, col, s);
-
-        // Check if that hypothetical move wins
-        return temp.winCheck(s);
+        // Try the move in place, then take it back
+        board.makeMove(row, col, s);
+        bool wins = board.winCheck(s);
+        board.unmakeMove(row, col);
+        return wins;
     }
 }
 
@@ -154,100 +180,160 @@ bool AIPlayer::wouldWinIfPlayed(Board& board, int row, int col, char s) const {
 // =====================
 
 bool AIPlayer::findWinningMove(Board& board, char testSymbol, int& outRow, int& outCol) const {
-    // Try every empty cell and see if placing testSymbol there
-    // would create a 3-in-a-row for testSymbol.
-    for (int r = 0; r < 3; ++r) {
-        for (int c = 0; c < 3; ++c) {
-
-            // We can only play on valid (empty) cells
-            if (!board.isValidMove(r, c)) {
-                continue;
-            }
+    // Every empty cell that would complete a line for testSymbol, from the
+    // compile-time line table; the lowest one is the first in row-major order.
+    const std::uint16_t wins = Board::Lines::winningCells(board.getMask(testSymbol), board.getEmptyMask());
+    if (wins == 0) {
+        // No winning move found for testSymbol
+        return false;
+    }
 
-            bool win = false;
-
-            // --- Check row r ---
-            {
-                bool rowWin = true;
-                for (int cc = 0; cc < 3; ++cc) {
-                    char value = (cc == c)
-                                 ? testSymbol
-                                 : board.getCellValue(r, cc);
-
-                    if (value != testSymbol) {
-                        rowWin = false;
-                        break;
-                    }
-                }
-                if (rowWin) {
-                    win = true;
-                }
-            }
+    const int cell = std::countr_zero(static_cast<unsigned>(wins));
+    outRow = cell / 3;
+    outCol = cell % 3;
+    return true;
+}
 
-            // --- Check column c ---
-            if (!win) {
-                bool colWin = true;
-                for (int rr = 0; rr < 3; ++rr) {
-                    char value = (rr == r)
-                                 ? testSymbol
-                                 : board.getCellValue(rr, c);
-
-                    if (value != testSymbol) {
-                        colWin = false;
-                        break;
-                    }
-                }
-                if (colWin) {
-                    win = true;
-                }
-            }
+// m,n,k helpers
+// =====================
+
+bool AIPlayer::tryBookMove(MNKBoard& board) {
+    if (book == nullptr) {
+        return false;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    int row = -1;
+    int col = -1;
+    if (findWinningMove(board, symbol, row, col) || findWinningMove(board, getOpponentSymbol(), row, col)) {
+        return false;   // win or block first, whatever the book says
+    }
+    const int cell = book->bestMove(board);
+    if (cell < 0) {
+        return false;
+    }
+    const int cols = board.getCols();
+    lastStats.reset();
+    lastStats.principalVariation.emplace_back(cell / cols, cell % cols);
+    board.applyMove(cell / cols, cell % cols, symbol);
+    lastStats.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    return true;
+}
+
+bool AIPlayer::tryWinningMove(MNKBoard& board) {
+    int row = -1;
+    int col = -1;
+
+    if (findWinningMove(board, symbol, row, col)) {
+        board.applyMove(row, col, symbol);
+        return true;
+    }
+    return false;
+}
+
+bool AIPlayer::tryBlockingMove(MNKBoard& board) {
+    int row = -1;
+    int col = -1;
 
-            // --- Check main diagonal (0,0)-(1,1)-(2,2) ---
-            if (!win && r == c) {
-                bool diagWin = true;
-                for (int i = 0; i < 3; ++i) {
-                    char value = (r == i && c == i)
-                                 ? testSymbol
-                                 : board.getCellValue(i, i);
-
-                    if (value != testSymbol) {
-                        diagWin = false;
-                        break;
-                    }
-                }
-                if (diagWin) {
-                    win = true;
-                }
+    if (findWinningMove(board, getOpponentSymbol(), row, col)) {
+        board.applyMove(row, col, symbol);  // we play *our* symbol to block
+        return true;
+    }
+    return false;
+}
+
+bool AIPlayer::tryTakeCenter(MNKBoard& board) {
+    // Odd sizes have one middle row/column, even sizes have two
+    const int rows = board.getRows();
+    const int cols = board.getCols();
+
+    for (int r = (rows - 1) / 2; r <= rows / 2; ++r) {
+        for (int c = (cols - 1) / 2; c <= cols / 2; ++c) {
+            if (board.isValidMove(r, c)) {
+                board.applyMove(r, c, symbol);
+                return true;
             }
+        }
+    }
+    return false;
+}
+
+bool AIPlayer::tryTakeCorner(MNKBoard& board) {
+    const int lastRow = board.getRows() - 1;
+    const int lastCol = board.getCols() - 1;
+    const int corners[4][2] = {
+        {0, 0},
+        {0, lastCol},
+        {lastRow, 0},
+        {lastRow, lastCol}
+    };
 
-            // --- Check anti-diagonal (0,2)-(1,1)-(2,0) ---
-            if (!win && (r + c == 2)) {
-                bool diagWin = true;
-                for (int i = 0; i < 3; ++i) {
-                    int rr = i;
-                    int cc = 2 - i;
-                    char value = (r == rr && c == cc)
-                                 ? testSymbol
-                                 : board.getCellValue(rr, cc);
-
-                    if (value != testSymbol) {
-                        diagWin = false;
-                        break;
-                    }
-                }
-                if (diagWin) {
-                    win = true;
-                }
+    for (const auto& corner : corners) {
+        if (board.isValidMove(corner[0], corner[1])) {
+            board.applyMove(corner[0], corner[1], symbol);
+            return true;
+        }
+    }
+    return false;  // no available corner
+}
+
+bool AIPlayer::tryTakeEdge(MNKBoard& board) {
+    // Midpoints of the top, left, right and bottom sides (same order as 3x3)
+    const int rows = board.getRows();
+    const int cols = board.getCols();
+    const int edges[4][2] = {
+        {0, cols / 2},
+        {rows / 2, 0},
+        {rows / 2, cols - 1},
+        {rows - 1, cols / 2}
+    };
+
+    for (const auto& edge : edges) {
+        if (board.isValidMove(edge[0], edge[1])) {
+            board.applyMove(edge[0], edge[1], symbol);
+            return true;
+        }
+    }
+    return false;  // no available edge
+}
+
+bool AIPlayer::playRandomMove(MNKBoard& board) {
+    const int rows = board.getRows();
+    const int cols = board.getCols();
+    const int empty = rows * cols - board.getFilledCells();
+
+    if (empty == 0) {
+        return false;
+    }
+
+    // Walk to the chosen empty cell instead of building a move list
+    int skip = rng.below(empty);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (board.isValidMove(r, c) && skip-- == 0) {
+                board.applyMove(r, c, symbol);
+                return true;
             }
+        }
+    }
+    return false;
+}
+
+bool AIPlayer::wouldWinIfPlayed(const MNKBoard& board, int row, int col, char s) const {
+    // No copy needed: the board can check the lines through (row, col) directly
+    return board.isValidMove(row, col) && board.wouldWin(row, col, s);
+}
 
-            if (win) {
+bool AIPlayer::findWinningMove(const MNKBoard& board, char testSymbol,
+                               int& outRow, int& outCol) const {
+    for (int r = 0; r < board.getRows(); ++r) {
+        for (int c = 0; c < board.getCols(); ++c) {
+            if (wouldWinIfPlayed(board, r, c, testSymbol)) {
                 outRow = r;
                 outCol = c;
                 return true;
             }
         }
     }
-
-    // No winning move found for testSymbol
     return false;
-}
\ No newline at end of file
+}
@@ -6,26 +6,67 @@
 #define FINALPROJECT_AIPLAYER_H
 
 #include "Player.h"
+#include "Rng.h"
+#include "SearchStats.h"
+#include <cstdint>
 #include <vector>
 #include <utility>
 
 // Forward declaration to avoid circular includes
 class Board;
+class MNKBoard;
+class OpeningBook;
 
 /**
- * AIPlayer is an abstract base class for all computer-controlled players.
+ * AIPlayer is the base class for all computer-controlled players.
  *
  * It provides shared helper functions that child AI classes (RegularAIPlayer,
  * UnbeatableAIPlayer, MiniMaxAIPlayer) can use to implement their strategies.
+ * Every helper also has an MNKBoard overload for m,n,k-games of any size.
+ *
+ * A player can be given an OpeningBook; the searching players (Unbeatable,
+ * MiniMax, MCTS) play its move, when it has one, instead of searching. The
+ * book is skipped whenever either side can win on the spot: a book move is
+ * only the best statistically, and must not pass over a win or a block.
  */
 class AIPlayer : public Player {
 public:
-    AIPlayer(char symbol, const std::string& name);
+    AIPlayer(char symbol, std::string_view name);
     virtual ~AIPlayer() = default;
 
+    // Plays a move on a 3x3 or an m,n,k board. The default strategy is the
+    // Regular AI one: win, block, take the center, otherwise random.
+    void makeMove(Board& board) override;
+    virtual void makeMove(MNKBoard& board);
+
+    // Reseeds this player's random generator, so its random choices can be replayed
+    void setSeed(std::uint64_t seed) {rng.reseed(seed);}
+
+    // What the most recent makeMove() cost (all zero for players that don't search)
+    const SearchStats& getLastSearchStats() const {return lastStats;}
+
+    // Book consulted before searching (not owned; nullptr for none). One book
+    // can be shared by any number of players and threads.
+    void setOpeningBook(const OpeningBook* openingBook) {book = openingBook;}
+    const OpeningBook* getOpeningBook() const {return book;}
+
 protected:
+    // Per-player generator: no shared state between threads, no syscalls per move
+    Rng rng;
+
+    // Filled in by searching players during makeMove()
+    SearchStats lastStats;
+
+    const OpeningBook* book = nullptr;
+
     // === Shared AI helper functions ===
 
+    // Play the opening book's move for this position, if it has one and
+    // neither side has a winning move to take or block. Returns true if a
+    // move was made (lastStats then holds just that move).
+    bool tryBookMove(Board& board);
+    bool tryBookMove(MNKBoard& board);
+
     // Try to find and play a winning move for this AI's symbol.
     // Returns true if it found and applied a winning move.
     bool tryWinningMove(Board& board);
@@ -39,20 +80,33 @@ protected:
     bool tryTakeCorner(Board& board);
     bool tryTakeEdge(Board& board);
 
-    // Play a random valid move. Returns true if it played a move,
-    // False only if there were no valid moves (should never happen).
+    // Play a random valid move using `rng` (no allocation). Returns true if it
+    // played a move, False only if there were no valid moves (should never happen).
     bool playRandomMove(Board& board);
 
     bool wouldWinIfPlayed(Board& board, int row, int col, char testSymbol) const;
 
+    // === m,n,k versions of the helpers above ===
+    // "Center" is the middle cell (or middle 2x2 block on even sizes), corners are
+    // the four board corners and edges are the midpoints of the four sides.
+    bool tryWinningMove(MNKBoard& board);
+    bool tryBlockingMove(MNKBoard& board);
+    bool tryTakeCenter(MNKBoard& board);
+    bool tryTakeCorner(MNKBoard& board);
+    bool tryTakeEdge(MNKBoard& board);
+    bool playRandomMove(MNKBoard& board);
+    bool wouldWinIfPlayed(const MNKBoard& board, int row, int col, char testSymbol) const;
+
     // Convenience: get the opponent's symbol ('X' <-> 'O')
     char getOpponentSymbol() const;
 
-private:
-    // Helper used internally by tryWinningMove / tryBlockingMove:
+    // Helper used by tryWinningMove / tryBlockingMove (and the benchmarks):
     // looks for a move that would make three-in-a-row for testSymbol.
     // If found, writes the row/col into outRow/outCol and returns true.
     bool findWinningMove(Board& board, char testSymbol, int& outRow, int& outCol) const;
+
+    // Same for an m,n,k board; only the lines through each empty cell are checked.
+    bool findWinningMove(const MNKBoard& board, char testSymbol, int& outRow, int& outCol) const;
 };
 
-#endif //FINALPROJECT_AIPLAYER_H
\ No newline at end of file
+#endif //FINALPROJECT_AIPLAYER_H
\ No newline at end of file
@@ -3,22 +3,17 @@
 //
 
 #include "Board.h"
+#include <bit>
 #include <iostream>
 
-Board::Board() : filledCells(0) {
-    for (int r = 0; r < 3; ++r) {
-        for (int c = 0; c < 3; ++c) {
-            grid[r][c] = ' ';  // empty cell
-        }
-    }
-}
+Board::Board() : xMask(0), oMask(0) {}
 
 void Board::display() const {
     std::cout << "\n   0   1   2\n";
     for (int r = 0; r < 3; r++) {
         std::cout << r << "  ";
         for (int c = 0; c < 3; c++) {
-            std::cout << grid[r][c];
+            std::cout << getCellValue(r, c);
             if (c < 2) std::cout << " | ";
         }
         std::cout << "\n";
@@ -32,61 +27,46 @@ void Board::display() const {
 // Getter
 char Board::getCellValue(int row, int col) const {
     // assume valid indices for now
-    return grid[row][col];
+    const std::uint16_t bit = static_cast<std::uint16_t>(1u << (row * 3 + col));
+    if (xMask & bit) return 'X';
+    if (oMask & bit) return 'O';
+    return ' ';
 }
 
 bool Board::isValidMove(int row, int col) const {
     if (row < 0 || row >= 3 || col < 0 || col >= 3) return false;
-    else return (grid[row][col] == ' ');
+    else return ((xMask | oMask) & (1u << (row * 3 + col))) == 0;
 }
 
 void Board::applyMove(int row, int col, char symbol) {
     // Caller should already have checked isValidMove
-    if (isValidMove(row, col)) {
-        grid[row][col] = symbol;
-        ++filledCells;
+    if (isValidMove(row, col) && (symbol == 'X' || symbol == 'O')) {
+        makeMove(row, col, symbol);
     }
 }
 
 bool Board::winCheck(char symbol) const {
-    // rows
-    for (int r = 0; r < 3; ++r) {
-        if (grid[r][0] == symbol &&
-            grid[r][1] == symbol &&
-            grid[r][2] == symbol) {
-            return true;
-            }
-    }
-
-    // columns
-    for (int c = 0; c < 3; ++c) {
-        if (grid[0][c] == symbol &&
-            grid[1][c] == symbol &&
-            grid[2][c] == symbol) {
-            return true;
-            }
-    }
-
-    // diagonals
-    if (grid[0][0] == symbol &&
-        grid[1][1] == symbol &&
-        grid[2][2] == symbol) {
-        return true;
-        }
-
-    if (grid[0][2] == symbol &&
-        grid[1][1] == symbol &&
-        grid[2][0] == symbol) {
-        return true;
-        }
-
+    // One table load and a bit test
+    if (symbol == 'X') return anyLineFull(LINE_COUNTS[xMask]);
+    if (symbol == 'O') return anyLineFull(LINE_COUNTS[oMask]);
     return false;
 }
 
 bool Board::tieCheck() const {
     // full board and no winner for X or O
-    if (filledCells < 9) {
-        return false;
-    }
-    return !winCheck('X') && !winCheck('O');
-}
\ No newline at end of file
+    return (xMask | oMask) == FULL_MASK && !winCheck('X') && !winCheck('O');
+}
+
+int Board::getFilledCells() const {
+    return std::popcount(static_cast<unsigned>(xMask | oMask));
+}
+
+int Board::getLineCount(int line, char symbol) const {
+    return (LINE_COUNTS[getMask(symbol)] >> (2 * line)) & 0x3;
+}
+
+std::uint16_t Board::getMask(char symbol) const {
+    if (symbol == 'X') return xMask;
+    if (symbol == 'O') return oMask;
+    return 0;
+}
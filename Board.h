@@ -5,10 +5,56 @@
 #ifndef FINALPROJECT_BOARD_H
 #define FINALPROJECT_BOARD_H
 
-class MiniMaxAIPlayer;
+#include <array>
+#include <bit>
+#include <cstdint>
 
+#include "WinLines.h"
+
+/**
+ * Board holds the 3x3 TicTacToe grid as two 9-bit occupancy masks,
+ * one for X and one for O. Cell (row, col) is bit (row * 3 + col).
+ *
+ * A side's 9-bit mask indexes compile-time tables holding, for every
+ * possible mask:
+ *  - how many pieces it has on each of the eight winning lines (and so
+ *    whether it has completed one: winCheck() is a load and a bit test),
+ *  - its half of the position's Zobrist hash.
+ *
+ * The lines come from WinLines<3, 3, 3>.
+ *
+ * Because all of that follows from the masks, makeMove()/unmakeMove() only
+ * set or clear one bit, and the whole state is 4 bytes: a search plays and
+ * takes back moves on one Board, and copying one is as cheap as an int.
+ */
 class Board {
 public:
+    // Compile-time line tables and bit tests for this board size
+    using Lines = WinLines<3, 3, 3>;
+
+    // Bit mask covering all nine cells
+    static constexpr std::uint16_t FULL_MASK = Lines::FULL_MASK;
+
+    // The eight winning lines (3 rows, 3 columns, 2 diagonals) as cell masks
+    static constexpr auto WIN_LINES = Lines::LINES;
+    static_assert(WIN_LINES.size() == 8 && WIN_LINES[6] == 0x111 && WIN_LINES[7] == 0x054);
+
+    // Random keys for Zobrist hashing, one per (side, cell): [0] is X, [1] is O
+    static constexpr auto ZOBRIST = [] {
+        std::array<std::array<std::uint64_t, 9>, 2> keys{};
+        std::uint64_t seed = 0x5A0B0C1D2E3F4051ull;
+        for (auto& side : keys) {
+            for (auto& key : side) {
+                // SplitMix64, as in Rng
+                std::uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                key = z ^ (z >> 31);
+            }
+        }
+        return keys;
+    }();
+
     // Constructor
     Board();
 
@@ -18,16 +64,80 @@ public:
     void applyMove(int row, int col, char symbol);
     bool isValidMove(int row, int col) const; // helper for applyMove()
 
+    // Unchecked versions for search code: makeMove() needs an empty, in-range
+    // cell and 'X' or 'O'; unmakeMove() takes back a piece placed by either.
+    // Moves can be taken back in any order.
+    inline void makeMove(int row, int col, char symbol);
+    inline void unmakeMove(int row, int col);
+
     bool winCheck(char symbol) const;
     bool tieCheck() const;
 
+    // Number of occupied cells (0-9)
+    int getFilledCells() const;
+
+    // Raw occupancy masks, for AI code that wants to work on bits directly
+    std::uint16_t getMask(char symbol) const;
+    std::uint16_t getOccupiedMask() const {return static_cast<std::uint16_t>(xMask | oMask);}
+    std::uint16_t getEmptyMask() const {return static_cast<std::uint16_t>(FULL_MASK & ~(xMask | oMask));}
+
+    // Zobrist hash: equal positions have equal hashes, however they were reached
+    std::uint64_t getHash() const {return MASK_HASH[0][xMask] ^ MASK_HASH[1][oMask];}
+
+    // Pieces `symbol` has on WIN_LINES[line] (0-3)
+    int getLineCount(int line, char symbol) const;
+
+    // True if any winning line is fully covered by `mask`
+    static constexpr bool hasLine(std::uint16_t mask) {return Lines::hasLine(mask);}
+
 private:
+    // LINE_COUNTS[mask]: pieces `mask` has on each line, 2 bits per line
+    // (line i at bits 2i..2i+1)
+    static constexpr auto LINE_COUNTS = [] {
+        std::array<std::uint16_t, 512> counts{};
+        for (int mask = 0; mask < 512; ++mask) {
+            for (int line = 0; line < static_cast<int>(WIN_LINES.size()); ++line) {
+                const int pieces = std::popcount(static_cast<unsigned>(mask & WIN_LINES[line]));
+                counts[mask] = static_cast<std::uint16_t>(counts[mask] | (pieces << (2 * line)));
+            }
+        }
+        return counts;
+    }();
+
+    // MASK_HASH[side][mask]: XOR of ZOBRIST[side] over the cells in `mask`
+    static constexpr auto MASK_HASH = [] {
+        std::array<std::array<std::uint64_t, 512>, 2> hashes{};
+        for (int side = 0; side < 2; ++side) {
+            for (int mask = 1; mask < 512; ++mask) {
+                const int cell = std::countr_zero(static_cast<unsigned>(mask));
+                hashes[side][mask] = hashes[side][mask & (mask - 1)] ^ ZOBRIST[side][cell];
+            }
+        }
+        return hashes;
+    }();
+
     // Not initializing here because may want to test w/ pre-filled board via constructor
-    char grid[3][3];
-    int filledCells;
+    std::uint16_t xMask;
+    std::uint16_t oMask;
 
-    friend class MiniMaxAIPlayer;
+    // True if some 2-bit counter in `counts` has reached 3
+    static bool anyLineFull(std::uint16_t counts) {
+        return (counts & (counts >> 1) & 0x5555) != 0;
+    }
 };
 
+inline void Board::makeMove(int row, int col, char symbol) {
+    const std::uint16_t bit = static_cast<std::uint16_t>(1u << (row * 3 + col));
+    if (symbol == 'X') xMask |= bit;
+    else oMask |= bit;
+}
+
+inline void Board::unmakeMove(int row, int col) {
+    // The cell is only in one of the masks
+    const std::uint16_t keep = static_cast<std::uint16_t>(~(1u << (row * 3 + col)));
+    xMask &= keep;
+    oMask &= keep;
+}
+
 
-#endif //FINALPROJECT_BOARD_H
\ No newline at end of file
+#endif //FINALPROJECT_BOARD_H
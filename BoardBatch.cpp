@@ -0,0 +1,351 @@
+#include "BoardBatch.h"
+#include "Rng.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#include <immintrin.h>
+#define BOARDBATCH_SSE2 1
+#if defined(__GNUC__)
+// Compiled for AVX2 whatever the build flags; only called after a CPU check
+#define BOARDBATCH_AVX2 1
+#define BOARDBATCH_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+#define BOARDBATCH_AVX2 1
+#define BOARDBATCH_AVX2_TARGET
+#endif
+#endif
+
+namespace {
+    // NTH_EMPTY[empty][n] = cell of the n-th lowest set bit of `empty`, so a
+    // random move is one table read instead of a bit-clearing loop
+    constexpr auto NTH_EMPTY = [] {
+        std::array<std::array<std::uint8_t, 9>, 512> table{};
+        for (int empty = 0; empty < 512; ++empty) {
+            int n = 0;
+            for (int cell = 0; cell < 9; ++cell) {
+                if (empty & (1 << cell)) table[empty][n++] = static_cast<std::uint8_t>(cell);
+            }
+        }
+        return table;
+    }();
+
+    // Same scaling as Rng::below, on either half of one 64-bit draw
+    int scaleBelow(std::uint32_t random, int bound) {
+        return static_cast<int>((static_cast<std::uint64_t>(random) * static_cast<std::uint64_t>(bound)) >> 32);
+    }
+
+    char statusOf(std::uint16_t x, std::uint16_t o) {
+        if (Board::hasLine(x)) return 'X';
+        if (Board::hasLine(o)) return 'O';
+        if ((x | o) == Board::FULL_MASK) return 'T';
+        return BoardBatch::IN_PROGRESS;
+    }
+
+    void classifyScalar(const std::uint16_t* x, const std::uint16_t* o, char* out,
+                        std::size_t first, std::size_t count) {
+        for (std::size_t i = first; i < count; ++i) {
+            out[i] = statusOf(x[i], o[i]);
+        }
+    }
+
+    void emptyScalar(const std::uint16_t* x, const std::uint16_t* o, std::uint16_t* out,
+                     std::size_t first, std::size_t count) {
+        for (std::size_t i = first; i < count; ++i) {
+            out[i] = static_cast<std::uint16_t>(Board::FULL_MASK & ~(x[i] | o[i]));
+        }
+    }
+
+#ifdef BOARDBATCH_SSE2
+    // 8 boards per step; returns how many boards it handled
+    std::size_t classifySse2(const std::uint16_t* x, const std::uint16_t* o, char* out,
+                             std::size_t count) {
+        const __m128i full = _mm_set1_epi16(static_cast<short>(Board::FULL_MASK));
+        const __m128i xChar = _mm_set1_epi16('X');
+        const __m128i oChar = _mm_set1_epi16('O');
+        const __m128i tChar = _mm_set1_epi16('T');
+        const __m128i none = _mm_set1_epi16(BoardBatch::IN_PROGRESS);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128i xs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+            const __m128i os = _mm_loadu_si128(reinterpret_cast<const __m128i*>(o + i));
+
+            __m128i xWon = _mm_setzero_si128();
+            __m128i oWon = _mm_setzero_si128();
+            for (std::uint16_t mask : Board::WIN_LINES) {
+                const __m128i line = _mm_set1_epi16(static_cast<short>(mask));
+                xWon = _mm_or_si128(xWon, _mm_cmpeq_epi16(_mm_and_si128(xs, line), line));
+                oWon = _mm_or_si128(oWon, _mm_cmpeq_epi16(_mm_and_si128(os, line), line));
+            }
+            const __m128i isFull = _mm_cmpeq_epi16(_mm_or_si128(xs, os), full);
+
+            // Lowest priority first, so X beats O beats a full board
+            __m128i result = _mm_or_si128(_mm_and_si128(isFull, tChar), _mm_andnot_si128(isFull, none));
+            result = _mm_or_si128(_mm_and_si128(oWon, oChar), _mm_andnot_si128(oWon, result));
+            result = _mm_or_si128(_mm_and_si128(xWon, xChar), _mm_andnot_si128(xWon, result));
+
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i),
+                             _mm_packus_epi16(result, _mm_setzero_si128()));
+        }
+        return i;
+    }
+
+    std::size_t emptySse2(const std::uint16_t* x, const std::uint16_t* o, std::uint16_t* out,
+                          std::size_t count) {
+        const __m128i full = _mm_set1_epi16(static_cast<short>(Board::FULL_MASK));
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m128i xs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+            const __m128i os = _mm_loadu_si128(reinterpret_cast<const __m128i*>(o + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                             _mm_andnot_si128(_mm_or_si128(xs, os), full));
+        }
+        return i;
+    }
+#endif
+
+#ifdef BOARDBATCH_AVX2
+    // 16 boards per step; same steps as the SSE2 version
+    BOARDBATCH_AVX2_TARGET
+    std::size_t classifyAvx2(const std::uint16_t* x, const std::uint16_t* o, char* out,
+                             std::size_t count) {
+        const __m256i full = _mm256_set1_epi16(static_cast<short>(Board::FULL_MASK));
+        const __m256i xChar = _mm256_set1_epi16('X');
+        const __m256i oChar = _mm256_set1_epi16('O');
+        const __m256i tChar = _mm256_set1_epi16('T');
+        const __m256i none = _mm256_set1_epi16(BoardBatch::IN_PROGRESS);
+
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m256i xs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+            const __m256i os = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o + i));
+
+            __m256i xWon = _mm256_setzero_si256();
+            __m256i oWon = _mm256_setzero_si256();
+            for (std::uint16_t mask : Board::WIN_LINES) {
+                const __m256i line = _mm256_set1_epi16(static_cast<short>(mask));
+                xWon = _mm256_or_si256(xWon, _mm256_cmpeq_epi16(_mm256_and_si256(xs, line), line));
+                oWon = _mm256_or_si256(oWon, _mm256_cmpeq_epi16(_mm256_and_si256(os, line), line));
+            }
+            const __m256i isFull = _mm256_cmpeq_epi16(_mm256_or_si256(xs, os), full);
+
+            __m256i result = _mm256_blendv_epi8(none, tChar, isFull);
+            result = _mm256_blendv_epi8(result, oChar, oWon);
+            result = _mm256_blendv_epi8(result, xChar, xWon);
+
+            // packus works per 128-bit half: gather the two halves' bytes into the low 16
+            const __m256i packed = _mm256_permute4x64_epi64(
+                _mm256_packus_epi16(result, _mm256_setzero_si256()), 0xD8);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(packed));
+        }
+        return i;
+    }
+
+    BOARDBATCH_AVX2_TARGET
+    std::size_t emptyAvx2(const std::uint16_t* x, const std::uint16_t* o, std::uint16_t* out,
+                          std::size_t count) {
+        const __m256i full = _mm256_set1_epi16(static_cast<short>(Board::FULL_MASK));
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m256i xs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+            const __m256i os = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(o + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_andnot_si256(_mm256_or_si256(xs, os), full));
+        }
+        return i;
+    }
+
+    bool cpuHasAvx2() {
+#if defined(__GNUC__)
+        return __builtin_cpu_supports("avx2");
+#else
+        return true;   // only compiled in when the build targets AVX2
+#endif
+    }
+#endif
+}
+
+BoardBatch::BoardBatch(std::size_t count) {
+    resize(count);
+}
+
+void BoardBatch::resize(std::size_t count) {
+    xMasks.assign(count, 0);
+    oMasks.assign(count, 0);
+}
+
+void BoardBatch::set(std::size_t index, const Board& board) {
+    xMasks[index] = board.getMask('X');
+    oMasks[index] = board.getMask('O');
+}
+
+Board BoardBatch::get(std::size_t index) const {
+    Board board;
+    for (int cell = 0; cell < 9; ++cell) {
+        if (xMasks[index] & (1u << cell)) board.makeMove(cell / 3, cell % 3, 'X');
+        else if (oMasks[index] & (1u << cell)) board.makeMove(cell / 3, cell % 3, 'O');
+    }
+    return board;
+}
+
+void BoardBatch::fill(const Board& board) {
+    std::fill(xMasks.begin(), xMasks.end(), board.getMask('X'));
+    std::fill(oMasks.begin(), oMasks.end(), board.getMask('O'));
+}
+
+std::uint16_t BoardBatch::getMask(std::size_t index, char symbol) const {
+    if (symbol == 'X') return xMasks[index];
+    if (symbol == 'O') return oMasks[index];
+    return 0;
+}
+
+void BoardBatch::classify(char* outStatus) const {
+    classify(outStatus, bestPath());
+}
+
+void BoardBatch::classify(char* outStatus, Path path) const {
+    const std::size_t count = size();
+    std::size_t done = 0;
+
+    // Each vector path leaves the tail (fewer boards than one register) to the scalar loop
+    switch (path) {
+#ifdef BOARDBATCH_AVX2
+        case Path::Avx2:
+            done = classifyAvx2(xMasks.data(), oMasks.data(), outStatus, count);
+            break;
+#endif
+#ifdef BOARDBATCH_SSE2
+        case Path::Sse2:
+            done = classifySse2(xMasks.data(), oMasks.data(), outStatus, count);
+            break;
+#endif
+        default:
+            break;
+    }
+    classifyScalar(xMasks.data(), oMasks.data(), outStatus, done, count);
+}
+
+void BoardBatch::emptyMasks(std::uint16_t* outMasks) const {
+    emptyMasks(outMasks, bestPath());
+}
+
+void BoardBatch::emptyMasks(std::uint16_t* outMasks, Path path) const {
+    const std::size_t count = size();
+    std::size_t done = 0;
+
+    switch (path) {
+#ifdef BOARDBATCH_AVX2
+        case Path::Avx2:
+            done = emptyAvx2(xMasks.data(), oMasks.data(), outMasks, count);
+            break;
+#endif
+#ifdef BOARDBATCH_SSE2
+        case Path::Sse2:
+            done = emptySse2(xMasks.data(), oMasks.data(), outMasks, count);
+            break;
+#endif
+        default:
+            break;
+    }
+    emptyScalar(xMasks.data(), oMasks.data(), outMasks, done, count);
+}
+
+BoardBatch::Totals BoardBatch::playRandomGames(Rng& rng, char* outResults, std::uint8_t* outMoves) {
+    const std::size_t count = size();
+    if (outMoves != nullptr && count > 0) {
+        std::memset(outMoves, 0xFF, count * 9);
+    }
+    status.resize(count);
+    emptyCounts.resize(count);
+    firstMovers.resize(count);
+    classify(status.data());
+
+    // Every unfinished board gets one move per ply, so its empty-cell count
+    // and side to move follow from the ply: only count them once
+    for (std::size_t i = 0; i < count; ++i) {
+        const int xs = std::popcount(static_cast<unsigned>(xMasks[i]));
+        const int os = std::popcount(static_cast<unsigned>(oMasks[i]));
+        emptyCounts[i] = static_cast<std::uint8_t>(9 - xs - os);
+        firstMovers[i] = static_cast<std::uint8_t>(xs == os ? 0 : 1);
+    }
+
+    // One ply on every unfinished board, then one batched check of them all
+    for (int ply = 0; ply < 9; ++ply) {
+        bool moved = false;
+        std::uint64_t random = 0;
+        bool haveHalf = false;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (status[i] != IN_PROGRESS) continue;
+
+            // Two picks per 64-bit draw
+            if (!haveHalf) random = rng.next();
+            const std::uint32_t half = haveHalf ? static_cast<std::uint32_t>(random)
+                                                : static_cast<std::uint32_t>(random >> 32);
+            haveHalf = !haveHalf;
+
+            const unsigned empty = Board::FULL_MASK & ~(xMasks[i] | oMasks[i]);
+            const int cell = NTH_EMPTY[empty][scaleBelow(half, emptyCounts[i] - ply)];
+            const std::uint16_t bit = static_cast<std::uint16_t>(1u << cell);
+
+            if (((firstMovers[i] ^ ply) & 1) == 0) xMasks[i] |= bit;
+            else oMasks[i] |= bit;
+            if (outMoves != nullptr) outMoves[i * 9 + ply] = static_cast<std::uint8_t>(cell);
+            moved = true;
+        }
+        if (!moved) break;
+        classify(status.data());
+    }
+
+    Totals totals;
+    for (char result : status) {
+        if (result == 'X') totals.xWins++;
+        else if (result == 'O') totals.oWins++;
+        else totals.draws++;
+    }
+    if (outResults != nullptr && count > 0) {
+        std::memcpy(outResults, status.data(), count);
+    }
+    return totals;
+}
+
+BoardBatch::Path BoardBatch::bestPath() {
+    static const Path best = [] {
+        if (supports(Path::Avx2)) return Path::Avx2;
+        if (supports(Path::Sse2)) return Path::Sse2;
+        return Path::Scalar;
+    }();
+    return best;
+}
+
+bool BoardBatch::supports(Path path) {
+    switch (path) {
+        case Path::Scalar:
+            return true;
+        case Path::Sse2:
+#ifdef BOARDBATCH_SSE2
+            return true;
+#else
+            return false;
+#endif
+        case Path::Avx2:
+#ifdef BOARDBATCH_AVX2
+            return cpuHasAvx2();
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+const char* BoardBatch::pathName(Path path) {
+    switch (path) {
+        case Path::Scalar: return "scalar";
+        case Path::Sse2:   return "sse2";
+        case Path::Avx2:   return "avx2";
+    }
+    return "?";
+}
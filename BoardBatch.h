@@ -0,0 +1,85 @@
+#ifndef FINALPROJECT_BOARDBATCH_H
+#define FINALPROJECT_BOARDBATCH_H
+
+#include "Board.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Rng;
+
+/**
+ * BoardBatch holds many independent 3x3 boards as a structure of arrays (all
+ * X masks, then all O masks, same bit layout as Board), so win/tie checks and
+ * empty-cell masks can be computed for a whole batch with SIMD: 16 boards per
+ * AVX2 instruction, 8 per SSE2 instruction, with a scalar fallback.
+ *
+ * AVX2 is picked at run time when the CPU has it (GCC/Clang on x86), SSE2 is
+ * the x86-64 baseline, and other targets use the scalar path. All paths give
+ * the same results.
+ *
+ * playRandomGames() plays every board to the end with random moves in
+ * lockstep, one ply for all boards, then one batched status check. It is used
+ * for the Random vs Random tournament pairing and for MCTS leaf playouts.
+ */
+class BoardBatch {
+public:
+    enum class Path {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    // classify() results
+    static constexpr char IN_PROGRESS = ' ';   // otherwise 'X', 'O' or 'T'
+
+    struct Totals {
+        long long xWins = 0;
+        long long oWins = 0;
+        long long draws = 0;
+    };
+
+    explicit BoardBatch(std::size_t count = 0);
+
+    // Sets the number of boards; every board is cleared
+    void resize(std::size_t count);
+    std::size_t size() const {return xMasks.size();}
+
+    void set(std::size_t index, const Board& board);
+    Board get(std::size_t index) const;
+
+    // Puts `board` in every slot
+    void fill(const Board& board);
+
+    std::uint16_t getMask(std::size_t index, char symbol) const;
+
+    // For every board: 'X' or 'O' if that side has a line (X first, as a
+    // game would have stopped there), 'T' if it is full, IN_PROGRESS otherwise
+    void classify(char* outStatus) const;
+    void classify(char* outStatus, Path path) const;
+
+    // Empty-cell (legal move) mask of every board
+    void emptyMasks(std::uint16_t* outMasks) const;
+    void emptyMasks(std::uint16_t* outMasks, Path path) const;
+
+    // Plays every unfinished board to the end with uniformly random moves.
+    // The side to move on each board follows from its piece counts (X first).
+    // Writes each board's result ('X', 'O' or 'T') to outResults if given,
+    // and the cells it played to outMoves[board * 9 + n] (0xFF after the last).
+    Totals playRandomGames(Rng& rng, char* outResults = nullptr, std::uint8_t* outMoves = nullptr);
+
+    // Fastest path this CPU supports, and whether a path can run here
+    static Path bestPath();
+    static bool supports(Path path);
+    static const char* pathName(Path path);
+
+private:
+    std::vector<std::uint16_t> xMasks;
+    std::vector<std::uint16_t> oMasks;
+    // playRandomGames() working space
+    std::vector<char> status;
+    std::vector<std::uint8_t> emptyCounts;   // at the start
+    std::vector<std::uint8_t> firstMovers;   // 0 = X, 1 = O
+};
+
+#endif // FINALPROJECT_BOARDBATCH_H
@@ -0,0 +1,40 @@
+#include "DatabaseAIPlayer.h"
+#include "Board.h"
+#include "MNKBoard.h"
+#include "PositionDatabase.h"
+#include <bit>
+
+DatabaseAIPlayer::DatabaseAIPlayer(char symbol, const PositionDatabase& database,
+                                   std::string_view name)
+    : AIPlayer(symbol, name), database(database) {}
+
+void DatabaseAIPlayer::makeMove(Board& board) {
+    lastStats.reset();
+    lastStats.tableProbes = 1;
+
+    PositionDatabase::Entry entry;
+    if (!database.lookup(board, entry) || entry.bestMoves == 0) {
+        AIPlayer::makeMove(board);
+        return;
+    }
+
+    lastStats.tableHits = 1;
+    int cell = std::countr_zero(entry.bestMoves);
+    board.applyMove(cell / 3, cell % 3, symbol);
+}
+
+void DatabaseAIPlayer::makeMove(MNKBoard& board) {
+    lastStats.reset();
+    lastStats.tableProbes = 1;
+
+    PositionDatabase::Entry entry;
+    if (!database.lookup(board, entry) || entry.bestMoves == 0) {
+        AIPlayer::makeMove(board);
+        return;
+    }
+
+    lastStats.tableHits = 1;
+    const int cols = board.getCols();
+    int cell = std::countr_zero(entry.bestMoves);
+    board.applyMove(cell / cols, cell % cols, symbol);
+}
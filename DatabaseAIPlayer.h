@@ -0,0 +1,34 @@
+#ifndef FINALPROJECT_DATABASEAIPLAYER_H
+#define FINALPROJECT_DATABASEAIPLAYER_H
+
+#include "AIPlayer.h"
+#include <string_view>
+
+class Board;
+class MNKBoard;
+class PositionDatabase;
+
+/**
+ * DatabaseAIPlayer answers every move with one lookup in a PositionDatabase
+ * built ahead of time by the `builddb` tool, so a game on a board the
+ * database covers (3x3, 4x4, ...) costs no search at request time. Like
+ * PerfectPlayer it plays the first best-scoring cell in row-major order,
+ * which is the move MiniMaxAIPlayer would choose.
+ *
+ * The database is not owned: one mapped file can serve any number of
+ * players and threads. Positions it doesn't cover (another board size, or
+ * no file open) fall back to the default AIPlayer strategy.
+ */
+class DatabaseAIPlayer final : public AIPlayer {
+public:
+    DatabaseAIPlayer(char symbol, const PositionDatabase& database,
+                     std::string_view name = "Database AI");
+
+    void makeMove(Board& board) override;
+    void makeMove(MNKBoard& board) override;
+
+private:
+    const PositionDatabase& database;
+};
+
+#endif // FINALPROJECT_DATABASEAIPLAYER_H
@@ -0,0 +1,311 @@
+#include "GameRecord.h"
+#include "Rng.h"
+#include <cstring>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr char MAGIC[8] = {'T', 'T', 'T', 'G', 'R', 'E', 'C', '\0'};
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;     // BYTE_ORDER_MARK as written
+        std::uint32_t recordSize;    // sizeof(GameRecord)
+        std::uint32_t headerSize;    // sizeof(FileHeader): records start here
+        std::uint64_t reserved;
+    };
+
+    static_assert(sizeof(FileHeader) == 32, "header layout is part of the file format");
+
+    FileHeader makeHeader() {
+        FileHeader header {};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = GameRecordWriter::VERSION;
+        header.byteOrder = BYTE_ORDER_MARK;
+        header.recordSize = sizeof(GameRecord);
+        header.headerSize = sizeof(FileHeader);
+        return header;
+    }
+
+    // nullptr if `header` starts a file this build can read
+    const char* checkHeader(const FileHeader& header) {
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            return "not a game-record file";
+        }
+        if (header.byteOrder != BYTE_ORDER_MARK) {
+            return "written on a machine with a different byte order";
+        }
+        if (header.version != GameRecordWriter::VERSION || header.recordSize != sizeof(GameRecord) ||
+            header.headerSize != sizeof(FileHeader)) {
+            return "unsupported game-record version";
+        }
+        return nullptr;
+    }
+
+#if !defined(_WIN32)
+    // write() until everything is out; false on an error
+    bool writeAll(int fd, const void* bytes, std::size_t size) {
+        const auto* p = static_cast<const unsigned char*>(bytes);
+        while (size > 0) {
+            const ssize_t written = ::write(fd, p, size);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            p += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+#endif
+}
+
+// GameRecord
+// =====================
+
+void GameRecord::addMove(int cell) {
+    const int index = moveCount();
+    if (index >= MAX_MOVES) {
+        return;
+    }
+    const int shift = (index % 2) * 4;
+    moves[index / 2] = static_cast<std::uint8_t>((moves[index / 2] & ~(0x0F << shift)) | ((cell & 0x0F) << shift));
+    info = static_cast<std::uint8_t>((info & 0xF0) | (index + 1));
+}
+
+char GameRecord::result() const {
+    switch ((info >> 4) & 0x03) {
+        case 1: return 'X';
+        case 2: return 'O';
+        case 3: return 'T';
+        default: return ' ';
+    }
+}
+
+void GameRecord::setResult(char winner) {
+    const int code = winner == 'X' ? 1 : winner == 'O' ? 2 : winner == 'T' ? 3 : 0;
+    info = static_cast<std::uint8_t>((info & 0x0F) | (code << 4));
+}
+
+std::uint64_t GameRecord::playerSeed(std::uint64_t seed, int seat) {
+    std::uint64_t x = seed + static_cast<std::uint64_t>(seat);
+    return Rng::splitMix64(x);
+}
+
+// GameRecordWriter::Buffer
+// =====================
+
+GameRecordWriter::Buffer::Buffer(GameRecordWriter& writer, std::size_t capacity)
+    : writer(writer), records(capacity > 0 ? capacity : 1) {}
+
+GameRecordWriter::Buffer::~Buffer() {
+    flush();
+}
+
+void GameRecordWriter::Buffer::flush() {
+    if (count > 0) {
+        writer.writeBlock(records.data(), count);
+        count = 0;
+    }
+}
+
+// GameRecordWriter
+// =====================
+
+GameRecordWriter::~GameRecordWriter() {
+    close();
+}
+
+bool GameRecordWriter::open(const std::string& path) {
+    close();
+    writeFailed.store(false, std::memory_order_relaxed);
+    recordCount.store(0, std::memory_order_relaxed);
+    blockCount.store(0, std::memory_order_relaxed);
+
+    FileHeader existing {};
+    bool empty = true;
+
+#if defined(_WIN32)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (in) {
+            in.seekg(0, std::ios::end);
+            const auto size = static_cast<std::size_t>(in.tellg());
+            empty = size == 0;
+            if (!empty) {
+                in.seekg(0);
+                if (size < sizeof(FileHeader) ||
+                    !in.read(reinterpret_cast<char*>(&existing), sizeof(existing))) {
+                    error = path + ": not a game-record file";
+                    return false;
+                }
+            }
+        }
+    }
+    file = std::fopen(path.c_str(), "ab");
+    if (file == nullptr) {
+        error = "cannot open " + path;
+        return false;
+    }
+#else
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        close();
+        error = "cannot open " + path;
+        return false;
+    }
+    empty = info.st_size == 0;
+    if (!empty) {
+        const int in = ::open(path.c_str(), O_RDONLY);
+        const bool read = in >= 0 && info.st_size >= static_cast<off_t>(sizeof(FileHeader)) &&
+                          ::pread(in, &existing, sizeof(existing), 0) == static_cast<ssize_t>(sizeof(existing));
+        if (in >= 0) {
+            ::close(in);
+        }
+        if (!read) {
+            close();
+            error = path + ": not a game-record file";
+            return false;
+        }
+    }
+#endif
+
+    if (!empty) {
+        // Appending to an earlier run's file: it has to be the same format
+        if (const char* problem = checkHeader(existing)) {
+            close();
+            error = path + ": " + problem;
+            return false;
+        }
+    } else {
+        const FileHeader header = makeHeader();
+#if defined(_WIN32)
+        const bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 && std::fflush(file) == 0;
+#else
+        const bool written = writeAll(fd, &header, sizeof(header));
+#endif
+        if (!written) {
+            close();
+            error = "cannot write to " + path;
+            return false;
+        }
+    }
+
+    error.clear();
+    return true;
+}
+
+void GameRecordWriter::close() {
+#if defined(_WIN32)
+    if (file != nullptr) {
+        std::fclose(file);
+        file = nullptr;
+    }
+#else
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+#endif
+}
+
+bool GameRecordWriter::isOpen() const {
+#if defined(_WIN32)
+    return file != nullptr;
+#else
+    return fd >= 0;
+#endif
+}
+
+void GameRecordWriter::writeBlock(const GameRecord* records, std::size_t count) {
+    if (count == 0 || !isOpen() || writeFailed.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const std::size_t bytes = count * sizeof(GameRecord);
+#if defined(_WIN32)
+    bool written;
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        written = std::fwrite(records, sizeof(GameRecord), count, file) == count && std::fflush(file) == 0;
+    }
+#else
+    // One write() per block: with O_APPEND the kernel moves to the end and
+    // writes as one step, so blocks from different threads never mix. The
+    // rest of a short write (only on errors such as a full disk) can't be
+    // added atomically: other threads' blocks could land in between. So the
+    // block fails instead and the writer stops, leaving the torn block at
+    // the end, where the reader drops a partial last record.
+    ssize_t n = ::write(fd, records, bytes);
+    while (n < 0 && errno == EINTR) {
+        n = ::write(fd, records, bytes);   // interrupted before anything was written
+    }
+    const bool written = n == static_cast<ssize_t>(bytes);
+#endif
+
+    if (!written) {
+        writeFailed.store(true, std::memory_order_relaxed);
+        return;
+    }
+    recordCount.fetch_add(static_cast<long long>(count), std::memory_order_relaxed);
+    blockCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// GameRecordReader
+// =====================
+
+GameRecordReader::~GameRecordReader() {
+    close();
+}
+
+bool GameRecordReader::open(const std::string& path) {
+    close();
+
+    // Games are read front to back
+    if (!file.open(path, MappedFile::Access::Sequential)) {
+        error = file.getError();
+        return false;
+    }
+    if (file.size() < sizeof(FileHeader)) {
+        close();
+        error = path + " is too short to be a game-record file";
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const FileHeader*>(file.data());
+    if (const char* problem = checkHeader(*header)) {
+        const std::string message = path + ": " + problem;
+        close();
+        error = message;
+        return false;
+    }
+
+    // The header is 32 bytes, so records stay 8-byte aligned in the mapping
+    records = reinterpret_cast<const GameRecord*>(file.data() + sizeof(FileHeader));
+    count = (file.size() - sizeof(FileHeader)) / sizeof(GameRecord);
+    error.clear();
+    return true;
+}
+
+void GameRecordReader::close() {
+    file.close();
+    records = nullptr;
+    count = 0;
+}
@@ -0,0 +1,180 @@
+#ifndef FINALPROJECT_GAMERECORD_H
+#define FINALPROJECT_GAMERECORD_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#include <cstdio>
+#include <mutex>
+#endif
+
+/**
+ * GameRecord is one finished 3x3 game in 16 bytes: who played, the seed
+ * their random choices came from, the result, and the moves, one cell
+ * (0-8, row * 3 + col) per 4 bits in the order they were played.
+ *
+ * Game-record files are a 32-byte header followed by records back to back
+ * (native byte order, like PositionDatabase), so a file is an array of
+ * GameRecord that GameRecordReader maps and hands out in place.
+ *
+ *   GameRecordWriter          owns the file (opened for appending)
+ *   GameRecordWriter::Buffer  one per thread: collects records and writes
+ *                             them to the file a block at a time
+ *   GameRecordReader          maps a file read-only and iterates its games
+ *
+ * Every block goes to the file in a single write() on a descriptor opened
+ * with O_APPEND, which the kernel places at the current end of the file
+ * atomically. Threads therefore share a writer without any lock, and blocks
+ * never interleave; only the order of whole blocks depends on timing. A
+ * block that can't be written whole (disk full) stops the writer, so no
+ * later block lands behind the torn one.
+ */
+struct GameRecord {
+    // Player types as stored in the file (4 bits each)
+    enum class PlayerKind : std::uint8_t {
+        Unknown    = 0,
+        Human      = 1,
+        Regular    = 2,
+        Unbeatable = 3,
+        MiniMax    = 4,
+        Perfect    = 5,
+        MCTS       = 6,
+        Random     = 7,
+        Database   = 8
+    };
+
+    static constexpr int MAX_MOVES = 9;
+
+    // Seed the players were created from: X's got playerSeed(seed, 0), O's
+    // playerSeed(seed, 1). Tournament reuses a chunk's players for all of its
+    // games (Random vs Random chunks share one Rng seeded with playerSeed(seed, 0)),
+    // so those records share one seed; the moves are the game itself.
+    std::uint64_t seed = 0;
+    std::uint8_t players = 0;      // X kind in the low nibble, O kind in the high one
+    std::uint8_t info = 0;         // move count in the low nibble, result in bits 4-5
+    std::uint8_t moves[5] = {};    // move i in nibble i (low nibble first)
+    std::uint8_t reserved = 0;
+
+    PlayerKind xPlayer() const {return static_cast<PlayerKind>(players & 0x0F);}
+    PlayerKind oPlayer() const {return static_cast<PlayerKind>(players >> 4);}
+    void setPlayers(PlayerKind x, PlayerKind o) {
+        players = static_cast<std::uint8_t>(static_cast<unsigned>(x) | (static_cast<unsigned>(o) << 4));
+    }
+
+    int moveCount() const {return info & 0x0F;}
+    int move(int index) const {return (moves[index / 2] >> ((index % 2) * 4)) & 0x0F;}
+    void addMove(int cell);        // ignored once MAX_MOVES are stored
+
+    // 'X' or 'O' for a win, 'T' for a tie, ' ' if no result was set
+    char result() const;
+    void setResult(char winner);
+
+    // Seed for one side's player, derived from the record's seed
+    static std::uint64_t playerSeed(std::uint64_t seed, int seat);
+};
+
+static_assert(sizeof(GameRecord) == 16, "records are read in place from files");
+
+class GameRecordWriter {
+public:
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::size_t BLOCK_RECORDS = 4096;   // 64 KB per write
+
+    class Buffer {
+    public:
+        explicit Buffer(GameRecordWriter& writer, std::size_t capacity = BLOCK_RECORDS);
+        ~Buffer();   // flushes
+
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        void append(const GameRecord& record) {
+            records[count++] = record;
+            if (count == records.size()) {
+                flush();
+            }
+        }
+        void flush();
+
+    private:
+        GameRecordWriter& writer;
+        std::vector<GameRecord> records;
+        std::size_t count = 0;
+    };
+
+    GameRecordWriter() = default;
+    ~GameRecordWriter();
+
+    GameRecordWriter(const GameRecordWriter&) = delete;
+    GameRecordWriter& operator=(const GameRecordWriter&) = delete;
+
+    // Opens `path` for appending, writing the header if the file is new or
+    // empty. Returns false and sets getError() if it can't be opened or is
+    // not a compatible game-record file. Any earlier file is closed.
+    bool open(const std::string& path);
+    void close();   // buffers must be flushed (or destroyed) first
+
+    bool isOpen() const;
+    const std::string& getError() const {return error;}
+
+    // False once a block could not be written completely (e.g. disk full).
+    // Nothing more is written after that; the file ends in the torn block,
+    // or in blocks other threads had already started writing.
+    bool ok() const {return !writeFailed.load(std::memory_order_relaxed);}
+
+    long long recordsWritten() const {return recordCount.load(std::memory_order_relaxed);}
+    long long blocksWritten() const {return blockCount.load(std::memory_order_relaxed);}
+
+    // Appends `count` records as one block. Safe to call from many threads;
+    // does nothing once ok() is false.
+    void writeBlock(const GameRecord* records, std::size_t count);
+
+private:
+#if defined(_WIN32)
+    std::FILE* file = nullptr;
+    std::mutex fileMutex;   // no atomic append here: blocks are serialized
+#else
+    int fd = -1;
+#endif
+    std::string error;
+    std::atomic<bool> writeFailed{false};
+    std::atomic<long long> recordCount{0};
+    std::atomic<long long> blockCount{0};
+};
+
+class GameRecordReader {
+public:
+    GameRecordReader() = default;
+    ~GameRecordReader();
+
+    GameRecordReader(const GameRecordReader&) = delete;
+    GameRecordReader& operator=(const GameRecordReader&) = delete;
+
+    // Maps a game-record file; returns false and sets getError() if it is
+    // missing or not a compatible file. A partial record at the end (from a
+    // write cut short) is ignored. Any earlier file is closed.
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const {return file.isOpen();}
+    const std::string& getError() const {return error;}
+
+    std::size_t size() const {return count;}
+    const GameRecord& operator[](std::size_t index) const {return records[index];}
+    const GameRecord* begin() const {return records;}
+    const GameRecord* end() const {return records + count;}
+
+private:
+    MappedFile file;
+    const GameRecord* records = nullptr;
+    std::size_t count = 0;
+    std::string error;
+};
+
+#endif // FINALPROJECT_GAMERECORD_H
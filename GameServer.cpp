@@ -0,0 +1,587 @@
+#include "GameServer.h"
+#include "Player.h"
+#include "Rng.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+struct GameServer::Session {
+    int fd = -1;
+    std::uint32_t generation = 0;     // bumped on reuse, so stale epoll events are ignored
+    Board board;
+    Tournament::PlayerType ai = Tournament::PlayerType::Perfect;
+    char aiSymbol = 'O';
+    bool inGame = false;
+    bool aiThinking = false;          // a worker is reading `board`
+    bool closed = false;              // connection gone; slot freed when the AI returns
+    bool wantWrite = false;           // EPOLLOUT registered instead of EPOLLIN
+    bool discarding = false;          // rest of an over-long line is being skipped
+    std::uint8_t inputLength = 0;
+    std::uint16_t outputLength = 0;
+    char input[MAX_LINE];
+    char output[MAX_OUTPUT];          // replies the socket hasn't taken yet
+};
+
+namespace {
+    constexpr std::uint64_t LISTEN_TAG = ~0ULL;
+    constexpr std::uint64_t WAKE_TAG = ~0ULL - 1;
+    constexpr int MAX_EVENTS = 256;
+    constexpr char SERVER_FULL[] = "ERR server full\n";
+
+    std::uint64_t tagFor(std::uint32_t slot, std::uint32_t generation) {
+        return (static_cast<std::uint64_t>(generation) << 32) | slot;
+    }
+
+    // Players are created once per worker thread and kept for every game after
+    Player& workerPlayer(Tournament::PlayerType type, char symbol) {
+        thread_local std::array<std::unique_ptr<Player>, Tournament::PLAYER_TYPE_COUNT * 2> players;
+        thread_local Rng seeds;
+
+        auto& player = players[static_cast<std::size_t>(type) * 2 + (symbol == 'X' ? 0 : 1)];
+        if (!player) {
+            player = Tournament::createPlayer(type, symbol, seeds.next());
+        }
+        return *player;
+    }
+
+    bool parseType(std::string_view name, Tournament::PlayerType& outType) {
+        for (int t = 0; t < Tournament::PLAYER_TYPE_COUNT; ++t) {
+            const auto type = static_cast<Tournament::PlayerType>(t);
+            const std::string_view candidate = Tournament::typeName(type);
+            if (candidate.size() == name.size() &&
+                std::equal(name.begin(), name.end(), candidate.begin(), [](char a, char b) {
+                    return std::tolower(static_cast<unsigned char>(a)) ==
+                           std::tolower(static_cast<unsigned char>(b));
+                })) {
+                outType = type;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Splits off the next space-separated word of `line`
+    std::string_view nextWord(std::string_view& line) {
+        const std::size_t start = line.find_first_not_of(' ');
+        if (start == std::string_view::npos) {
+            line = {};
+            return {};
+        }
+        line.remove_prefix(start);
+        const std::size_t end = std::min(line.find(' '), line.size());
+        std::string_view word = line.substr(0, end);
+        line.remove_prefix(end);
+        return word;
+    }
+}
+
+GameServer::GameServer(const Config& config)
+    : config(config),
+      sessions(static_cast<std::size_t>(config.maxConnections)),
+      pool(config.threads) {
+    // Lowest slots first, so a lightly loaded server touches little memory
+    freeSlots.reserve(sessions.size());
+    for (std::size_t slot = sessions.size(); slot > 0; --slot) {
+        freeSlots.push_back(static_cast<std::uint32_t>(slot - 1));
+    }
+    completions.reserve(sessions.size());
+    draining.reserve(sessions.size());
+}
+
+GameServer::~GameServer() {
+    pool.waitIdle();
+    for (auto& session : sessions) {
+        if (session.fd >= 0) ::close(session.fd);
+    }
+    if (listenFd >= 0) ::close(listenFd);
+    if (epollFd >= 0) ::close(epollFd);
+    if (wakeFd >= 0) ::close(wakeFd);
+    if (spareFd >= 0) ::close(spareFd);
+    if (!config.unixPath.empty() && listenFd >= 0) {
+        ::unlink(config.unixPath.c_str());
+    }
+}
+
+bool GameServer::start(std::string& outError) {
+    if (config.unixPath.empty()) {
+        listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int on = 1;
+        ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(static_cast<std::uint16_t>(config.port));
+        if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            outError = std::string("cannot bind 127.0.0.1:") + std::to_string(config.port) + ": " + std::strerror(errno);
+            return false;
+        }
+
+        socklen_t length = sizeof(address);
+        ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+        boundPort = ntohs(address.sin_port);
+    } else {
+        sockaddr_un address{};
+        if (config.unixPath.size() >= sizeof(address.sun_path)) {
+            outError = "socket path too long: " + config.unixPath;
+            return false;
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, config.unixPath.c_str(), config.unixPath.size() + 1);
+
+        ::unlink(config.unixPath.c_str());   // left over from an earlier run
+        listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            outError = "cannot bind " + config.unixPath + ": " + std::strerror(errno);
+            return false;
+        }
+    }
+
+    if (::listen(listenFd, SOMAXCONN) != 0) {
+        outError = std::string("listen failed: ") + std::strerror(errno);
+        return false;
+    }
+
+    spareFd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        outError = std::string("cannot create event loop: ") + std::strerror(errno);
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = LISTEN_TAG;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.u64 = WAKE_TAG;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+    return true;
+}
+
+void GameServer::run() {
+    epoll_event events[MAX_EVENTS];
+
+    while (!stopping.load()) {
+        const int count = ::epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const std::uint64_t tag = events[i].data.u64;
+            if (tag == LISTEN_TAG) {
+                acceptConnections();
+                continue;
+            }
+            if (tag == WAKE_TAG) {
+                std::uint64_t ignored = 0;
+                [[maybe_unused]] auto n = ::read(wakeFd, &ignored, sizeof(ignored));
+                drainCompletions();
+                continue;
+            }
+
+            const auto slot = static_cast<std::uint32_t>(tag);
+            Session& session = sessions[slot];
+            if (session.fd < 0 || session.generation != static_cast<std::uint32_t>(tag >> 32)) {
+                continue;   // closed earlier in this batch
+            }
+            // A hangup while replies wait fails the send and closes the session
+            if (events[i].events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) {
+                flush(slot);
+            }
+            if (session.fd >= 0 && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+                readFrom(slot);
+            }
+        }
+    }
+}
+
+void GameServer::stop() {
+    stopping.store(true);
+    const std::uint64_t one = 1;
+    [[maybe_unused]] auto n = ::write(wakeFd, &one, sizeof(one));
+}
+
+GameServer::Counters GameServer::getCounters() const {
+    Counters counters;
+    counters.connections = connectionCount.load(std::memory_order_relaxed);
+    counters.games = gameCount.load(std::memory_order_relaxed);
+    counters.aiMoves = aiMoveCount.load(std::memory_order_relaxed);
+    return counters;
+}
+
+// Connections
+// =====================
+
+void GameServer::acceptConnections() {
+    while (true) {
+        const int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if ((errno == EMFILE || errno == ENFILE) && refuseConnection()) {
+                continue;
+            }
+            return;   // EAGAIN: nothing more waiting (or a transient error)
+        }
+
+        if (freeSlots.empty()) {
+            [[maybe_unused]] auto n = ::send(fd, SERVER_FULL, sizeof(SERVER_FULL) - 1, MSG_NOSIGNAL);
+            ::close(fd);
+            continue;
+        }
+
+        if (config.unixPath.empty()) {
+            int on = 1;   // replies are tiny: don't let Nagle hold them back
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+
+        const std::uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+
+        Session& session = sessions[slot];
+        const std::uint32_t generation = session.generation;
+        session = Session();
+        session.fd = fd;
+        session.generation = generation;
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = tagFor(slot, generation);
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        connectionCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool GameServer::refuseConnection() {
+    // Out of descriptors, the waiting connection stays queued and the listen
+    // socket stays ready, so the loop would spin. Free the spare descriptor
+    // to take the connection and turn it away.
+    if (spareFd >= 0) {
+        ::close(spareFd);
+        const int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        const bool drained = fd < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        if (fd >= 0) {
+            [[maybe_unused]] auto n = ::send(fd, SERVER_FULL, sizeof(SERVER_FULL) - 1, MSG_NOSIGNAL);
+            ::close(fd);
+        }
+        spareFd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+        if (fd >= 0 || drained) {
+            return fd >= 0;
+        }
+    }
+
+    // No spare, or another thread took the freed descriptor first: stop
+    // watching the listen socket until a session closes and frees one
+    epoll_event event{};
+    event.data.u64 = LISTEN_TAG;
+    ::epoll_ctl(epollFd, EPOLL_CTL_MOD, listenFd, &event);
+    acceptPaused = true;
+    return false;
+}
+
+void GameServer::resumeAccepting() {
+    if (spareFd < 0) {
+        spareFd = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    }
+    if (acceptPaused) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = LISTEN_TAG;
+        ::epoll_ctl(epollFd, EPOLL_CTL_MOD, listenFd, &event);
+        acceptPaused = false;
+    }
+}
+
+void GameServer::readFrom(std::uint32_t slot) {
+    char buffer[4096];
+
+    // Nothing more is read while replies are waiting: flush() asks for
+    // EPOLLIN again once the client has taken them
+    while (sessions[slot].fd >= 0 && sessions[slot].outputLength == 0) {
+        Session& session = sessions[slot];
+        const ssize_t n = ::read(session.fd, buffer, sizeof(buffer));
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+            closeSession(slot);
+            return;
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;   // EAGAIN: all read
+        }
+
+        for (ssize_t i = 0; i < n && sessions[slot].fd >= 0; ++i) {
+            Session& s = sessions[slot];
+            const char c = buffer[i];
+            if (c == '\n') {
+                if (s.discarding) {
+                    s.discarding = false;
+                    send(slot, "ERR line too long\n");
+                } else {
+                    std::string_view line(s.input, s.inputLength);
+                    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+                    s.inputLength = 0;
+                    handleLine(slot, line);
+                }
+            } else if (s.discarding) {
+                continue;
+            } else if (s.inputLength == MAX_LINE) {
+                s.discarding = true;
+                s.inputLength = 0;
+            } else {
+                s.input[s.inputLength++] = c;
+            }
+        }
+    }
+}
+
+void GameServer::closeSession(std::uint32_t slot) {
+    Session& session = sessions[slot];
+    if (session.fd < 0) {
+        return;   // already closed (e.g. by a failed send): the slot is released
+    }
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, session.fd, nullptr);
+    ::close(session.fd);
+    session.fd = -1;
+    session.outputLength = 0;
+    resumeAccepting();   // a descriptor is free again
+
+    if (session.aiThinking) {
+        session.closed = true;   // the worker still reads the board
+    } else {
+        releaseSlot(slot);
+    }
+}
+
+void GameServer::releaseSlot(std::uint32_t slot) {
+    Session& session = sessions[slot];
+    ++session.generation;
+    session.closed = false;
+    freeSlots.push_back(slot);
+}
+
+// Protocol
+// =====================
+
+void GameServer::handleLine(std::uint32_t slot, std::string_view line) {
+    Session& session = sessions[slot];
+    const std::string_view command = nextWord(line);
+
+    if (command == "NEW") {
+        if (session.aiThinking) {
+            send(slot, "ERR wait for the AI's move\n");
+            return;
+        }
+        Tournament::PlayerType type;
+        if (!parseType(nextWord(line), type)) {
+            send(slot, "ERR unknown AI (regular, unbeatable, minimax, perfect, random)\n");
+            return;
+        }
+        const std::string_view side = nextWord(line);
+        if (!side.empty() && side != "X" && side != "O") {
+            send(slot, "ERR side must be X or O\n");
+            return;
+        }
+
+        session.board = Board();
+        session.ai = type;
+        session.aiSymbol = (side == "O") ? 'X' : 'O';
+        session.inGame = true;
+        gameCount.fetch_add(1, std::memory_order_relaxed);
+        send(slot, "OK\n");
+
+        // A failed send closes the session; don't start a move for it
+        if (sessions[slot].fd >= 0 && session.aiSymbol == 'X') {
+            startAiMove(slot);
+        }
+    } else if (command == "MOVE") {
+        const std::string_view rowText = nextWord(line);
+        const std::string_view colText = nextWord(line);
+        if (!session.inGame) {
+            send(slot, "ERR no game in progress\n");
+            return;
+        }
+        if (session.aiThinking) {
+            send(slot, "ERR not your turn\n");
+            return;
+        }
+
+        const int row = (rowText.size() == 1) ? rowText[0] - '0' : -1;
+        const int col = (colText.size() == 1) ? colText[0] - '0' : -1;
+        if (!session.board.isValidMove(row, col)) {
+            send(slot, "ERR illegal move\n");
+            return;
+        }
+
+        const char humanSymbol = (session.aiSymbol == 'X') ? 'O' : 'X';
+        session.board.applyMove(row, col, humanSymbol);
+        finishIfOver(slot);
+        if (sessions[slot].fd < 0) {
+            return;
+        }
+        if (sessions[slot].inGame) {
+            startAiMove(slot);
+        } else {
+            flush(slot);
+        }
+    } else if (command == "BOARD") {
+        char reply[] = "BOARD .........\n";
+        for (int cell = 0; cell < 9; ++cell) {
+            const char value = session.board.getCellValue(cell / 3, cell % 3);
+            reply[6 + cell] = (value == ' ') ? '.' : value;
+        }
+        send(slot, reply);
+    } else if (command == "QUIT") {
+        flush(slot);
+        if (sessions[slot].fd >= 0) {
+            closeSession(slot);
+        }
+    } else {
+        send(slot, "ERR unknown command\n");
+    }
+}
+
+void GameServer::finishIfOver(std::uint32_t slot) {
+    Session& session = sessions[slot];
+    const char* result = nullptr;
+    if (session.board.winCheck('X')) result = "END X\n";
+    else if (session.board.winCheck('O')) result = "END O\n";
+    else if (session.board.tieCheck()) result = "END T\n";
+
+    if (result != nullptr) {
+        session.inGame = false;
+        queue(slot, result);
+    }
+}
+
+// AI moves
+// =====================
+
+void GameServer::startAiMove(std::uint32_t slot) {
+    sessions[slot].aiThinking = true;
+    // Just `this` and the slot: small enough for std::function to store
+    // without allocating
+    pool.submit([this, slot] {runAiMove(slot);});
+}
+
+void GameServer::runAiMove(std::uint32_t slot) {
+    // The loop leaves the session's board alone while aiThinking is set
+    const Session& session = sessions[slot];
+    Board after = session.board;
+    workerPlayer(session.ai, session.aiSymbol).makeMove(after);
+    const unsigned played = after.getOccupiedMask() ^ session.board.getOccupiedMask();
+
+    {
+        std::lock_guard<std::mutex> lock(completionMutex);
+        completions.push_back(Completion{slot, played ? std::countr_zero(played) : -1});
+    }
+    const std::uint64_t one = 1;
+    [[maybe_unused]] auto n = ::write(wakeFd, &one, sizeof(one));
+}
+
+void GameServer::drainCompletions() {
+    {
+        std::lock_guard<std::mutex> lock(completionMutex);
+        draining.swap(completions);
+    }
+
+    for (const Completion& done : draining) {
+        Session& session = sessions[done.slot];
+        session.aiThinking = false;
+        aiMoveCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (session.closed) {
+            releaseSlot(done.slot);
+            continue;
+        }
+        if (done.cell < 0) {
+            continue;   // can't happen on a live game
+        }
+
+        const int row = done.cell / 3;
+        const int col = done.cell % 3;
+        session.board.applyMove(row, col, session.aiSymbol);
+
+        char reply[] = "MOVE r c\n";
+        reply[5] = static_cast<char>('0' + row);
+        reply[7] = static_cast<char>('0' + col);
+        queue(done.slot, reply);
+        finishIfOver(done.slot);
+        flush(done.slot);
+    }
+    draining.clear();
+}
+
+// Output
+// =====================
+
+void GameServer::queue(std::uint32_t slot, std::string_view text) {
+    Session& session = sessions[slot];
+    if (session.fd < 0) {
+        return;
+    }
+    if (session.outputLength + text.size() > MAX_OUTPUT) {
+        closeSession(slot);   // the client isn't reading its replies
+        return;
+    }
+    std::memcpy(session.output + session.outputLength, text.data(), text.size());
+    session.outputLength = static_cast<std::uint16_t>(session.outputLength + text.size());
+}
+
+void GameServer::send(std::uint32_t slot, std::string_view text) {
+    queue(slot, text);
+    flush(slot);
+}
+
+void GameServer::flush(std::uint32_t slot) {
+    Session& session = sessions[slot];
+    if (session.fd < 0) {
+        return;
+    }
+
+    std::size_t written = 0;
+    while (written < session.outputLength) {
+        const ssize_t n = ::send(session.fd, session.output + written,
+                                 session.outputLength - written, MSG_NOSIGNAL);
+        if (n > 0) {
+            written += static_cast<std::size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            closeSession(slot);
+            return;
+        }
+    }
+    session.outputLength = static_cast<std::uint16_t>(session.outputLength - written);
+    std::memmove(session.output, session.output + written, session.outputLength);
+
+    // Wait for EPOLLOUT instead of EPOLLIN while something is waiting to be
+    // written, so a client that doesn't read can't make us queue more
+    const bool pending = session.outputLength > 0;
+    if (pending != session.wantWrite) {
+        session.wantWrite = pending;
+        epoll_event event{};
+        event.events = pending ? EPOLLOUT : EPOLLIN;
+        event.data.u64 = tagFor(slot, session.generation);
+        ::epoll_ctl(epollFd, EPOLL_CTL_MOD, session.fd, &event);
+    }
+}
@@ -0,0 +1,130 @@
+#ifndef FINALPROJECT_GAMESERVER_H
+#define FINALPROJECT_GAMESERVER_H
+
+#include "Board.h"
+#include "ThreadPool.h"
+#include "Tournament.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * GameServer hosts many TicTacToe games at once, one per connection, over a
+ * line-based protocol on a localhost TCP port or a Unix socket (Linux only:
+ * it uses epoll).
+ *
+ * A single thread runs the event loop and does all socket I/O and parsing;
+ * AI moves are run on a ThreadPool and handed back through an eventfd. Every
+ * connection lives in a slot of a session table allocated up front, with
+ * fixed buffers for its input line and unsent replies, and the AI players are
+ * created once per worker thread and reused, so a game allocates nothing.
+ *
+ * While replies are waiting to be sent the server stops reading that
+ * connection; a client that still lets more than MAX_OUTPUT bytes of replies
+ * pile up (it pipelines commands and never reads) is disconnected.
+ *
+ * Protocol (one command per line; every reply is one line):
+ *   NEW <ai> [X|O]     start a game against regular, unbeatable, minimax,
+ *                      perfect or random; you play X (first) unless O is given
+ *                      -> OK, followed by the AI's MOVE when it goes first
+ *   MOVE <row> <col>   play a move (rows and columns 0-2)
+ *                      -> MOVE <row> <col> with the AI's answer, and
+ *                         END <X|O|T> once the game is over
+ *   BOARD              -> BOARD <9 cells, row-major, '.' for empty>
+ *   QUIT               close the connection
+ * Anything else is answered with ERR <reason>.
+ */
+class GameServer {
+public:
+    struct Config {
+        int port = 0;                   // TCP port on 127.0.0.1; 0 picks a free one
+        std::string unixPath;           // if set, listen on this Unix socket instead
+        std::size_t threads = 0;        // AI workers; 0 = one per hardware thread
+        int maxConnections = 16384;     // session slots, allocated up front
+    };
+
+    struct Counters {
+        long long connections = 0;      // accepted so far
+        long long games = 0;            // started so far
+        long long aiMoves = 0;
+    };
+
+    explicit GameServer(const Config& config);
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    // Binds and listens. Returns false with a message in outError on failure.
+    bool start(std::string& outError);
+
+    // TCP port actually bound (useful with port 0), or 0 for a Unix socket
+    int getPort() const {return boundPort;}
+
+    // Runs the event loop until stop() is called
+    void run();
+
+    // Safe to call from any thread (or a signal handler)
+    void stop();
+
+    Counters getCounters() const;
+
+private:
+    struct Session;
+
+    // An AI move finished on a worker
+    struct Completion {
+        std::uint32_t slot;
+        int cell;
+    };
+
+    static constexpr std::size_t MAX_LINE = 64;
+    static constexpr std::size_t MAX_OUTPUT = 256;   // unsent reply bytes per connection
+
+    Config config;
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;                    // eventfd: completions ready, or stop()
+    int spareFd = -1;                   // kept open to turn clients away when out of descriptors
+    bool acceptPaused = false;          // listen socket out of epoll until a session closes
+    int boundPort = 0;
+    std::atomic<bool> stopping{false};
+
+    std::vector<Session> sessions;
+    std::vector<std::uint32_t> freeSlots;
+
+    std::mutex completionMutex;
+    std::vector<Completion> completions;
+    std::vector<Completion> draining;   // swapped with `completions` by the loop
+
+    std::atomic<long long> connectionCount{0};
+    std::atomic<long long> gameCount{0};
+    std::atomic<long long> aiMoveCount{0};
+
+    // Last member: destroyed first, so no job outlives the state it uses
+    ThreadPool pool;
+
+    void acceptConnections();
+    bool refuseConnection();                      // true if accept4 is worth trying again
+    void resumeAccepting();
+    void readFrom(std::uint32_t slot);
+    void handleLine(std::uint32_t slot, std::string_view line);
+    void startAiMove(std::uint32_t slot);
+    void runAiMove(std::uint32_t slot);           // on a worker thread
+    void drainCompletions();
+    void finishIfOver(std::uint32_t slot);
+
+    // queue() adds a reply (closing the connection if its backlog would pass
+    // MAX_OUTPUT); send() queues and flushes
+    void queue(std::uint32_t slot, std::string_view text);
+    void send(std::uint32_t slot, std::string_view text);
+    void flush(std::uint32_t slot);
+    void closeSession(std::uint32_t slot);
+    void releaseSlot(std::uint32_t slot);
+};
+
+#endif // FINALPROJECT_GAMESERVER_H
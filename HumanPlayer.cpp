@@ -8,7 +8,7 @@
 #include <cctype>   // NEW: for std::tolower
 #include <string>   // NEW: for std::string
 
-HumanPlayer::HumanPlayer(char symbol, const std::string& name) : Player(symbol, name) {}
+HumanPlayer::HumanPlayer(char symbol, std::string_view name) : Player(symbol, name) {}
 
 void HumanPlayer::makeMove(Board& board) {
     int choice = 0;
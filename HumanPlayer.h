@@ -10,7 +10,7 @@
 
 class HumanPlayer : public Player {
 public:
-    HumanPlayer(char symbol, const std::string& name);
+    HumanPlayer(char symbol, std::string_view name);
     void makeMove(Board& board) override;
 };
 
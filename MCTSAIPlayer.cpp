@@ -0,0 +1,484 @@
+#include "MCTSAIPlayer.h"
+#include "Board.h"
+#include "MNKBoard.h"
+#include "MetaBoard.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace {
+    // The few board operations the search needs, for both board types
+    int cellCount(const Board&) {return 9;}
+    int cellCount(const MNKBoard& board) {return board.getRows() * board.getCols();}
+    int cellCount(const MetaBoard&) {return MetaBoard::CELLS;}
+
+    int columns(const Board&) {return 3;}
+    int columns(const MNKBoard& board) {return board.getCols();}
+    int columns(const MetaBoard&) {return MetaBoard::SIZE;}
+
+    char cellAt(const Board& board, int cell) {return board.getCellValue(cell / 3, cell % 3);}
+    char cellAt(const MNKBoard& board, int cell) {
+        return board.getCellValue(cell / board.getCols(), cell % board.getCols());
+    }
+
+    void play(Board& board, int cell, char symbol) {board.makeMove(cell / 3, cell % 3, symbol);}
+    void play(MNKBoard& board, int cell, char symbol) {
+        board.applyMove(cell / board.getCols(), cell % board.getCols(), symbol);
+    }
+
+    char cellAt(const MetaBoard& board, int cell) {return board.getCellValue(cell / 9, cell % 9);}
+    void play(MetaBoard& board, int cell, char symbol) {board.makeMove(cell / 9, cell % 9, symbol);}
+
+    // Any empty cell is a legal move, except in Ultimate TicTacToe
+    template <typename BoardT>
+    bool isLegal(const BoardT& board, int cell) {return cellAt(board, cell) == ' ';}
+    bool isLegal(const MetaBoard& board, int cell) {return board.isValidMove(cell / 9, cell % 9);}
+
+    // 'X' or 'O' once a side has won, 'T' for a full board, ' ' while the game goes on
+    template <typename BoardT>
+    char outcome(const BoardT& board) {
+        if (board.winCheck('X')) return 'X';
+        if (board.winCheck('O')) return 'O';
+        if (board.tieCheck()) return 'T';
+        return ' ';
+    }
+
+    char other(char symbol) {return (symbol == 'X') ? 'O' : 'X';}
+}
+
+MCTSAIPlayer::MCTSAIPlayer(char symbol, std::string_view name)
+    : MCTSAIPlayer(symbol, Options(), name) {}
+
+MCTSAIPlayer::MCTSAIPlayer(char symbol, const Options& options, std::string_view name)
+    : AIPlayer(symbol, name), options(options) {}
+
+void MCTSAIPlayer::makeMove(Board& board) {
+    if (tryBookMove(board)) {return;}
+    search(board);
+}
+
+void MCTSAIPlayer::makeMove(MNKBoard& board) {
+    if (tryBookMove(board)) {return;}
+    search(board);
+}
+
+void MCTSAIPlayer::makeMove(MetaBoard& board) {
+    search(board);
+}
+
+// Search driver
+// =====================
+
+template <typename BoardT>
+struct MCTSAIPlayer::RootParallel {
+    // Everything a helper needs is copied in here, so a job that only starts
+    // after makeMove() has returned still touches valid memory
+    BoardT board;
+    char toMove;
+    Budget budget;
+    std::vector<std::uint64_t> seeds;   // one per helper tree
+
+    std::atomic<int> nextTree{0};
+    std::mutex mutex;
+    std::condition_variable allDone;
+    int finished = 0;
+
+    std::vector<long long> rootVisits;  // per cell, summed over the helper trees
+    long long playouts = 0;
+    long long nodes = 0;
+    int maxDepth = 0;
+
+    RootParallel(const BoardT& board, char toMove, const Budget& budget, int cells)
+        : board(board), toMove(toMove), budget(budget), rootVisits(cells, 0) {}
+
+    // Grows helper trees until none are left unclaimed
+    static void run(const std::shared_ptr<RootParallel>& split) {
+        const int count = static_cast<int>(split->seeds.size());
+        while (true) {
+            int index = split->nextTree.load();
+            do {
+                if (index >= count) return;
+            } while (!split->nextTree.compare_exchange_weak(index, index + 1));
+
+            std::vector<Node> nodes;
+            Scratch scratch;
+            Rng rng(split->seeds[index]);
+            int depth = 0;
+            long long done = grow(nodes, split->board, split->toMove, split->budget, rng, scratch, depth);
+
+            std::lock_guard<std::mutex> lock(split->mutex);
+            const Node& root = nodes[0];
+            for (int i = 0; i < root.childCount; ++i) {
+                const Node& child = nodes[root.firstChild + i];
+                split->rootVisits[child.move] += child.visits;
+            }
+            split->playouts += done;
+            split->nodes += static_cast<long long>(nodes.size());
+            split->maxDepth = std::max(split->maxDepth, depth);
+
+            if (++split->finished == count) {
+                split->allDone.notify_all();
+            }
+        }
+    }
+};
+
+template <typename BoardT>
+void MCTSAIPlayer::search(BoardT& board) {
+    const auto start = std::chrono::steady_clock::now();
+    lastStats.reset();
+
+    const int cells = cellCount(board);
+    const int cols = columns(board);
+
+    if (outcome(board) != ' ') {
+        return;   // nothing to play
+    }
+
+    reuseOrResetTree(board);
+
+    const int helpers = (options.pool != nullptr) ? static_cast<int>(options.pool->size()) : 0;
+    const int trees = helpers + 1;
+
+    Budget budget;
+    budget.timed = options.timeBudget.count() > 0;
+    budget.deadline = start + options.timeBudget;
+    budget.playouts = budget.timed ? std::numeric_limits<long long>::max()
+                                   : std::max(1LL, options.playouts / trees);
+    budget.exploration = options.exploration;
+    budget.maxTreeNodes = options.maxTreeNodes;
+    budget.leafPlayouts = std::max(1, options.leafPlayouts);
+
+    // Helpers start first so they run while this thread grows the kept tree
+    std::shared_ptr<RootParallel<BoardT>> split;
+    if (helpers > 0) {
+        split = std::make_shared<RootParallel<BoardT>>(board, symbol, budget, cells);
+        for (int i = 0; i < helpers; ++i) {
+            split->seeds.push_back(rng.next());
+        }
+        for (int i = 0; i < helpers; ++i) {
+            options.pool->submit([split] {RootParallel<BoardT>::run(split);});
+        }
+    }
+
+    // This thread's tree also gets whatever the even split left over
+    Budget own = budget;
+    if (!budget.timed) {
+        own.playouts = std::max(1LL, options.playouts - budget.playouts * helpers);
+    }
+    int maxDepth = 0;
+    long long playouts = grow(tree, board, symbol, own, rng, scratch, maxDepth);
+    long long nodes = static_cast<long long>(tree.size());
+
+    rootVisits.assign(static_cast<std::size_t>(cells), 0);
+    const Node& root = tree[0];
+    for (int i = 0; i < root.childCount; ++i) {
+        const Node& child = tree[root.firstChild + i];
+        rootVisits[child.move] += child.visits;
+    }
+
+    if (split) {
+        // Grow any helper trees no worker has picked up (e.g. we are one of them)
+        RootParallel<BoardT>::run(split);
+
+        std::unique_lock<std::mutex> lock(split->mutex);
+        split->allDone.wait(lock, [&] {return split->finished == helpers;});
+        for (int cell = 0; cell < cells; ++cell) {
+            rootVisits[cell] += split->rootVisits[cell];
+        }
+        playouts += split->playouts;
+        nodes += split->nodes;
+        maxDepth = std::max(maxDepth, split->maxDepth);
+    }
+
+    // Most visited move over all trees; ties go to the lowest cell
+    int bestCell = -1;
+    for (int cell = 0; cell < cells; ++cell) {
+        if (isLegal(board, cell) &&
+            (bestCell == -1 || rootVisits[cell] > rootVisits[bestCell])) {
+            bestCell = cell;
+        }
+    }
+
+    // Expected line: our move, then the most visited replies in our own tree
+    int bestChild = -1;
+    for (int i = 0; i < root.childCount; ++i) {
+        if (tree[root.firstChild + i].move == bestCell) {
+            bestChild = root.firstChild + i;
+        }
+    }
+    lastStats.principalVariation.emplace_back(bestCell / cols, bestCell % cols);
+    for (int node = (bestChild == -1) ? -1 : mostVisitedChild(tree, bestChild);
+         node != -1; node = mostVisitedChild(tree, node)) {
+        lastStats.principalVariation.emplace_back(tree[node].move / cols, tree[node].move % cols);
+    }
+
+    lastStats.nodes = nodes;
+    lastStats.playouts = playouts;
+    lastStats.leafEvaluations = playouts;
+    lastStats.maxDepth = maxDepth;
+
+    play(board, bestCell, symbol);
+
+    // Keep the subtree under our move for next time
+    if (options.reuseTree && bestChild != -1) {
+        keepSubtree(bestChild);
+        treePosition.assign(cells, ' ');
+        for (int cell = 0; cell < cells; ++cell) {
+            treePosition[cell] = cellAt(board, cell);
+        }
+        treeCols = cols;
+    } else {
+        tree.clear();
+    }
+
+    lastStats.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+
+template <typename BoardT>
+void MCTSAIPlayer::reuseOrResetTree(const BoardT& board) {
+    reusedNodes = 0;
+    const int cells = cellCount(board);
+
+    int reply = -1;
+    bool matches = options.reuseTree && !tree.empty() &&
+                   static_cast<int>(treePosition.size()) == cells &&
+                   treeCols == columns(board);
+
+    // The board must be the kept position plus exactly one opponent piece
+    for (int cell = 0; matches && cell < cells; ++cell) {
+        const char now = cellAt(board, cell);
+        if (now == treePosition[cell]) continue;
+
+        if (treePosition[cell] == ' ' && now == other(symbol) && reply == -1) {
+            reply = cell;
+        } else {
+            matches = false;
+        }
+    }
+
+    int replyNode = -1;
+    if (matches && reply != -1) {
+        const Node& root = tree[0];
+        for (int i = 0; i < root.childCount; ++i) {
+            if (tree[root.firstChild + i].move == reply) {
+                replyNode = root.firstChild + i;
+            }
+        }
+    }
+
+    if (replyNode == -1) {
+        tree.clear();
+        return;
+    }
+
+    keepSubtree(replyNode);
+    reusedNodes = static_cast<int>(tree.size());
+}
+
+// Tree growth
+// =====================
+
+template <typename BoardT>
+long long MCTSAIPlayer::grow(std::vector<Node>& nodes, const BoardT& root, char toMove,
+                             const Budget& budget, Rng& rng, Scratch& scratch, int& outMaxDepth) {
+    if (nodes.empty()) {
+        nodes.emplace_back();
+    }
+
+    const int cells = cellCount(root);
+    BoardT work = root;
+    std::vector<int>& path = scratch.path;
+    std::vector<int>& empties = scratch.empties;
+    empties.reserve(static_cast<std::size_t>(cells));
+
+    long long done = 0;
+    for (long long iteration = 0; done < budget.playouts; ++iteration) {
+        if (budget.timed && (iteration & 15) == 0 && std::chrono::steady_clock::now() >= budget.deadline) {
+            break;
+        }
+
+        work = root;
+        path.clear();
+        path.push_back(0);
+        int current = 0;
+        char mover = toMove;
+        char result = ' ';
+
+        // Selection: follow UCT down to a leaf
+        while (nodes[current].childCount > 0) {
+            current = selectChild(nodes, current, budget.exploration);
+            play(work, nodes[current].move, mover);
+            mover = other(mover);
+            path.push_back(current);
+
+            result = outcome(work);
+            if (result != ' ') break;
+        }
+
+        // Expansion: a leaf seen before gets all its children, and the first is played
+        if (result == ' ' && (nodes[current].visits > 0 || current == 0) &&
+            static_cast<int>(nodes.size()) + cells <= budget.maxTreeNodes) {
+            const int first = static_cast<int>(nodes.size());
+            for (int cell = 0; cell < cells; ++cell) {
+                if (isLegal(work, cell)) {
+                    Node child;
+                    child.move = cell;
+                    nodes.push_back(child);
+                }
+            }
+            nodes[current].firstChild = first;
+            nodes[current].childCount = static_cast<int>(nodes.size()) - first;
+
+            current = first;
+            play(work, nodes[current].move, mover);
+            mover = other(mover);
+            path.push_back(current);
+            result = outcome(work);
+        }
+
+        // Simulation: one random game, or on 3x3 a batch of them in lockstep
+        int games = 1;
+        int xWins = 0;
+        int oWins = 0;
+        if constexpr (std::is_same_v<BoardT, Board>) {
+            if (result == ' ' && budget.leafPlayouts > 1) {
+                games = budget.leafPlayouts;
+                BoardBatch& batch = scratch.leafGames;
+                if (batch.size() != static_cast<std::size_t>(games)) {
+                    batch.resize(static_cast<std::size_t>(games));
+                }
+                batch.fill(work);
+                const BoardBatch::Totals totals = batch.playRandomGames(rng);
+                xWins = static_cast<int>(totals.xWins);
+                oWins = static_cast<int>(totals.oWins);
+            }
+        }
+        if (games == 1) {
+            if (result == ' ') {
+                result = playout(work, mover, rng, empties);
+            }
+            xWins = (result == 'X');
+            oWins = (result == 'O');
+        }
+        const float draws = static_cast<float>(games - xWins - oWins);
+
+        // Backpropagation: each node scores the results for the side that moved into it
+        nodes[0].visits += games;
+        for (std::size_t i = 1; i < path.size(); ++i) {
+            const char movedBy = (i % 2 == 1) ? toMove : other(toMove);
+            Node& node = nodes[path[i]];
+            node.visits += games;
+            node.score += static_cast<float>(movedBy == 'X' ? xWins : oWins) + 0.5f * draws;
+        }
+
+        outMaxDepth = std::max(outMaxDepth, static_cast<int>(path.size()) - 1);
+        done += games;
+    }
+    return done;
+}
+
+template <typename BoardT>
+char MCTSAIPlayer::playout(BoardT& board, char toMove, Rng& rng, std::vector<int>& empties) {
+    if constexpr (std::is_same_v<BoardT, MetaBoard>) {
+        // Legal moves depend on the previous move, so pick straight from the board
+        char mover = toMove;
+        for (int count = board.countMoves(); count > 0; count = board.countMoves()) {
+            play(board, board.nthMove(rng.below(count)), mover);
+            if (board.winCheck(mover)) {
+                return mover;
+            }
+            mover = other(mover);
+        }
+        return 'T';
+    }
+
+    const int cells = cellCount(board);
+    empties.clear();
+    for (int cell = 0; cell < cells; ++cell) {
+        if (cellAt(board, cell) == ' ') {
+            empties.push_back(cell);
+        }
+    }
+
+    char mover = toMove;
+    while (!empties.empty()) {
+        // Swap-remove a random empty cell
+        const int pick = rng.below(static_cast<int>(empties.size()));
+        const int cell = empties[pick];
+        empties[pick] = empties.back();
+        empties.pop_back();
+
+        play(board, cell, mover);
+        if (board.winCheck(mover)) {
+            return mover;
+        }
+        mover = other(mover);
+    }
+    return 'T';
+}
+
+int MCTSAIPlayer::selectChild(const std::vector<Node>& nodes, int parent, double exploration) {
+    const Node& node = nodes[parent];
+    const double logVisits = std::log(static_cast<double>(std::max(1, node.visits)));
+
+    int best = -1;
+    double bestValue = -1.0;
+    for (int i = 0; i < node.childCount; ++i) {
+        const int index = node.firstChild + i;
+        const Node& child = nodes[index];
+        if (child.visits == 0) {
+            return index;   // try every move once before comparing them
+        }
+
+        const double value = child.score / child.visits +
+                             exploration * std::sqrt(logVisits / child.visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = index;
+        }
+    }
+    return best;
+}
+
+int MCTSAIPlayer::mostVisitedChild(const std::vector<Node>& nodes, int parent) {
+    const Node& node = nodes[parent];
+    int best = -1;
+    for (int i = 0; i < node.childCount; ++i) {
+        const int index = node.firstChild + i;
+        if (nodes[index].visits > 0 && (best == -1 || nodes[index].visits > nodes[best].visits)) {
+            best = index;
+        }
+    }
+    return best;
+}
+
+void MCTSAIPlayer::keepSubtree(int root) {
+    extractSubtree(tree, root, spareTree);
+    tree.swap(spareTree);   // both keep their capacity for the next move
+}
+
+void MCTSAIPlayer::extractSubtree(const std::vector<Node>& nodes, int root, std::vector<Node>& out) {
+    out.clear();
+    out.push_back(nodes[root]);
+    out[0].move = -1;
+
+    // Copy level by level, so each node's children stay next to each other
+    for (std::size_t next = 0; next < out.size(); ++next) {
+        const int oldFirst = out[next].firstChild;
+        const int count = out[next].childCount;
+        if (count == 0) continue;
+
+        out[next].firstChild = static_cast<int>(out.size());
+        for (int i = 0; i < count; ++i) {
+            out.push_back(nodes[oldFirst + i]);
+        }
+    }
+}
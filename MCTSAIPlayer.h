@@ -0,0 +1,134 @@
+#ifndef FINALPROJECT_MCTSAIPLAYER_H
+#define FINALPROJECT_MCTSAIPLAYER_H
+
+#include "AIPlayer.h"
+#include "BoardBatch.h"
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+class Board;
+class MNKBoard;
+class MetaBoard;
+class ThreadPool;
+
+/**
+ * MCTSAIPlayer picks moves by Monte Carlo Tree Search: it grows a game tree
+ * one random playout at a time, steering new playouts towards promising
+ * moves with UCT (wins / visits + c * sqrt(ln parent visits / visits)), and
+ * plays the most visited move.
+ *
+ * Unlike MiniMaxAIPlayer it never needs to reach the end of the tree, so it
+ * scales to m,n,k boards and Ultimate TicTacToe (MetaBoard), far too big for
+ * an exhaustive search; the budget is a playout count or a time limit per move.
+ *
+ * The subtree under the position after the opponent's reply is kept between
+ * moves, so earlier playouts are not thrown away. Given a ThreadPool the
+ * search is root-parallel: every worker grows its own tree from the current
+ * position and the root visit counts are added up. With a playout budget the
+ * chosen move depends only on the seed, not on thread timing.
+ *
+ * Playouts per second are reported in getLastSearchStats(). With an opening
+ * book set (AIPlayer::setOpeningBook), 3x3 and m,n,k positions it knows are
+ * played from the book without a search.
+ */
+class MCTSAIPlayer final : public AIPlayer {
+public:
+    struct Options {
+        long long playouts = 20000;                // per move, shared out among the trees
+        std::chrono::milliseconds timeBudget{0};   // if set, search until it runs out instead
+        double exploration = 1.4;                  // UCT constant c
+        bool reuseTree = true;
+        int maxTreeNodes = 1000000;                // per tree; past it leaves stop expanding
+
+        // Random games played from each new leaf. On 3x3 boards more than one
+        // are run in lockstep on a BoardBatch; m,n,k boards always play one.
+        int leafPlayouts = 1;
+
+        // Optional workers for root-parallel search. Not owned; it is safe to
+        // make moves from inside one of the pool's own jobs.
+        ThreadPool* pool = nullptr;
+    };
+
+    explicit MCTSAIPlayer(char symbol, std::string_view name = "MCTS AI");
+    MCTSAIPlayer(char symbol, const Options& options, std::string_view name = "MCTS AI");
+
+    void makeMove(Board& board) override;
+    void makeMove(MNKBoard& board) override;
+
+    // Ultimate TicTacToe: same search, with the sent-to rule deciding which
+    // moves are legal
+    void makeMove(MetaBoard& board);
+
+    const Options& getOptions() const {return options;}
+
+    // Nodes carried over from the previous move's tree (0 if it was rebuilt)
+    int getReusedNodeCount() const {return reusedNodes;}
+
+private:
+    // Children of a node are stored next to each other in the tree vector
+    struct Node {
+        int firstChild = -1;
+        int childCount = 0;
+        int move = -1;       // cell played to reach this node
+        int visits = 0;
+        float score = 0.0f;  // wins (+0.5 per draw) for the player who played `move`
+    };
+
+    struct Budget {
+        long long playouts = 0;
+        bool timed = false;
+        std::chrono::steady_clock::time_point deadline;
+        double exploration = 1.4;
+        int maxTreeNodes = 0;
+        int leafPlayouts = 1;
+    };
+
+    // Working buffers for grow(), kept so a search allocates nothing once warm
+    struct Scratch {
+        std::vector<int> path;
+        std::vector<int> empties;
+        BoardBatch leafGames;
+    };
+
+    // State shared by the calling thread and the helper jobs of one makeMove()
+    template <typename BoardT> struct RootParallel;
+
+    Options options;
+
+    std::vector<Node> tree;            // tree[0] is the root; kept between moves
+    std::vector<Node> spareTree;       // extractSubtree() target, swapped with `tree`
+    std::vector<char> treePosition;    // cells at the root of `tree`
+    int treeCols = 0;
+    int reusedNodes = 0;
+    Scratch scratch;
+    std::vector<long long> rootVisits; // per cell, summed over all trees
+
+    template <typename BoardT>
+    void search(BoardT& board);
+
+    // Reuses `tree` if `board` is its root position plus one opponent move
+    template <typename BoardT>
+    void reuseOrResetTree(const BoardT& board);
+
+    // Runs playouts on `nodes` from `root` until the budget is spent; returns
+    // how many ran. `nodes` may be empty (a fresh tree) or hold a kept tree.
+    template <typename BoardT>
+    static long long grow(std::vector<Node>& nodes, const BoardT& root, char toMove,
+                          const Budget& budget, Rng& rng, Scratch& scratch, int& outMaxDepth);
+
+    // Plays random moves on `board` until the game ends; returns 'X', 'O' or 'T'
+    template <typename BoardT>
+    static char playout(BoardT& board, char toMove, Rng& rng, std::vector<int>& empties);
+
+    static int selectChild(const std::vector<Node>& nodes, int parent, double exploration);
+    static int mostVisitedChild(const std::vector<Node>& nodes, int parent);
+
+    // Copies the subtree under `root` into `out` as a tree of its own
+    static void extractSubtree(const std::vector<Node>& nodes, int root, std::vector<Node>& out);
+
+    // Replaces `tree` with its subtree under `root`
+    void keepSubtree(int root);
+};
+
+#endif // FINALPROJECT_MCTSAIPLAYER_H
@@ -0,0 +1,87 @@
+#include "MNKBoard.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    // Right, down, down-right, down-left; each line is walked both ways
+    constexpr int DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+}
+
+MNKBoard::MNKBoard(int rows, int cols, int k)
+    : rows(std::clamp(rows, 1, MAX_DIM)), cols(std::clamp(cols, 1, MAX_DIM)),
+      k(std::clamp(k, 1, std::max(this->rows, this->cols))),
+      cells(static_cast<std::size_t>(this->rows * this->cols), ' '),
+      filledCells(0), winner(' '), lastRow(-1), lastCol(-1) {}
+
+void MNKBoard::display() const {
+    std::cout << "\n   ";
+    for (int c = 0; c < cols; c++) {
+        std::cout << std::setw(3) << c << " ";
+    }
+    std::cout << "\n";
+
+    for (int r = 0; r < rows; r++) {
+        std::cout << std::setw(2) << r << " ";
+        for (int c = 0; c < cols; c++) {
+            std::cout << "  " << getCellValue(r, c);
+            if (c < cols - 1) std::cout << "|";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "\n";
+}
+
+char MNKBoard::getCellValue(int row, int col) const {
+    // assume valid indices, like Board
+    return cells[row * cols + col];
+}
+
+bool MNKBoard::isValidMove(int row, int col) const {
+    if (row < 0 || row >= rows || col < 0 || col >= cols) return false;
+    else return cells[row * cols + col] == ' ';
+}
+
+void MNKBoard::applyMove(int row, int col, char symbol) {
+    // Caller should already have checked isValidMove
+    if (!isValidMove(row, col) || (symbol != 'X' && symbol != 'O')) {
+        return;
+    }
+    makeMove(row, col, symbol);
+}
+
+bool MNKBoard::winCheck(char symbol) const {
+    return winner == symbol;
+}
+
+bool MNKBoard::tieCheck() const {
+    // full board and no winner for X or O
+    return filledCells == rows * cols && winner == ' ';
+}
+
+bool MNKBoard::wouldWin(int row, int col, char symbol) const {
+    for (const auto& d : DIRECTIONS) {
+        int length = 1
+                   + runLength(row, col, d[0], d[1], symbol)
+                   + runLength(row, col, -d[0], -d[1], symbol);
+        if (length >= k) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int MNKBoard::runLength(int row, int col, int dr, int dc, char symbol) const {
+    int count = 0;
+    int r = row + dr;
+    int c = col + dc;
+
+    // No need to look further than k - 1 stones away
+    while (count < k - 1 && r >= 0 && r < rows && c >= 0 && c < cols &&
+           cells[r * cols + c] == symbol) {
+        ++count;
+        r += dr;
+        c += dc;
+    }
+    return count;
+}
@@ -0,0 +1,89 @@
+#ifndef FINALPROJECT_MNKBOARD_H
+#define FINALPROJECT_MNKBOARD_H
+
+#include <vector>
+
+/**
+ * MNKBoard is a runtime-sized board for m,n,k-games: `rows` x `cols` cells,
+ * where k in a row (horizontally, vertically or diagonally) wins.
+ * 3x3 with k = 3 is regular TicTacToe; 15x15 with k = 5 is Gomoku.
+ *
+ * Win detection is incremental: applyMove() only walks the four lines through
+ * the stone just placed and caches the winner, so winCheck() is O(1) and a
+ * move costs O(k) instead of a scan of the whole board.
+ *
+ * The cells live on the heap, so copying a board allocates: a search plays
+ * and takes back moves on one board with makeMove()/unmakeMove() instead.
+ */
+class MNKBoard {
+public:
+    static constexpr int MAX_DIM = 32;
+
+    // rows and cols are clamped to [1, MAX_DIM] and k to [1, max(rows, cols)]
+    MNKBoard(int rows = 3, int cols = 3, int k = 3);
+
+    int getRows() const {return rows;}
+    int getCols() const {return cols;}
+    int getK() const {return k;}
+
+    void display() const;
+    char getCellValue(int row, int col) const;
+
+    void applyMove(int row, int col, char symbol);   // ignored unless valid, with 'X' or 'O'
+    bool isValidMove(int row, int col) const;
+
+    // Unchecked versions for search code: makeMove() needs an empty, in-range
+    // cell and 'X' or 'O'; unmakeMove() takes back the most recent move, made
+    // while nobody had k in a row. The last move is not restored (it reads -1).
+    inline void makeMove(int row, int col, char symbol);
+    inline void unmakeMove(int row, int col);
+
+    bool winCheck(char symbol) const;   // cached: no scan
+    bool tieCheck() const;
+    int getFilledCells() const {return filledCells;}
+
+    // Would placing `symbol` at (row, col) complete k in a row?
+    // Only looks at the lines through that cell; the board is not modified.
+    bool wouldWin(int row, int col, char symbol) const;
+
+    // Most recent move, or (-1, -1) on an empty board
+    int getLastRow() const {return lastRow;}
+    int getLastCol() const {return lastCol;}
+
+private:
+    int rows;
+    int cols;
+    int k;
+    std::vector<char> cells;   // row-major, ' ' for empty
+    int filledCells;
+    char winner;               // 'X', 'O' or ' ' while nobody has k in a row
+    int lastRow;
+    int lastCol;
+
+    // Number of consecutive `symbol` stones from (row, col) stepping by (dr, dc),
+    // not counting (row, col) itself
+    int runLength(int row, int col, int dr, int dc, char symbol) const;
+};
+
+inline void MNKBoard::makeMove(int row, int col, char symbol) {
+    // Check before placing: wouldWin only inspects the neighbours
+    if (winner == ' ' && wouldWin(row, col, symbol)) {
+        winner = symbol;
+    }
+
+    cells[row * cols + col] = symbol;
+    ++filledCells;
+    lastRow = row;
+    lastCol = col;
+}
+
+inline void MNKBoard::unmakeMove(int row, int col) {
+    // Nobody had won before the move, so any winner now made it with this stone
+    cells[row * cols + col] = ' ';
+    --filledCells;
+    winner = ' ';
+    lastRow = -1;
+    lastCol = -1;
+}
+
+#endif // FINALPROJECT_MNKBOARD_H
@@ -0,0 +1,77 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path, [[maybe_unused]] Access access) {
+    close();
+
+#if defined(_WIN32)
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    fallbackCopy.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    bytes = fallbackCopy.data();
+    length = fallbackCopy.size();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        error = "cannot open " + path;
+        return false;
+    }
+
+    length = static_cast<std::size_t>(info.st_size);
+    if (length > 0) {
+        void* region = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (region == MAP_FAILED) {
+            ::close(fd);
+            length = 0;
+            error = "cannot map " + path;
+            return false;
+        }
+#if defined(MADV_RANDOM) && defined(MADV_SEQUENTIAL)
+        ::madvise(region, length, access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+#endif
+        bytes = static_cast<const unsigned char*>(region);
+        mapped = true;
+    }
+    ::close(fd);
+#endif
+
+    opened = true;
+    error.clear();
+    return true;
+}
+
+void MappedFile::close() {
+#if !defined(_WIN32)
+    if (mapped) {
+        ::munmap(const_cast<unsigned char*>(bytes), length);
+    }
+#endif
+    fallbackCopy.clear();
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+    mapped = false;
+}
@@ -0,0 +1,51 @@
+#ifndef FINALPROJECT_MAPPEDFILE_H
+#define FINALPROJECT_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * MappedFile is a whole file mapped read-only, for formats that are used in
+ * place (PositionDatabase, GameRecordReader). The mapping is shared, so
+ * processes reading the same file use one copy in the page cache. Where
+ * mmap isn't available the file is read into memory instead.
+ *
+ * Only the bytes are handled here; checking the header and size of a
+ * format is up to its reader.
+ */
+class MappedFile {
+public:
+    // How the contents will be read: passed on to the kernel as a paging hint
+    enum class Access {
+        Random,       // lookups all over the file
+        Sequential    // front to back: read ahead, drop pages behind
+    };
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps `path`; returns false and sets getError() if it can't be opened or
+    // mapped. An empty file opens with size() 0. Any earlier file is closed.
+    bool open(const std::string& path, Access access);
+    void close();
+
+    bool isOpen() const {return opened;}
+    const std::string& getError() const {return error;}
+
+    const unsigned char* data() const {return bytes;}
+    std::size_t size() const {return length;}
+
+private:
+    const unsigned char* bytes = nullptr;
+    std::size_t length = 0;
+    bool opened = false;
+    bool mapped = false;                       // bytes come from mmap (unmapped on close)
+    std::vector<unsigned char> fallbackCopy;   // used where mmap isn't available
+    std::string error;
+};
+
+#endif // FINALPROJECT_MAPPEDFILE_H
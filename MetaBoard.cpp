@@ -0,0 +1,152 @@
+#include "MetaBoard.h"
+#include <bit>
+#include <iostream>
+
+MetaBoard::MetaBoard()
+    : boards(), wonMasks{0, 0}, openMask(Board::FULL_MASK), metaWinner(0),
+      target(ANY_BOARD), filledCells(0) {}
+
+void MetaBoard::display() const {
+    std::cout << "\n    0 1 2   3 4 5   6 7 8\n";
+    for (int r = 0; r < SIZE; r++) {
+        if (r > 0 && r % 3 == 0) {
+            std::cout << "   -------+-------+-------\n";
+        }
+        std::cout << r << "  ";
+        for (int c = 0; c < SIZE; c++) {
+            if (c > 0 && c % 3 == 0) std::cout << " |";
+            const char value = getCellValue(r, c);
+            std::cout << ' ' << (value == ' ' ? '.' : value);
+        }
+        std::cout << "\n";
+    }
+    if (target != ANY_BOARD) {
+        std::cout << "Next move goes in sub-board " << static_cast<int>(target)
+                  << " (rows " << 3 * (target / 3) << "-" << 3 * (target / 3) + 2
+                  << ", columns " << 3 * (target % 3) << "-" << 3 * (target % 3) + 2 << ")\n";
+    }
+    std::cout << "\n";
+}
+
+char MetaBoard::getCellValue(int row, int col) const {
+    // assume valid indices, like Board
+    return boards[(row / 3) * 3 + col / 3].getCellValue(row % 3, col % 3);
+}
+
+bool MetaBoard::isValidMove(int row, int col) const {
+    if (row < 0 || row >= SIZE || col < 0 || col >= SIZE || metaWinner != 0) return false;
+    const int index = (row / 3) * 3 + col / 3;
+    return (allowedBoards() & (1u << index)) && boards[index].isValidMove(row % 3, col % 3);
+}
+
+void MetaBoard::applyMove(int row, int col, char symbol) {
+    // Caller should already have checked isValidMove
+    if (isValidMove(row, col) && (symbol == 'X' || symbol == 'O')) {
+        makeMove(row, col, symbol);
+    }
+}
+
+void MetaBoard::makeMove(int row, int col, char symbol) {
+    const int index = (row / 3) * 3 + col / 3;
+    const int inner = (row % 3) * 3 + col % 3;
+
+    boards[index].makeMove(row % 3, col % 3, symbol);
+    ++filledCells;
+    updateSubBoard(index);
+
+    // Sent to the sub-board at the same position, unless it is closed
+    target = static_cast<std::int8_t>((openMask & (1u << inner)) ? inner : ANY_BOARD);
+}
+
+void MetaBoard::unmakeMove(int row, int col, int previousTarget) {
+    const int index = (row / 3) * 3 + col / 3;
+
+    boards[index].unmakeMove(row % 3, col % 3);
+    --filledCells;
+    updateSubBoard(index);
+    target = static_cast<std::int8_t>(previousTarget);
+}
+
+void MetaBoard::updateSubBoard(int index) {
+    const Board& board = boards[index];
+    const std::uint16_t bit = static_cast<std::uint16_t>(1u << index);
+
+    // Only the changed sub-board is looked at, through its cached flags
+    wonMasks[0] = static_cast<std::uint16_t>(board.winCheck('X') ? (wonMasks[0] | bit) : (wonMasks[0] & ~bit));
+    wonMasks[1] = static_cast<std::uint16_t>(board.winCheck('O') ? (wonMasks[1] | bit) : (wonMasks[1] & ~bit));
+    const bool closed = board.winCheck('X') || board.winCheck('O') || board.getEmptyMask() == 0;
+    openMask = static_cast<std::uint16_t>(closed ? (openMask & ~bit) : (openMask | bit));
+
+    metaWinner = static_cast<std::uint8_t>((Board::hasLine(wonMasks[0]) ? 1 : 0) |
+                                           (Board::hasLine(wonMasks[1]) ? 2 : 0));
+}
+
+bool MetaBoard::winCheck(char symbol) const {
+    if (symbol == 'X') return (metaWinner & 0x1) != 0;
+    if (symbol == 'O') return (metaWinner & 0x2) != 0;
+    return false;
+}
+
+bool MetaBoard::tieCheck() const {
+    return openMask == 0 && metaWinner == 0;
+}
+
+char MetaBoard::getSubBoardResult(int index) const {
+    const std::uint16_t bit = static_cast<std::uint16_t>(1u << index);
+    if (wonMasks[0] & bit) return 'X';
+    if (wonMasks[1] & bit) return 'O';
+    if (!(openMask & bit)) return 'T';
+    return ' ';
+}
+
+std::uint16_t MetaBoard::getWonMask(char symbol) const {
+    if (symbol == 'X') return wonMasks[0];
+    if (symbol == 'O') return wonMasks[1];
+    return 0;
+}
+
+int MetaBoard::generateMoves(std::uint8_t* outCells) const {
+    if (metaWinner != 0) return 0;
+
+    int count = 0;
+    for (unsigned allowed = allowedBoards(); allowed != 0; allowed &= allowed - 1) {
+        const int index = std::countr_zero(allowed);
+        const int baseRow = (index / 3) * 3;
+        const int baseCol = (index % 3) * 3;
+        for (unsigned empty = boards[index].getEmptyMask(); empty != 0; empty &= empty - 1) {
+            const int inner = std::countr_zero(empty);
+            outCells[count++] = static_cast<std::uint8_t>((baseRow + inner / 3) * SIZE + baseCol + inner % 3);
+        }
+    }
+    return count;
+}
+
+int MetaBoard::countMoves() const {
+    if (metaWinner != 0) return 0;
+
+    int count = 0;
+    for (unsigned allowed = allowedBoards(); allowed != 0; allowed &= allowed - 1) {
+        count += std::popcount(static_cast<unsigned>(boards[std::countr_zero(allowed)].getEmptyMask()));
+    }
+    return count;
+}
+
+int MetaBoard::nthMove(int n) const {
+    for (unsigned allowed = allowedBoards(); allowed != 0; allowed &= allowed - 1) {
+        const int index = std::countr_zero(allowed);
+        unsigned empty = boards[index].getEmptyMask();
+        const int here = std::popcount(empty);
+        if (n >= here) {
+            n -= here;
+            continue;
+        }
+
+        // Drop the n lowest empty cells of this sub-board
+        for (; n > 0; --n) {
+            empty &= empty - 1;
+        }
+        const int inner = std::countr_zero(empty);
+        return ((index / 3) * 3 + inner / 3) * SIZE + (index % 3) * 3 + inner % 3;
+    }
+    return -1;
+}
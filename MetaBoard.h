@@ -0,0 +1,85 @@
+#ifndef FINALPROJECT_METABOARD_H
+#define FINALPROJECT_METABOARD_H
+
+#include "Board.h"
+#include <cstdint>
+
+/**
+ * MetaBoard is an Ultimate TicTacToe position: a 3x3 meta-board whose nine
+ * cells are each a 3x3 Board. Winning a sub-board claims that meta cell, and
+ * three claimed cells in a line win the game. A move's position inside its
+ * sub-board "sends" the opponent to the matching sub-board; if that one is
+ * already won or full, the opponent may play in any open sub-board.
+ *
+ * Moves use global coordinates: rows and columns 0-8, cell row * 9 + col.
+ * Sub-board b covers rows 3 * (b / 3) .. + 2 and columns 3 * (b % 3) .. + 2.
+ *
+ * Every sub-board's result is kept as bits (won by X, won by O, still open)
+ * and updated from that Board's own O(1) win/tie checks on each move, so the
+ * meta-level win check is a cached flag, not a scan of 81 cells. The whole
+ * position is under 50 bytes and cheap to copy.
+ */
+class MetaBoard {
+public:
+    static constexpr int SIZE = 9;          // rows/columns of cells
+    static constexpr int CELLS = 81;
+    static constexpr int ANY_BOARD = -1;    // getTargetBoard(): no restriction
+
+    MetaBoard();
+
+    void display() const;
+    char getCellValue(int row, int col) const;
+
+    // Legal here: in range, empty, in an open sub-board, and in the
+    // sub-board the previous move sent us to (if any)
+    bool isValidMove(int row, int col) const;
+    void applyMove(int row, int col, char symbol);   // checked, like Board
+
+    // Unchecked versions for search code. unmakeMove() needs the target board
+    // from before the move (getTargetBoard() at that time) to restore it.
+    void makeMove(int row, int col, char symbol);
+    void unmakeMove(int row, int col, int previousTarget);
+
+    bool winCheck(char symbol) const;   // three sub-boards in a line (cached)
+    bool tieCheck() const;              // no open sub-board and no winner
+    int getFilledCells() const {return filledCells;}
+
+    // Sub-board the next move must be played in, or ANY_BOARD
+    int getTargetBoard() const {return target;}
+
+    const Board& getSubBoard(int index) const {return boards[index];}
+
+    // 'X' or 'O' if that side won the sub-board, 'T' if it filled up
+    // without a line, ' ' while it is open
+    char getSubBoardResult(int index) const;
+
+    // Sub-boards won by `symbol` / still open, as 9-bit meta masks
+    std::uint16_t getWonMask(char symbol) const;
+    std::uint16_t getOpenMask() const {return openMask;}
+
+    // Writes every legal move (cells row * 9 + col) to outCells, grouped by
+    // sub-board and row-major inside each; returns how many (at most 81)
+    int generateMoves(std::uint8_t* outCells) const;
+
+    // Number of legal moves, and the n-th of them in generateMoves() order
+    int countMoves() const;
+    int nthMove(int n) const;
+
+private:
+    Board boards[9];
+    std::uint16_t wonMasks[2];   // [side]: sub-boards with a line
+    std::uint16_t openMask;      // sub-boards neither won nor full
+    std::uint8_t metaWinner;     // bit 0: X has three in a line, bit 1: O
+    std::int8_t target;
+    std::uint8_t filledCells;
+
+    // Re-derives sub-board `index`'s bits from its Board after a change
+    void updateSubBoard(int index);
+
+    // Sub-boards the side to move may play in
+    std::uint16_t allowedBoards() const {
+        return (target == ANY_BOARD) ? openMask : static_cast<std::uint16_t>(1u << target);
+    }
+};
+
+#endif // FINALPROJECT_METABOARD_H
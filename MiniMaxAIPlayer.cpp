@@ -4,42 +4,101 @@
 
 #include "MiniMaxAIPlayer.h"
 #include "Board.h"
-#include <iostream>
-
-#include "MiniMaxAIPlayer.h"
-#include "Board.h"
+#include "MNKBoard.h"
+#include "ProofNumberSolver.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
 #include <limits>
-#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <optional>
+
+namespace {
+    // Static search order: center, corners, edges (cell = row * 3 + col)
+    constexpr int CENTER_CORNERS_EDGES[9] = {4, 0, 2, 6, 8, 1, 3, 5, 7};
+    constexpr int ROW_MAJOR[9] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+}
 
-MiniMaxAIPlayer::MiniMaxAIPlayer(char symbol, const std::string& name)
-    : AIPlayer(symbol, name) {}
+MiniMaxAIPlayer::MiniMaxAIPlayer(char symbol, std::string_view name)
+    : MiniMaxAIPlayer(symbol, SearchOptions(), name) {}
+
+MiniMaxAIPlayer::MiniMaxAIPlayer(char symbol, const SearchOptions& options,
+                                 std::string_view name)
+    : AIPlayer(symbol, name), options(options) {
+    resetOrderingTables();
+}
+
+template <typename BoardT>
+int MiniMaxAIPlayer::oracleMove(const BoardT& board, int cols,
+                                std::chrono::steady_clock::time_point start) {
+    if (options.oracle == nullptr) {
+        return -1;
+    }
+    const ProofNumberSolver::Result proven = options.oracle->solve(board);
+    if (proven.value == ProofNumberSolver::Value::Unknown || proven.bestMove < 0) {
+        return -1;
+    }
+    lastStats.nodes = proven.nodes;
+    lastStats.principalVariation.emplace_back(proven.bestMove / cols, proven.bestMove % cols);
+    lastStats.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    return proven.bestMove;
+}
 
 void MiniMaxAIPlayer::makeMove(Board& board) {
+    if (tryBookMove(board)) {return;}
+
+    const auto start = std::chrono::steady_clock::now();
+    beginSearch(MAX_PLY);
+
+    if (const int proven = oracleMove(board, 3, start); proven >= 0) {
+        board.applyMove(proven / 3, proven % 3, symbol);
+        return;
+    }
+
     int bestScore = std::numeric_limits<int>::min();
     int bestRow = -1;
     int bestCol = -1;
 
-    // Try every possible move
-    for (int r = 0; r < 3; ++r) {
-        for (int c = 0; c < 3; ++c) {
-            if (!board.isValidMove(r, c)) {
-                continue;
-            }
+    // The whole search plays and takes back moves on this one copy
+    Board work = board;
+
+    if (options.mode == SearchMode::Full) {
+        // Try every possible move
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                if (!work.isValidMove(r, c)) {
+                    continue;
+                }
 
-            Board temp = board;
-            temp.applyMove(r, c, symbol);
+                work.makeMove(r, c, symbol);
 
-            // After we move, opponent tries to minimize our score
-            int score = miniMaxInternal(temp, false);
+                // After we move, opponent tries to minimize our score
+                int score = miniMaxInternal(work, false, 1);
+                work.unmakeMove(r, c);
 
-            if (score > bestScore) {
-                bestScore = score;
-                bestRow = r;
-                bestCol = c;
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestRow = r;
+                    bestCol = c;
+                    updatePv(0, r * 3 + c);
+                }
             }
         }
+    } else {
+        int bestCell = searchRoot(work, bestScore);
+        if (bestCell != -1) {
+            bestRow = bestCell / 3;
+            bestCol = bestCell % 3;
+        }
     }
 
+    finishSearch(3, start);
+
     // Failsafe (shouldn't happen)
     if (bestRow == -1 || bestCol == -1) {
         playRandomMove(board);
@@ -49,20 +108,437 @@ void MiniMaxAIPlayer::makeMove(Board& board) {
     board.applyMove(bestRow, bestCol, symbol);
 }
 
-int MiniMaxAIPlayer::miniMaxInternal(Board& board, bool isMaximizing) {
-    int eval = evaluateBoard(board);
+void MiniMaxAIPlayer::makeMove(MNKBoard& board) {
+    if (tryBookMove(board)) {return;}
 
-    // Terminal states
-    if (eval == 10) {
-        // Prefer earlier wins
-        return 10 - board.filledCells;
+    const auto start = std::chrono::steady_clock::now();
+    beginSearch(board.getRows() * board.getCols() - board.getFilledCells() + 1);
+    const int cols = board.getCols();
+
+    if (const int proven = oracleMove(board, cols, start); proven >= 0) {
+        board.applyMove(proven / cols, proven % cols, symbol);
+        return;
     }
-    if (eval == -10) {
-        // Prefer later losses
-        return -10 + board.filledCells;
+
+    // The whole search plays and takes back moves on this one copy
+    MNKBoard work = board;
+    std::vector<int>& cells = plyMoves[0];
+    setCellOrder(work.getRows(), cols);
+    orderMoves(work, cells);
+    int bestCell = -1;
+
+    if (hasBudget()) {
+        bestCell = searchIteratively(work, cells, start);
+    } else {
+        int bestScore = 0;
+        bestCell = searchRoot(work, cells, bestScore);
     }
-    if (board.tieCheck()) {
-        return 0;
+
+    finishSearch(cols, start);
+
+    // Failsafe (shouldn't happen)
+    if (bestCell == -1) {
+        playRandomMove(board);
+        return;
+    }
+
+    board.applyMove(bestCell / cols, bestCell % cols, symbol);
+}
+
+int MiniMaxAIPlayer::searchRoot(Board& work, int& outBestScore) {
+    resetOrderingTables();
+
+    int cells[9];
+    int count = orderMoves(work, 0, cells);
+    int bestScore = -SCORE_INF;
+    int bestCell = -1;
+
+    if (options.pool != nullptr && count > 1) {
+        bestCell = searchRootParallel(work, cells, count, 3, bestScore);
+        count = 0;   // already searched
+    }
+
+    for (int i = 0; i < count; ++i) {
+        int cell = cells[i];
+        work.makeMove(cell / 3, cell % 3, symbol);
+
+        // Searching with alpha = best - 1 keeps every child that could tie
+        // the best exact, so ties can be broken in row-major order just like
+        // the full search, no matter which order the moves were visited in.
+        int alpha = (bestCell == -1) ? -SCORE_INF : bestScore - 1;
+        int score = alphaBeta(work, false, alpha, SCORE_INF, 1);
+        work.unmakeMove(cell / 3, cell % 3);
+
+        if (bestCell == -1 || score > bestScore ||
+            (score == bestScore && cell < bestCell)) {
+            bestScore = score;
+            bestCell = cell;
+            updatePv(0, cell);
+        }
+    }
+
+    outBestScore = bestScore;
+    return bestCell;
+}
+
+int MiniMaxAIPlayer::searchRoot(MNKBoard& work, const std::vector<int>& cells,
+                                int& outBestScore) {
+    const int cols = work.getCols();
+    int bestScore = -SCORE_INF;
+    int bestCell = -1;
+
+    if (options.pool != nullptr && cells.size() > 1) {
+        bestCell = searchRootParallel(work, cells.data(), static_cast<int>(cells.size()),
+                                      cols, bestScore);
+        outBestScore = bestScore;
+        return bestCell;
+    }
+
+    for (int cell : cells) {
+        work.makeMove(cell / cols, cell % cols, symbol);
+
+        // Same trick as the 3x3 search: keep possible ties exact for row-major tie-breaking
+        int alpha = (bestCell == -1) ? -SCORE_INF : bestScore - 1;
+        int score = alphaBeta(work, false, alpha, SCORE_INF, 1);
+        work.unmakeMove(cell / cols, cell % cols);
+
+        if (searchStopped()) {
+            break;   // the caller throws this pass away
+        }
+
+        if (bestCell == -1 || score > bestScore ||
+            (score == bestScore && cell < bestCell)) {
+            bestScore = score;
+            bestCell = cell;
+            updatePv(0, cell);
+        }
+    }
+
+    outBestScore = bestScore;
+    return bestCell;
+}
+
+// Iterative deepening
+// =====================
+
+struct MiniMaxAIPlayer::Budget {
+    bool timed = false;
+    std::chrono::steady_clock::time_point deadline;
+    long long nodeLimit = 0;                 // 0 = none
+    bool enforced = false;                   // off for the first iteration
+    std::atomic<long long> nodes{0};         // reported every BUDGET_CHECK_INTERVAL nodes
+    std::atomic<bool> stopped{false};
+};
+
+bool MiniMaxAIPlayer::hasBudget() const {
+    return options.timeBudget.count() > 0 || options.nodeBudget > 0 || options.depthLimit > 0;
+}
+
+int MiniMaxAIPlayer::searchIteratively(MNKBoard& work, std::vector<int>& cells,
+                                       std::chrono::steady_clock::time_point start) {
+    budget = std::make_shared<Budget>();
+    budget->timed = options.timeBudget.count() > 0;
+    budget->deadline = start + options.timeBudget;
+    budget->nodeLimit = options.nodeBudget;
+    nodesSinceCheck = 0;
+
+    const int emptyCells = static_cast<int>(cells.size());
+    const int maxDepth = (options.depthLimit > 0) ? std::min(options.depthLimit, emptyCells)
+                                                  : emptyCells;
+    int bestCell = -1;
+    std::vector<int> line;   // PV of the deepest finished iteration
+
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        depthLimit = depth;
+        budget->enforced = (depth > 1);
+
+        int score = 0;
+        int cell = searchRoot(work, cells, score);
+        if (searchStopped() || cell == -1) {
+            break;
+        }
+
+        bestCell = cell;
+        lastStats.completedDepth = depth;
+        line.assign(pvTable.begin(), pvTable.begin() + pvLength[0]);
+
+        // A forced win or loss inside the horizon won't change with more depth
+        if (std::abs(score) >= MNK_WIN) {
+            break;
+        }
+
+        // Search this iteration's best move first next time
+        auto it = std::find(cells.begin(), cells.end(), cell);
+        std::rotate(cells.begin(), it, it + 1);
+    }
+
+    std::copy(line.begin(), line.end(), pvTable.begin());
+    pvLength[0] = static_cast<int>(line.size());
+
+    budget.reset();
+    depthLimit = NO_DEPTH_LIMIT;
+    return bestCell;
+}
+
+void MiniMaxAIPlayer::checkBudget() {
+    const long long nodes = budget->nodes.fetch_add(nodesSinceCheck, std::memory_order_relaxed)
+                          + nodesSinceCheck;
+    nodesSinceCheck = 0;
+
+    if (!budget->enforced) {
+        return;
+    }
+    if ((budget->nodeLimit > 0 && nodes >= budget->nodeLimit) ||
+        (budget->timed && std::chrono::steady_clock::now() >= budget->deadline)) {
+        budget->stopped.store(true, std::memory_order_relaxed);
+    }
+}
+
+bool MiniMaxAIPlayer::searchStopped() const {
+    return budget && budget->stopped.load(std::memory_order_relaxed);
+}
+
+// Parallel root search
+// =====================
+
+template <typename BoardT>
+struct MiniMaxAIPlayer::RootSplit {
+    // Everything a worker needs is copied in here, so a pool job that only
+    // starts after makeMove() has returned still touches valid memory.
+    MiniMaxAIPlayer prototype;   // each worker searches with its own copy
+    BoardT board;
+    std::vector<int> cells;
+    int cols = 3;
+    int maxPly = 0;
+
+    std::atomic<int> nextMove{0};
+    std::atomic<int> sharedBest{-SCORE_INF};   // best root score so far (our alpha)
+
+    std::mutex mutex;
+    std::condition_variable allDone;
+    int finished = 0;
+    std::vector<int> scores;
+    std::vector<std::vector<int>> lines;       // each move's PV below the root
+    SearchStats stats;
+
+    RootSplit(const MiniMaxAIPlayer& owner, const BoardT& board,
+              const int* cells, int count, int cols)
+        : prototype(owner), board(board), cells(cells, cells + count), cols(cols),
+          maxPly(owner.pvStride - 2), scores(count), lines(count) {}
+};
+
+template <typename BoardT>
+int MiniMaxAIPlayer::searchRootParallel(const BoardT& board, const int* cells, int count,
+                                        int cols, int& outBestScore) {
+    auto split = std::make_shared<RootSplit<BoardT>>(*this, board, cells, count, cols);
+
+    // The first move is usually the best: searching it alone gives every
+    // worker a real bound to start from
+    searchRootMoves(split, 1);
+
+    const int helpers = static_cast<int>(std::min<std::size_t>(options.pool->size(), count - 1));
+    for (int i = 0; i < helpers; ++i) {
+        options.pool->submit([split, count] {searchRootMoves(split, count);});
+    }
+
+    // Search alongside the pool, so this also finishes if every worker is busy
+    // (or is the thread calling us)
+    searchRootMoves(split, count);
+
+    std::unique_lock<std::mutex> lock(split->mutex);
+    split->allDone.wait(lock, [&] {return split->finished == count;});
+
+    // Same choice as the serial loop: highest score, ties to the lowest cell
+    int best = -1;
+    for (int i = 0; i < count; ++i) {
+        if (best == -1 || split->scores[i] > split->scores[best] ||
+            (split->scores[i] == split->scores[best] && cells[i] < cells[best])) {
+            best = i;
+        }
+    }
+
+    lastStats.nodes += split->stats.nodes;
+    lastStats.leafEvaluations += split->stats.leafEvaluations;
+    lastStats.maxDepth = std::max(lastStats.maxDepth, split->stats.maxDepth);
+    lastStats.tableProbes += split->stats.tableProbes;
+    lastStats.tableHits += split->stats.tableHits;
+
+    const std::vector<int>& line = split->lines[best];
+    std::copy(line.begin(), line.end(), pvTable.begin() + pvStride);
+    pvLength[1] = static_cast<int>(line.size());
+    updatePv(0, cells[best]);
+
+    outBestScore = split->scores[best];
+    return cells[best];
+}
+
+template <typename BoardT>
+void MiniMaxAIPlayer::searchRootMoves(const std::shared_ptr<RootSplit<BoardT>>& split,
+                                      int limit) {
+    std::optional<MiniMaxAIPlayer> worker;   // only copied once there is work
+
+    while (true) {
+        int index = split->nextMove.load();
+        do {
+            if (index >= limit) return;
+        } while (!split->nextMove.compare_exchange_weak(index, index + 1));
+
+        if (!worker) {
+            worker.emplace(split->prototype);
+            worker->resetOrderingTables();
+        }
+        worker->beginSearch(split->maxPly);
+
+        const int cell = split->cells[index];
+        BoardT child = split->board;
+        child.applyMove(cell / split->cols, cell % split->cols, worker->symbol);
+
+        // Same alpha = best - 1 as the serial search, with the best taken from
+        // every worker: possible ties stay exact, worse moves are cut off sooner
+        const int best = split->sharedBest.load();
+        const int alpha = (best == -SCORE_INF) ? -SCORE_INF : best - 1;
+        const int score = worker->alphaBeta(child, false, alpha, SCORE_INF, 1);
+
+        int current = split->sharedBest.load();
+        while (score > current && !split->sharedBest.compare_exchange_weak(current, score)) {}
+
+        const SearchStats& stats = worker->lastStats;
+        const int* row = &worker->pvTable[static_cast<std::size_t>(worker->pvStride)];
+
+        std::lock_guard<std::mutex> lock(split->mutex);
+        split->scores[index] = score;
+        split->lines[index].assign(row, row + worker->pvLength[1]);
+        split->stats.nodes += stats.nodes;
+        split->stats.leafEvaluations += stats.leafEvaluations;
+        split->stats.maxDepth = std::max(split->stats.maxDepth, stats.maxDepth);
+        split->stats.tableProbes += stats.tableProbes;
+        split->stats.tableHits += stats.tableHits;
+
+        if (++split->finished == static_cast<int>(split->cells.size())) {
+            split->allDone.notify_all();
+        }
+    }
+}
+
+// Batch evaluation
+// =====================
+
+struct MiniMaxAIPlayer::Batch {
+    // As with RootSplit, a job that starts after evaluateBatch() has returned
+    // finds no chunks left and never touches the caller's arrays
+    MiniMaxAIPlayer prototype;
+    const Board* positions;
+    Evaluation* out;
+    std::size_t count;
+
+    std::atomic<std::size_t> nextChunk{0};
+
+    std::mutex mutex;
+    std::condition_variable allDone;
+    std::size_t finished = 0;
+    SearchStats stats;
+
+    Batch(const MiniMaxAIPlayer& owner, const Board* positions, std::size_t count, Evaluation* out)
+        : prototype(owner), positions(positions), out(out), count(count) {
+        prototype.options.pool = nullptr;   // parallel across positions, not within one
+    }
+};
+
+void MiniMaxAIPlayer::evaluateBatch(const Board* positions, std::size_t count, Evaluation* out) {
+    const auto start = std::chrono::steady_clock::now();
+    beginSearch(MAX_PLY);
+
+    auto batch = std::make_shared<Batch>(*this, positions, count, out);
+
+    if (options.pool != nullptr) {
+        const std::size_t chunks = (count + BATCH_CHUNK - 1) / BATCH_CHUNK;
+        const std::size_t helpers = std::min(options.pool->size(), chunks > 0 ? chunks - 1 : 0);
+        for (std::size_t i = 0; i < helpers; ++i) {
+            options.pool->submit([batch] {evaluateChunks(batch);});
+        }
+    }
+
+    // The calling thread works too, so this finishes even if the pool is busy
+    evaluateChunks(batch);
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->allDone.wait(lock, [&] {return batch->finished == count;});
+
+    lastStats.nodes = batch->stats.nodes;
+    lastStats.leafEvaluations = batch->stats.leafEvaluations;
+    lastStats.maxDepth = batch->stats.maxDepth;
+    lastStats.tableProbes = batch->stats.tableProbes;
+    lastStats.tableHits = batch->stats.tableHits;
+    pvLength[0] = 0;   // no single line for a batch
+    finishSearch(3, start);
+}
+
+MiniMaxAIPlayer::Evaluation MiniMaxAIPlayer::evaluate(const Board& board) {
+    Evaluation result;
+    evaluateBatch(&board, 1, &result);
+    return result;
+}
+
+void MiniMaxAIPlayer::evaluateChunks(const std::shared_ptr<Batch>& batch) {
+    std::optional<MiniMaxAIPlayer> worker;   // only copied once there is work
+
+    while (true) {
+        const std::size_t begin = batch->nextChunk.fetch_add(BATCH_CHUNK);
+        if (begin >= batch->count) {
+            break;
+        }
+        const std::size_t end = std::min(begin + BATCH_CHUNK, batch->count);
+
+        if (!worker) {
+            worker.emplace(batch->prototype);
+        }
+
+        SearchStats total;
+
+        for (std::size_t i = begin; i < end; ++i) {
+            Board work = batch->positions[i];
+            Evaluation& result = batch->out[i];
+
+            // Search as whoever is to move; X always starts
+            worker->symbol = (work.getFilledCells() % 2 == 0) ? 'X' : 'O';
+            worker->beginSearch(MAX_PLY);
+
+            if (worker->terminalScore(work, result.score)) {
+                result.bestMove = -1;
+                ++worker->lastStats.leafEvaluations;
+            } else {
+                result.bestMove = worker->searchRoot(work, result.score);
+            }
+
+            const SearchStats& stats = worker->lastStats;
+            total.nodes += stats.nodes;
+            total.leafEvaluations += stats.leafEvaluations;
+            total.maxDepth = std::max(total.maxDepth, stats.maxDepth);
+            total.tableProbes += stats.tableProbes;
+            total.tableHits += stats.tableHits;
+        }
+
+        std::lock_guard<std::mutex> lock(batch->mutex);
+        batch->stats.nodes += total.nodes;
+        batch->stats.leafEvaluations += total.leafEvaluations;
+        batch->stats.maxDepth = std::max(batch->stats.maxDepth, total.maxDepth);
+        batch->stats.tableProbes += total.tableProbes;
+        batch->stats.tableHits += total.tableHits;
+
+        batch->finished += end - begin;
+        if (batch->finished == batch->count) {
+            batch->allDone.notify_all();
+        }
+    }
+}
+
+int MiniMaxAIPlayer::miniMaxInternal(Board& board, bool isMaximizing, int ply) {
+    enterNode(ply);
+
+    int terminal = 0;
+    if (terminalScore(board, terminal)) {
+        ++lastStats.leafEvaluations;
+        return terminal;
     }
 
     char opp = getOpponentSymbol();
@@ -76,12 +552,13 @@ int MiniMaxAIPlayer::miniMaxInternal(Board& board, bool isMaximizing) {
                     continue;
                 }
 
-                Board temp = board;
-                temp.applyMove(r, c, symbol);
+                board.makeMove(r, c, symbol);
+                int score = miniMaxInternal(board, false, ply + 1);
+                board.unmakeMove(r, c);
 
-                int score = miniMaxInternal(temp, false);
                 if (score > best) {
                     best = score;
+                    updatePv(ply, r * 3 + c);
                 }
             }
         }
@@ -95,12 +572,13 @@ int MiniMaxAIPlayer::miniMaxInternal(Board& board, bool isMaximizing) {
                     continue;
                 }
 
-                Board temp = board;
-                temp.applyMove(r, c, opp);
+                board.makeMove(r, c, opp);
+                int score = miniMaxInternal(board, true, ply + 1);
+                board.unmakeMove(r, c);
 
-                int score = miniMaxInternal(temp, true);
                 if (score < best) {
                     best = score;
+                    updatePv(ply, r * 3 + c);
                 }
             }
         }
@@ -108,6 +586,110 @@ int MiniMaxAIPlayer::miniMaxInternal(Board& board, bool isMaximizing) {
     }
 }
 
+int MiniMaxAIPlayer::alphaBeta(Board& board, bool isMaximizing,
+                               int alpha, int beta, int ply) {
+    enterNode(ply);
+
+    int terminal = 0;
+    if (terminalScore(board, terminal)) {
+        ++lastStats.leafEvaluations;
+        return terminal;
+    }
+
+    char mover = isMaximizing ? symbol : getOpponentSymbol();
+    const int alphaOrig = alpha;
+    const int betaOrig = beta;
+    int cachedMove = -1;
+
+    if (options.table != nullptr) {
+        TranspositionTable::Entry entry;
+        ++lastStats.tableProbes;
+        if (options.table->probe(board, entry)) {
+            ++lastStats.tableHits;
+
+            // The table scores from the mover's side; flip to ours for the opponent
+            int score = isMaximizing ? entry.score : -entry.score;
+            auto bound = entry.bound;
+            if (!isMaximizing && bound == TranspositionTable::Bound::Lower) {
+                bound = TranspositionTable::Bound::Upper;
+            } else if (!isMaximizing && bound == TranspositionTable::Bound::Upper) {
+                bound = TranspositionTable::Bound::Lower;
+            }
+
+            if (bound == TranspositionTable::Bound::Exact) {
+                return score;
+            } else if (bound == TranspositionTable::Bound::Lower) {
+                alpha = std::max(alpha, score);
+            } else if (bound == TranspositionTable::Bound::Upper) {
+                beta = std::min(beta, score);
+            }
+            if (alpha >= beta) {
+                return score;
+            }
+            cachedMove = entry.bestMove;
+        }
+    }
+
+    int cells[9];
+    int count = orderMoves(board, ply, cells, cachedMove);
+    int best = isMaximizing ? -SCORE_INF : SCORE_INF;
+    int bestCell = -1;
+
+    for (int i = 0; i < count; ++i) {
+        int cell = cells[i];
+        board.makeMove(cell / 3, cell % 3, mover);
+        int score = alphaBeta(board, !isMaximizing, alpha, beta, ply + 1);
+        board.unmakeMove(cell / 3, cell % 3);
+
+        if (isMaximizing) {
+            if (score > best) {
+                best = score;
+                bestCell = cell;
+                updatePv(ply, cell);
+            }
+            alpha = std::max(alpha, score);
+        } else {
+            if (score < best) {
+                best = score;
+                bestCell = cell;
+                updatePv(ply, cell);
+            }
+            beta = std::min(beta, score);
+        }
+
+        if (alpha >= beta) {
+            recordCutoff(cell, ply);
+            break;
+        }
+    }
+
+    if (options.table != nullptr) {
+        TranspositionTable::Entry entry;
+        entry.bestMove = bestCell;
+
+        // Bounds are relative to the window we were called with
+        auto bound = TranspositionTable::Bound::Exact;
+        if (best <= alphaOrig) {
+            bound = TranspositionTable::Bound::Upper;
+        } else if (best >= betaOrig) {
+            bound = TranspositionTable::Bound::Lower;
+        }
+
+        // Store from the mover's side
+        if (isMaximizing) {
+            entry.score = best;
+            entry.bound = bound;
+        } else {
+            entry.score = -best;
+            entry.bound = (bound == TranspositionTable::Bound::Lower) ? TranspositionTable::Bound::Upper
+                        : (bound == TranspositionTable::Bound::Upper) ? TranspositionTable::Bound::Lower
+                        : bound;
+        }
+        options.table->store(board, entry);
+    }
+    return best;
+}
+
 int MiniMaxAIPlayer::evaluateBoard(const Board& board) const {
     char me = symbol;
     char opp = getOpponentSymbol();
@@ -119,4 +701,280 @@ int MiniMaxAIPlayer::evaluateBoard(const Board& board) const {
         return -10;
     }
     return 0;
-}
\ No newline at end of file
+}
+
+bool MiniMaxAIPlayer::terminalScore(const Board& board, int& outScore) const {
+    int eval = evaluateBoard(board);
+
+    if (eval == 10) {
+        // Prefer earlier wins
+        outScore = 10 - board.getFilledCells();
+        return true;
+    }
+    if (eval == -10) {
+        // Prefer later losses
+        outScore = -10 + board.getFilledCells();
+        return true;
+    }
+    if (board.tieCheck()) {
+        outScore = 0;
+        return true;
+    }
+    return false;
+}
+
+int MiniMaxAIPlayer::orderMoves(const Board& board, int ply, int outCells[9], int firstCell) const {
+    const int* order = (options.ordering == MoveOrdering::CenterCornersEdges)
+                       ? CENTER_CORNERS_EDGES
+                       : ROW_MAJOR;
+    const unsigned empty = board.getEmptyMask();
+
+    int count = 0;
+    for (int i = 0; i < 9; ++i) {
+        if (empty & (1u << order[i])) {
+            outCells[count++] = order[i];
+        }
+    }
+
+    if (options.historyHeuristic) {
+        // Stable, so equal history scores keep the static order
+        std::stable_sort(outCells, outCells + count, [this](int a, int b) {
+            return history[a] > history[b];
+        });
+    }
+
+    if (options.killerMoves && ply < MAX_PLY) {
+        // Move the killers (most recent first) to the front, if they are legal here
+        for (int k = 1; k >= 0; --k) {
+            int killer = killers[ply][k];
+            int* pos = std::find(outCells, outCells + count, killer);
+            if (killer >= 0 && pos != outCells + count) {
+                std::rotate(outCells, pos, pos + 1);
+            }
+        }
+    }
+
+    if (firstCell >= 0) {
+        int* pos = std::find(outCells, outCells + count, firstCell);
+        if (pos != outCells + count) {
+            std::rotate(outCells, pos, pos + 1);
+        }
+    }
+
+    return count;
+}
+
+void MiniMaxAIPlayer::recordCutoff(int cell, int ply) {
+    if (options.killerMoves && ply < MAX_PLY && killers[ply][0] != cell) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = cell;
+    }
+    if (options.historyHeuristic) {
+        // Cutoffs near the root prune bigger subtrees, so weight them more
+        int remaining = MAX_PLY - ply;
+        history[cell] += remaining * remaining;
+    }
+}
+
+void MiniMaxAIPlayer::resetOrderingTables() {
+    for (auto& slot : killers) {
+        slot[0] = -1;
+        slot[1] = -1;
+    }
+    std::fill(std::begin(history), std::end(history), 0);
+}
+
+// m,n,k search
+// =====================
+
+int MiniMaxAIPlayer::alphaBeta(MNKBoard& board, bool isMaximizing,
+                               int alpha, int beta, int ply) {
+    enterNode(ply);
+
+    if (budget && ++nodesSinceCheck == BUDGET_CHECK_INTERVAL) {
+        checkBudget();
+    }
+    if (searchStopped()) {
+        return 0;   // unwinding: the score is never used
+    }
+
+    int terminal = 0;
+    if (terminalScore(board, terminal)) {
+        ++lastStats.leafEvaluations;
+        return terminal;
+    }
+    if (ply >= depthLimit) {
+        ++lastStats.leafEvaluations;
+        return evaluateBoard(board);
+    }
+
+    char mover = isMaximizing ? symbol : getOpponentSymbol();
+    const int cols = board.getCols();
+    std::vector<int>& cells = plyMoves[ply];   // keeps its capacity from earlier nodes
+    orderMoves(board, cells);
+    int best = isMaximizing ? -SCORE_INF : SCORE_INF;
+
+    for (int cell : cells) {
+        board.makeMove(cell / cols, cell % cols, mover);
+        int score = alphaBeta(board, !isMaximizing, alpha, beta, ply + 1);
+        board.unmakeMove(cell / cols, cell % cols);
+
+        if (searchStopped()) {
+            return 0;
+        }
+
+        if (isMaximizing ? (score > best) : (score < best)) {
+            best = score;
+            updatePv(ply, cell);
+        }
+        if (isMaximizing) {
+            alpha = std::max(alpha, score);
+        } else {
+            beta = std::min(beta, score);
+        }
+
+        if (alpha >= beta) {
+            break;
+        }
+    }
+    return best;
+}
+
+bool MiniMaxAIPlayer::terminalScore(const MNKBoard& board, int& outScore) const {
+    // Like the 3x3 board's 10 - filled, offset by MNK_WIN so that no heuristic
+    // score can outweigh a real win or loss
+    const int top = MNK_WIN + board.getRows() * board.getCols() + 1;
+
+    if (board.winCheck(symbol)) {
+        outScore = top - board.getFilledCells();   // prefer earlier wins
+        return true;
+    }
+    if (board.winCheck(getOpponentSymbol())) {
+        outScore = -top + board.getFilledCells();  // prefer later losses
+        return true;
+    }
+    if (board.tieCheck()) {
+        outScore = 0;
+        return true;
+    }
+    return false;
+}
+
+int MiniMaxAIPlayer::evaluateBoard(const MNKBoard& board) const {
+    // Every run of k cells in a row that holds stones of only one side can
+    // still become a win for that side: n stones in it are worth n * n
+    constexpr int DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    const int rows = board.getRows();
+    const int cols = board.getCols();
+    const int k = board.getK();
+    const char me = symbol;
+    const char opp = getOpponentSymbol();
+
+    auto inside = [rows, cols](int r, int c) {
+        return r >= 0 && r < rows && c >= 0 && c < cols;
+    };
+
+    int score = 0;
+    for (const auto& d : DIRECTIONS) {
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                // Walk each line once, from the cell that has no predecessor
+                if (inside(r - d[0], c - d[1])) continue;
+
+                // Slide a k-cell window along the line, counting each side's stones
+                int mine = 0;
+                int theirs = 0;
+                int length = 0;
+                for (int rr = r, cc = c; inside(rr, cc); rr += d[0], cc += d[1]) {
+                    char value = board.getCellValue(rr, cc);
+                    mine += (value == me);
+                    theirs += (value == opp);
+
+                    if (++length > k) {
+                        char leaving = board.getCellValue(rr - k * d[0], cc - k * d[1]);
+                        mine -= (leaving == me);
+                        theirs -= (leaving == opp);
+                    }
+                    if (length >= k) {
+                        if (theirs == 0) score += mine * mine;
+                        else if (mine == 0) score -= theirs * theirs;
+                    }
+                }
+            }
+        }
+    }
+    return std::clamp(score, -(MNK_WIN - 1), MNK_WIN - 1);
+}
+
+void MiniMaxAIPlayer::orderMoves(const MNKBoard& board, std::vector<int>& outCells) const {
+    const int cols = board.getCols();
+
+    outCells.clear();
+    for (int cell : cellOrder) {
+        if (board.isValidMove(cell / cols, cell % cols)) {
+            outCells.push_back(cell);
+        }
+    }
+}
+
+void MiniMaxAIPlayer::setCellOrder(int rows, int cols) {
+    if (static_cast<int>(cellOrder.size()) == rows * cols && cellOrderCols == cols) {
+        return;
+    }
+    cellOrderCols = cols;
+    cellOrder.resize(static_cast<std::size_t>(rows * cols));
+    std::iota(cellOrder.begin(), cellOrder.end(), 0);
+
+    if (options.ordering == MoveOrdering::CenterCornersEdges) {
+        // Distance from the center, measured in doubled coordinates so even
+        // sizes (whose center falls between cells) stay in integers
+        auto distance = [rows, cols](int cell) {
+            int dr = std::abs(2 * (cell / cols) - (rows - 1));
+            int dc = std::abs(2 * (cell % cols) - (cols - 1));
+            return std::max(dr, dc);
+        };
+        std::stable_sort(cellOrder.begin(), cellOrder.end(), [&](int a, int b) {
+            return distance(a) < distance(b);
+        });
+    }
+}
+
+// Instrumentation
+// =====================
+
+void MiniMaxAIPlayer::beginSearch(int maxPly) {
+    lastStats.reset();
+
+    // One extra row so the deepest node can read its (empty) child line
+    pvStride = maxPly + 2;
+    pvTable.assign(static_cast<std::size_t>(pvStride * pvStride), -1);
+    pvLength.assign(static_cast<std::size_t>(pvStride), 0);
+    if (plyMoves.size() < pvLength.size()) {
+        plyMoves.resize(pvLength.size());
+    }
+}
+
+void MiniMaxAIPlayer::enterNode(int ply) {
+    ++lastStats.nodes;
+    lastStats.maxDepth = std::max(lastStats.maxDepth, ply);
+    pvLength[ply] = 0;
+}
+
+void MiniMaxAIPlayer::updatePv(int ply, int cell) {
+    int* row = &pvTable[static_cast<std::size_t>(ply * pvStride)];
+    const int* childRow = row + pvStride;
+    const int childLength = pvLength[ply + 1];
+
+    row[0] = cell;
+    std::copy(childRow, childRow + childLength, row + 1);
+    pvLength[ply] = childLength + 1;
+}
+
+void MiniMaxAIPlayer::finishSearch(int cols, std::chrono::steady_clock::time_point start) {
+    for (int i = 0; i < pvLength[0]; ++i) {
+        int cell = pvTable[static_cast<std::size_t>(i)];
+        lastStats.principalVariation.emplace_back(cell / cols, cell % cols);
+    }
+    lastStats.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+}
@@ -2,19 +2,225 @@
 #define FINALPROJECT_MINIMAXAIPLAYER_H
 
 #include "AIPlayer.h"
-#include <string>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 class Board;  // forward declaration
+class MNKBoard;
+class ProofNumberSolver;
+class ThreadPool;
+class TranspositionTable;
 
+/**
+ * MiniMaxAIPlayer searches the game tree to pick an optimal move.
+ *
+ * Two search modes are available:
+ *  - Full:      plain minimax over every empty cell (the original search)
+ *  - AlphaBeta: minimax with alpha-beta pruning and move ordering
+ *
+ * Both modes return exactly the same move: ties between equally good moves
+ * are always broken in row-major order, whatever order the search visits them.
+ * AlphaBeta can also reuse results through a TranspositionTable.
+ *
+ * On an MNKBoard the player always runs alpha-beta (the full tree is far too
+ * big), using the same row-major tie-breaking. The search is exhaustive, so
+ * it is only practical on small boards.
+ *
+ * With a time, node or depth budget, the m,n,k search deepens one ply at a
+ * time instead, scoring positions at the depth limit by their open lines,
+ * and plays the best move of the deepest iteration that finished in budget.
+ * (3x3 boards are always searched to the end: that takes well under a
+ * millisecond.)
+ *
+ * Given a ThreadPool, alpha-beta splits the root: the first (best-ordered)
+ * move is searched alone to get a bound, then the remaining moves are shared
+ * out among the pool's workers and the calling thread, which all raise one
+ * shared alpha as they finish. The move returned is the same as the serial
+ * search's; only node counts vary from run to run.
+ *
+ * evaluateBatch() analyses many 3x3 positions in one call for whichever side
+ * is to move in each, spreading them over the pool and sharing one
+ * transposition table across the whole batch.
+ */
 class MiniMaxAIPlayer : public AIPlayer {
 public:
-    explicit MiniMaxAIPlayer(char symbol, const std::string& name = "Minimax AI");
+    enum class SearchMode {
+        Full,
+        AlphaBeta
+    };
+
+    enum class MoveOrdering {
+        RowMajor,             // (0,0), (0,1), ... (2,2)
+        CenterCornersEdges    // center first, then corners, then edges
+                              // (on an MNKBoard: closest to the center first)
+    };
+
+    struct SearchOptions {
+        SearchMode mode = SearchMode::AlphaBeta;
+        MoveOrdering ordering = MoveOrdering::CenterCornersEdges;
+        bool killerMoves = false;        // try the last cutoff move at this ply first
+        bool historyHeuristic = false;   // prefer moves that caused cutoffs elsewhere
+
+        // Optional cache of searched positions (AlphaBeta only). Not owned, so
+        // several players can share one table across moves and games.
+        TranspositionTable* table = nullptr;
+
+        // Optional workers for a parallel root search (AlphaBeta only). Not owned;
+        // it is safe to make moves from inside one of the pool's own jobs.
+        ThreadPool* pool = nullptr;
+
+        // Per-move limits for iterative deepening on an MNKBoard; 0 means no limit,
+        // and with all three at 0 the search is exhaustive. The first iteration
+        // always finishes, so a move is played however small the budget.
+        std::chrono::milliseconds timeBudget{0};
+        long long nodeBudget = 0;
+        int depthLimit = 0;   // plies
+
+        // Optional solver asked first on either board (not owned; only an
+        // opening book, see AIPlayer::setOpeningBook, comes before it). When it
+        // proves a value within its own node budget, its move is played and the
+        // search is skipped: the move keeps a win or a draw but may differ from
+        // the search's (e.g. not the fastest win), and in a proven loss it is
+        // the solver's pick (the forced block, or the most central cell), not
+        // the slowest loss. Otherwise the search runs.
+        ProofNumberSolver* oracle = nullptr;
+    };
+
+    explicit MiniMaxAIPlayer(char symbol, std::string_view name = "Minimax AI");
+    MiniMaxAIPlayer(char symbol, const SearchOptions& options,
+                    std::string_view name = "Minimax AI");
 
     void makeMove(Board& board) override;
+    void makeMove(MNKBoard& board) override;
+
+    // Value of a position for the side to move
+    struct Evaluation {
+        int score = 0;       // as the search scores it: 10 - cells filled at the win,
+                             // 0 for a draw, negative for a loss
+        int bestMove = -1;   // cell (row * 3 + col) the search would play, -1 if the game is over
+    };
+
+    // Scores `count` reachable positions, each for the side to move (X when the
+    // piece counts are equal, O otherwise), writing the results to `out`. The
+    // player's own symbol does not matter; its options do: positions are shared
+    // out among options.pool's workers and the calling thread, and all of them
+    // probe and fill options.table. Each result matches what makeMove() would
+    // play, and getLastSearchStats() totals the work of the whole batch.
+    void evaluateBatch(const Board* positions, std::size_t count, Evaluation* out);
+    Evaluation evaluate(const Board& board);
+
+    const SearchOptions& getSearchOptions() const {return options;}
+
+    // Number of positions visited by the most recent makeMove() call
+    // (the full breakdown is in getLastSearchStats())
+    long long getLastNodeCount() const {return lastStats.nodes;}
 
 private:
-    int miniMaxInternal(Board& board, bool isMaximizing);
+    // Scores never leave [-10, 10] on a 3x3 board or [-(cells + 1), cells + 1]
+    // on an MNKBoard, so this acts as +/- infinity
+    static constexpr int SCORE_INF = 1000000;
+    static constexpr int MAX_PLY = 10;
+
+    // m,n,k scores: wins and losses are +/- (MNK_WIN + moves to spare), far
+    // from any heuristic score, which is clamped to +/- (MNK_WIN - 1)
+    static constexpr int MNK_WIN = 100000;
+    static constexpr int NO_DEPTH_LIMIT = 1 << 30;
+
+    // Budgets are checked (and nodes reported) once every this many nodes
+    static constexpr int BUDGET_CHECK_INTERVAL = 64;
+
+    // evaluateBatch() hands out positions this many at a time
+    static constexpr std::size_t BATCH_CHUNK = 64;
+
+    SearchOptions options;
+
+    // Move-ordering state, reset at the start of every makeMove()
+    int killers[MAX_PLY][2];
+    int history[9];
+
+    // Triangular principal-variation table: row `ply` holds the best line found
+    // from that ply, pvLength[ply] moves long. Rows are pvStride cells apart.
+    std::vector<int> pvTable;
+    std::vector<int> pvLength;
+    int pvStride = 0;
+
+    // m,n,k move lists, one per ply (row 0: the root's). Kept between
+    // searches, so nodes reuse their capacity instead of allocating.
+    std::vector<std::vector<int>> plyMoves;
+
+    // Every cell of the current m,n,k board size in search order; the move
+    // lists are this with the occupied cells left out
+    std::vector<int> cellOrder;
+    int cellOrderCols = 0;
+
+    // === Iterative deepening ===
+    // Shared by every worker of one makeMove(), so one of them running out of
+    // time stops them all
+    struct Budget;
+    std::shared_ptr<Budget> budget;
+    int depthLimit = NO_DEPTH_LIMIT;   // plies below the root
+    int nodesSinceCheck = 0;
+
+    // The oracle's proven move for `board` (cell row * cols + col), with
+    // lastStats filled in, or -1 if there is no oracle or it can't settle it
+    template <typename BoardT>
+    int oracleMove(const BoardT& board, int cols, std::chrono::steady_clock::time_point start);
+
+    bool hasBudget() const;
+    int searchIteratively(MNKBoard& work, std::vector<int>& cells,
+                          std::chrono::steady_clock::time_point start);
+    void checkBudget();
+    bool searchStopped() const;
+
+    // One pass over the root moves (serial or split across the pool);
+    // returns the best cell, or -1 if there were no moves
+    int searchRoot(MNKBoard& work, const std::vector<int>& cells, int& outBestScore);
+    int searchRoot(Board& work, int& outBestScore);   // alpha-beta only
+
+    // === Batch evaluation ===
+    struct Batch;
+    static void evaluateChunks(const std::shared_ptr<Batch>& batch);
+
+    // === Parallel root search ===
+    // State shared by the calling thread and the pool jobs of one makeMove()
+    template <typename BoardT> struct RootSplit;
+
+    template <typename BoardT>
+    int searchRootParallel(const BoardT& board, const int* cells, int count,
+                           int cols, int& outBestScore);
+
+    // Claims and searches root moves until the first `limit` have been taken
+    template <typename BoardT>
+    static void searchRootMoves(const std::shared_ptr<RootSplit<BoardT>>& split, int limit);
+
+    int miniMaxInternal(Board& board, bool isMaximizing, int ply);
+    int alphaBeta(Board& board, bool isMaximizing, int alpha, int beta, int ply);
     int evaluateBoard(const Board& board) const;
+
+    // m,n,k search
+    int alphaBeta(MNKBoard& board, bool isMaximizing, int alpha, int beta, int ply);
+    bool terminalScore(const MNKBoard& board, int& outScore) const;
+    int evaluateBoard(const MNKBoard& board) const;   // open-line heuristic
+    void orderMoves(const MNKBoard& board, std::vector<int>& outCells) const;
+    void setCellOrder(int rows, int cols);   // only recomputed when the size changes
+
+    // Terminal score of `board` from our point of view, or false if the game goes on
+    bool terminalScore(const Board& board, int& outScore) const;
+
+    // Fills `outCells` with the empty cells (0-8) in search order; returns the count.
+    // `firstCell` (e.g. a cached best move) is searched first when it is legal.
+    int orderMoves(const Board& board, int ply, int outCells[9], int firstCell = -1) const;
+    void recordCutoff(int cell, int ply);
+    void resetOrderingTables();
+
+    // === Instrumentation ===
+    void beginSearch(int maxPly);
+    void enterNode(int ply);              // counts the node and starts its PV
+    void updatePv(int ply, int cell);     // `cell` + the child's line becomes this ply's PV
+    void finishSearch(int cols, std::chrono::steady_clock::time_point start);
 };
 
 #endif // FINALPROJECT_MINIMAXAIPLAYER_H
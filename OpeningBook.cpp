@@ -0,0 +1,353 @@
+#include "OpeningBook.h"
+#include "Board.h"
+#include "GameRecord.h"
+#include "MNKBoard.h"
+#include "Rng.h"
+#include "Symmetry.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    constexpr char MAGIC[8] = {'T', 'T', 'T', 'B', 'O', 'O', 'K', '\0'};
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr int MAX_CELLS = MNKBoard::MAX_DIM * MNKBoard::MAX_DIM;
+
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;   // BYTE_ORDER_MARK as written
+        std::uint32_t rows;
+        std::uint32_t cols;
+        std::uint32_t k;
+        std::uint32_t maxPly;
+        std::int64_t minGames;
+        std::uint64_t games;       // games added
+        std::uint64_t entryCount;  // entries follow, sorted by key
+    };
+
+    struct FileEntry {
+        std::uint64_t key;
+        std::uint32_t xWins;
+        std::uint32_t oWins;
+        std::uint32_t draws;
+        std::uint32_t reserved;
+    };
+}
+
+OpeningBook::OpeningBook() : OpeningBook(3, 3, 3, Options()) {}
+
+OpeningBook::OpeningBook(int rows, int cols, int k) : OpeningBook(rows, cols, k, Options()) {}
+
+OpeningBook::OpeningBook(int rows, int cols, int k, const Options& options) : options(options) {
+    setGeometry(rows, cols, k);
+}
+
+void OpeningBook::setGeometry(int boardRows, int boardCols, int boardK) {
+    rows = std::clamp(boardRows, 1, MNKBoard::MAX_DIM);
+    cols = std::clamp(boardCols, 1, MNKBoard::MAX_DIM);
+    k = boardK;
+    symmetryCount = Symmetry::count(rows, cols);
+
+    // Fixed keys per (side, cell), so saved books stay valid between runs.
+    // Under symmetry `sym` a piece on `cell` hashes like a piece on its image,
+    // which makes hash `sym` of a position the plain hash of its transform.
+    const int cells = cellCount();
+    std::vector<std::uint64_t> base(static_cast<std::size_t>(2 * cells));
+    std::uint64_t seed = 0x4F50454E424F4F4Bull;
+    for (std::uint64_t& key : base) {
+        key = Rng::splitMix64(seed);
+    }
+
+    zobrist.assign(static_cast<std::size_t>(symmetryCount * 2 * cells), 0);
+    for (int sym = 0; sym < symmetryCount; ++sym) {
+        for (int side = 0; side < 2; ++side) {
+            for (int cell = 0; cell < cells; ++cell) {
+                const int image = Symmetry::mapCell(sym, rows, cols, cell);
+                zobrist[static_cast<std::size_t>((sym * 2 + side) * cells + cell)] =
+                    base[static_cast<std::size_t>(side * cells + image)];
+            }
+        }
+    }
+}
+
+std::uint64_t OpeningBook::canonical(const std::uint64_t* hashes, int count) {
+    return *std::min_element(hashes, hashes + count);
+}
+
+// Learning
+// =====================
+
+void OpeningBook::addGame(const int* cells, int moveCount, char winner) {
+    if (winner != 'X' && winner != 'O' && winner != 'T') {
+        return;
+    }
+
+    // Skip games with an illegal move before touching any counts
+    const int boardCells = cellCount();
+    std::vector<char> taken(static_cast<std::size_t>(boardCells), 0);
+    for (int i = 0; i < moveCount; ++i) {
+        if (cells[i] < 0 || cells[i] >= boardCells || taken[static_cast<std::size_t>(cells[i])]) {
+            return;
+        }
+        taken[static_cast<std::size_t>(cells[i])] = 1;
+    }
+
+    auto count = [winner](Stats& stats) {
+        if (winner == 'X') stats.xWins++;
+        else if (winner == 'O') stats.oWins++;
+        else stats.draws++;
+    };
+
+    // The empty board, then the position after each move up to maxPly
+    std::uint64_t hashes[MAX_SYMMETRIES] = {};
+    count(positions[canonical(hashes, symmetryCount)]);
+    const int plies = std::min(moveCount, options.maxPly);
+    for (int ply = 0; ply < plies; ++ply) {
+        for (int sym = 0; sym < symmetryCount; ++sym) {
+            hashes[sym] ^= zobristKey(sym, ply % 2, cells[ply]);
+        }
+        count(positions[canonical(hashes, symmetryCount)]);
+    }
+    games++;
+}
+
+void OpeningBook::addGame(const GameRecord& record) {
+    if (rows != 3 || cols != 3 || k != 3 || record.result() == ' ') {
+        return;
+    }
+    int cells[GameRecord::MAX_MOVES];
+    const int moveCount = record.moveCount();
+    for (int i = 0; i < moveCount; ++i) {
+        cells[i] = record.move(i);
+    }
+    addGame(cells, moveCount, record.result());
+}
+
+bool OpeningBook::merge(const OpeningBook& other) {
+    if (other.rows != rows || other.cols != cols || other.k != k) {
+        return false;
+    }
+    for (const auto& [key, stats] : other.positions) {
+        Stats& mine = positions[key];
+        mine.xWins += stats.xWins;
+        mine.oWins += stats.oWins;
+        mine.draws += stats.draws;
+    }
+    games += other.games;
+    return true;
+}
+
+// Lookup
+// =====================
+
+void OpeningBook::hashesOf(const char* cells, std::uint64_t* outHashes) const {
+    std::fill(outHashes, outHashes + symmetryCount, 0);
+    for (int cell = 0; cell < cellCount(); ++cell) {
+        if (cells[cell] == ' ') continue;
+        const int side = (cells[cell] == 'X') ? 0 : 1;
+        for (int sym = 0; sym < symmetryCount; ++sym) {
+            outHashes[sym] ^= zobristKey(sym, side, cell);
+        }
+    }
+}
+
+int OpeningBook::bestMove(const char* cells, int filled, bool over) const {
+    // The move leads to ply filled + 1, which has to be in the book
+    if (over || filled >= options.maxPly || filled >= cellCount()) {
+        return -1;
+    }
+
+    std::uint64_t hashes[MAX_SYMMETRIES];
+    hashesOf(cells, hashes);
+    const int xCount = static_cast<int>(std::count(cells, cells + cellCount(), 'X'));
+    const int side = (xCount > filled - xCount) ? 1 : 0;
+
+    int best = -1;
+    double bestScore = -1.0;
+    long long bestGames = 0;
+    for (int cell = 0; cell < cellCount(); ++cell) {
+        if (cells[cell] != ' ') continue;
+
+        std::uint64_t child[MAX_SYMMETRIES];
+        for (int sym = 0; sym < symmetryCount; ++sym) {
+            child[sym] = hashes[sym] ^ zobristKey(sym, side, cell);
+        }
+        const auto found = positions.find(canonical(child, symmetryCount));
+        if (found == positions.end()) continue;
+
+        const Stats& stats = found->second;
+        const long long played = stats.games();
+        if (played < options.minGames) continue;
+
+        // Wins plus half the draws, for the side making the move
+        const double wins = (side == 0) ? stats.xWins : stats.oWins;
+        const double score = (wins + 0.5 * stats.draws) / static_cast<double>(played);
+        if (score > bestScore || (score == bestScore && played > bestGames)) {
+            best = cell;
+            bestScore = score;
+            bestGames = played;
+        }
+    }
+    return best;
+}
+
+OpeningBook::Stats OpeningBook::statsFor(const char* cells) const {
+    std::uint64_t hashes[MAX_SYMMETRIES];
+    hashesOf(cells, hashes);
+    const auto found = positions.find(canonical(hashes, symmetryCount));
+    return (found != positions.end()) ? found->second : Stats();
+}
+
+int OpeningBook::bestMove(const Board& board) const {
+    if (rows != 3 || cols != 3 || k != 3) {
+        return -1;
+    }
+    char cells[9];
+    for (int cell = 0; cell < 9; ++cell) {
+        cells[cell] = board.getCellValue(cell / 3, cell % 3);
+    }
+    const bool over = board.winCheck('X') || board.winCheck('O') || board.tieCheck();
+    return bestMove(cells, board.getFilledCells(), over);
+}
+
+int OpeningBook::bestMove(const MNKBoard& board) const {
+    if (board.getRows() != rows || board.getCols() != cols || board.getK() != k) {
+        return -1;
+    }
+    std::array<char, MAX_CELLS> cells;
+    for (int cell = 0; cell < cellCount(); ++cell) {
+        cells[static_cast<std::size_t>(cell)] = board.getCellValue(cell / cols, cell % cols);
+    }
+    const bool over = board.winCheck('X') || board.winCheck('O') || board.tieCheck();
+    return bestMove(cells.data(), board.getFilledCells(), over);
+}
+
+OpeningBook::Stats OpeningBook::statsFor(const Board& board) const {
+    if (rows != 3 || cols != 3 || k != 3) {
+        return Stats();
+    }
+    char cells[9];
+    for (int cell = 0; cell < 9; ++cell) {
+        cells[cell] = board.getCellValue(cell / 3, cell % 3);
+    }
+    return statsFor(cells);
+}
+
+OpeningBook::Stats OpeningBook::statsFor(const MNKBoard& board) const {
+    if (board.getRows() != rows || board.getCols() != cols || board.getK() != k) {
+        return Stats();
+    }
+    std::array<char, MAX_CELLS> cells;
+    for (int cell = 0; cell < cellCount(); ++cell) {
+        cells[static_cast<std::size_t>(cell)] = board.getCellValue(cell / cols, cell % cols);
+    }
+    return statsFor(cells.data());
+}
+
+// Files
+// =====================
+
+bool OpeningBook::save(const std::string& path) {
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.rows = static_cast<std::uint32_t>(rows);
+    header.cols = static_cast<std::uint32_t>(cols);
+    header.k = static_cast<std::uint32_t>(k);
+    header.maxPly = static_cast<std::uint32_t>(options.maxPly);
+    header.minGames = options.minGames;
+    header.games = static_cast<std::uint64_t>(games);
+    header.entryCount = positions.size();
+
+    // Sorted, so the same book always gives the same file
+    std::vector<FileEntry> entries;
+    entries.reserve(positions.size());
+    for (const auto& [key, stats] : positions) {
+        entries.push_back({key, stats.xWins, stats.oWins, stats.draws, 0});
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const FileEntry& a, const FileEntry& b) {return a.key < b.key;});
+
+    // Written beside the target and renamed over it, as PositionDatabase does
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            error = "cannot write " + temporary;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entries.data()),
+                  static_cast<std::streamsize>(entries.size() * sizeof(FileEntry)));
+        if (!out) {
+            error = "error writing " + temporary;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        error = "cannot replace " + path + ": " + ec.message();
+        return false;
+    }
+    error.clear();
+    return true;
+}
+
+bool OpeningBook::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    FileHeader header{};
+    const char* problem = nullptr;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        problem = "not an opening book";
+    } else if (header.byteOrder != BYTE_ORDER_MARK) {
+        problem = "written on a machine with a different byte order";
+    } else if (header.version != VERSION) {
+        problem = "unsupported opening book version";
+    } else if (header.rows < 1 || header.rows > MNKBoard::MAX_DIM || header.cols < 1 ||
+               header.cols > MNKBoard::MAX_DIM || header.k < 1) {
+        problem = "corrupt opening book";
+    } else {
+        std::error_code ec;
+        const auto bytes = std::filesystem::file_size(path, ec);
+        if (ec || bytes != sizeof(FileHeader) + header.entryCount * sizeof(FileEntry)) {
+            problem = "truncated or corrupt opening book";
+        }
+    }
+
+    std::vector<FileEntry> entries;
+    if (problem == nullptr) {
+        entries.resize(static_cast<std::size_t>(header.entryCount));
+        if (!in.read(reinterpret_cast<char*>(entries.data()),
+                     static_cast<std::streamsize>(entries.size() * sizeof(FileEntry)))) {
+            problem = "truncated or corrupt opening book";
+        }
+    }
+    if (problem != nullptr) {
+        error = path + ": " + problem;
+        return false;
+    }
+
+    options.maxPly = static_cast<int>(header.maxPly);
+    options.minGames = header.minGames;
+    setGeometry(static_cast<int>(header.rows), static_cast<int>(header.cols), static_cast<int>(header.k));
+    games = static_cast<long long>(header.games);
+    positions.clear();
+    positions.reserve(entries.size());
+    for (const FileEntry& entry : entries) {
+        positions[entry.key] = Stats{entry.xWins, entry.oWins, entry.draws};
+    }
+    error.clear();
+    return true;
+}
@@ -0,0 +1,121 @@
+#ifndef FINALPROJECT_OPENINGBOOK_H
+#define FINALPROJECT_OPENINGBOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Symmetry.h"
+
+class Board;
+class MNKBoard;
+struct GameRecord;
+
+/**
+ * OpeningBook holds win/draw/loss counts for the early positions of one
+ * m,n,k board size, learned from finished games (self-play, tournaments,
+ * game-record files), and turns them into moves: the book move is the one
+ * whose resulting position scored best for the side that played it.
+ *
+ * Positions are keyed by Zobrist hash reduced by the board's symmetries (8
+ * on square boards, 4 otherwise), so rotated and mirrored openings share
+ * their statistics. A lookup hashes the position once per symmetry and then
+ * costs one table probe per empty cell, whatever the board size: no search.
+ *
+ * Only the first Options::maxPly plies of each game are stored, and a move
+ * is only suggested once its position has been reached in at least
+ * Options::minGames games. Books are filled single-threaded; lookups are
+ * const and can be shared by any number of players and threads (see
+ * AIPlayer::setOpeningBook).
+ */
+class OpeningBook {
+public:
+    static constexpr std::uint32_t VERSION = 1;
+
+    struct Options {
+        int maxPly = 8;           // positions after more moves than this are not stored
+        long long minGames = 20;  // games a position needs before its move is suggested
+    };
+
+    // Results of the games that reached a position
+    struct Stats {
+        std::uint32_t xWins = 0;
+        std::uint32_t oWins = 0;
+        std::uint32_t draws = 0;
+        long long games() const {return static_cast<long long>(xWins) + oWins + draws;}
+    };
+
+    OpeningBook();   // 3x3, k = 3
+    OpeningBook(int rows, int cols, int k);
+    OpeningBook(int rows, int cols, int k, const Options& options);
+
+    // === Learning ===
+
+    // Adds one finished game: cells (row * cols + col) in the order they were
+    // played from the empty board, X first, and 'X', 'O' or 'T'
+    void addGame(const int* cells, int moveCount, char winner);
+    void addGame(const GameRecord& record);   // 3x3 books only; unfinished records are skipped
+
+    // Adds another book's counts (same board size; false otherwise)
+    bool merge(const OpeningBook& other);
+
+    // === Lookup ===
+
+    // Cell (row * cols + col) of the book move for the side to move, or -1 if
+    // the position is over, past maxPly, not in the book or for another board size
+    int bestMove(const Board& board) const;
+    int bestMove(const MNKBoard& board) const;
+
+    // Counts for a position (all zero if it isn't in the book)
+    Stats statsFor(const Board& board) const;
+    Stats statsFor(const MNKBoard& board) const;
+
+    // === Files ===
+
+    // Native byte order, like PositionDatabase; load() replaces this book's
+    // contents and board size. Both return false and set getError() on failure.
+    bool save(const std::string& path);
+    bool load(const std::string& path);
+    const std::string& getError() const {return error;}
+
+    // === Info ===
+    int getRows() const {return rows;}
+    int getCols() const {return cols;}
+    int getK() const {return k;}
+    const Options& getOptions() const {return options;}
+    std::size_t size() const {return positions.size();}   // positions stored
+    long long gamesAdded() const {return games;}
+
+private:
+    static constexpr int MAX_SYMMETRIES = Symmetry::MAX_COUNT;
+
+    int rows = 3;
+    int cols = 3;
+    int k = 3;
+    Options options;
+    int symmetryCount = 8;
+    std::vector<std::uint64_t> zobrist;   // [(sym * 2 + side) * cells + cell]
+
+    std::unordered_map<std::uint64_t, Stats> positions;
+    long long games = 0;
+    std::string error;
+
+    void setGeometry(int boardRows, int boardCols, int boardK);
+    int cellCount() const {return rows * cols;}
+
+    std::uint64_t zobristKey(int sym, int side, int cell) const {
+        return zobrist[static_cast<std::size_t>((sym * 2 + side) * cellCount() + cell)];
+    }
+
+    // Hash of the position under every symmetry; the smallest is its key
+    static std::uint64_t canonical(const std::uint64_t* hashes, int count);
+
+    // Shared by both board types: `cells` holds 'X', 'O' or ' ' row-major
+    int bestMove(const char* cells, int filled, bool over) const;
+    Stats statsFor(const char* cells) const;
+    void hashesOf(const char* cells, std::uint64_t* outHashes) const;
+};
+
+#endif // FINALPROJECT_OPENINGBOOK_H
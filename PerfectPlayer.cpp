@@ -0,0 +1,19 @@
+#include "PerfectPlayer.h"
+#include "Board.h"
+#include "SolvedGame.h"
+#include <bit>
+
+PerfectPlayer::PerfectPlayer(char symbol) : AIPlayer(symbol, "Perfect AI") {}
+
+void PerfectPlayer::makeMove(Board& board) {
+    SolvedGame::Entry entry = SolvedGame::lookup(board);
+
+    // Boards no legal game can reach aren't in the table
+    if (!entry.reachable || entry.bestMoves == 0) {
+        playRandomMove(board);
+        return;
+    }
+
+    int cell = std::countr_zero(static_cast<unsigned>(entry.bestMoves));
+    board.applyMove(cell / 3, cell % 3, symbol);
+}
@@ -0,0 +1,22 @@
+#ifndef FINALPROJECT_PERFECTPLAYER_H
+#define FINALPROJECT_PERFECTPLAYER_H
+
+#include "AIPlayer.h"
+
+class Board;
+
+/**
+ * PerfectPlayer answers every move with one lookup in the compile-time
+ * SolvedGame table. It plays the same moves as MiniMaxAIPlayer (the first
+ * best-scoring cell in row-major order) without searching at all.
+ */
+class PerfectPlayer final : public AIPlayer {
+public:
+    explicit PerfectPlayer(char symbol);
+
+    // m,n,k boards use the default AIPlayer strategy
+    using AIPlayer::makeMove;
+    void makeMove(Board& board) override;
+};
+
+#endif // FINALPROJECT_PERFECTPLAYER_H
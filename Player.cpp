@@ -3,9 +3,33 @@
 //
 
 #include "Player.h"
+#include <functional>
+#include <mutex>
+#include <unordered_set>
 
-Player::Player(char symbol, const std::string& name) : symbol(symbol), name(name) {}
+namespace {
+    // Lets the name table be searched with a string_view, without building a string
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const {return std::hash<std::string_view>{}(name);}
+    };
+}
+
+Player::Player(char symbol, std::string_view name) : symbol(symbol), name(&intern(name)) {}
 
 char Player::getSymbol() const {return symbol;}
 
-const std::string& Player::getName() const {return name;}
\ No newline at end of file
+const std::string& Player::getName() const {return *name;}
+
+const std::string& Player::intern(std::string_view name) {
+    // Set elements never move, so the returned reference stays valid for good
+    static std::mutex mutex;
+    static std::unordered_set<std::string, NameHash, std::equal_to<>> names;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = names.find(name);
+    if (it == names.end()) {
+        it = names.emplace(name).first;
+    }
+    return *it;
+}
\ No newline at end of file
@@ -5,19 +5,25 @@
 #ifndef FINALPROJECT_PLAYER_H
 #define FINALPROJECT_PLAYER_H
 #include <string>
+#include <string_view>
 
 class Board;
 
 class Player {
 public:
-    Player(char symbol, const std::string& name);
+    // Taken as a view and interned, so naming a player never builds a string
+    Player(char symbol, std::string_view name);
     virtual ~Player() = default;
     char getSymbol() const;
     const std::string& getName() const;
     virtual void makeMove(Board& board) = 0;
+
+    // The one shared copy of `name`. Players keep a pointer to it instead of a
+    // string of their own, so creating or copying a player never copies its name.
+    static const std::string& intern(std::string_view name);
 protected:
     char symbol;
-    std::string name;
+    const std::string* name;   // interned
 
 };
 
@@ -0,0 +1,481 @@
+#include "PositionDatabase.h"
+#include "Board.h"
+#include "MNKBoard.h"
+#include "Symmetry.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+struct PositionDatabase::Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;       // BYTE_ORDER_MARK as written by the builder
+    std::uint8_t rows;
+    std::uint8_t cols;
+    std::uint8_t k;
+    std::uint8_t symmetryCount;
+    std::uint32_t bucketCount;
+    std::uint64_t slotCount;
+    std::uint64_t entryCount;
+    std::uint64_t displacementsOffset;
+    std::uint64_t keysOffset;
+    std::uint64_t recordsOffset;
+    std::uint64_t fileSize;
+};
+
+struct PositionDatabase::Record {
+    std::int16_t score;
+    std::uint8_t terminal;
+    std::uint8_t reserved;
+    std::uint32_t bestMoves;
+};
+
+namespace {
+    constexpr char MAGIC[8] = {'M', 'N', 'K', 'S', 'O', 'L', 'V', '\0'};
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    constexpr std::uint64_t EMPTY_KEY = ~0ULL;
+    constexpr int KEYS_PER_BUCKET = 4;
+
+    // splitmix64 finalizer: every input bit affects every output bit
+    constexpr std::uint64_t mix(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    std::uint32_t bucketOf(std::uint64_t key, std::uint32_t bucketCount) {
+        return static_cast<std::uint32_t>(mix(key) % bucketCount);
+    }
+
+    std::uint64_t slotOf(std::uint64_t key, std::uint32_t displacement, std::uint64_t slotCount) {
+        return mix(key + (displacement + 1ULL) * 0x9E3779B97F4A7C15ULL) % slotCount;
+    }
+
+    constexpr std::uint64_t align8(std::uint64_t offset) {
+        return (offset + 7) & ~7ULL;
+    }
+}
+
+// Symmetries
+// =====================
+
+void PositionDatabase::Symmetries::init(int rows, int cols) {
+    const int cells = rows * cols;
+
+    symmetryCount = Symmetry::count(rows, cols);
+    bytes = (cells + 7) / 8;
+    forward.assign(static_cast<std::size_t>(symmetryCount * bytes * 256), 0);
+    backward.assign(forward.size(), 0);
+
+    for (int sym = 0; sym < symmetryCount; ++sym) {
+        std::vector<int> to(static_cast<std::size_t>(cells));
+        for (int cell = 0; cell < cells; ++cell) {
+            to[static_cast<std::size_t>(cell)] = Symmetry::mapCell(sym, rows, cols, cell);
+        }
+
+        for (int byte = 0; byte < bytes; ++byte) {
+            std::uint32_t* fwd = &forward[static_cast<std::size_t>((sym * bytes + byte) * 256)];
+            std::uint32_t* bwd = &backward[static_cast<std::size_t>((sym * bytes + byte) * 256)];
+            for (int value = 0; value < 256; ++value) {
+                for (int bit = 0; bit < 8; ++bit) {
+                    const int cell = byte * 8 + bit;
+                    if (!(value & (1 << bit)) || cell >= cells) continue;
+                    fwd[value] |= 1u << to[static_cast<std::size_t>(cell)];
+                    bwd[value] |= 1u << static_cast<int>(std::find(to.begin(), to.end(), cell) - to.begin());
+                }
+            }
+        }
+    }
+}
+
+std::uint32_t PositionDatabase::Symmetries::apply(const std::vector<std::uint32_t>& tables,
+                                                  std::uint32_t mask, int sym) const {
+    const std::uint32_t* table = &tables[static_cast<std::size_t>(sym * bytes * 256)];
+    std::uint32_t result = 0;
+    for (int byte = 0; byte < bytes; ++byte) {
+        result |= table[byte * 256 + ((mask >> (byte * 8)) & 0xFF)];
+    }
+    return result;
+}
+
+std::uint64_t PositionDatabase::Symmetries::canonicalKey(std::uint32_t xMask, std::uint32_t oMask,
+                                                         int& outSym) const {
+    std::uint64_t best = EMPTY_KEY;
+    outSym = 0;
+    for (int sym = 0; sym < symmetryCount; ++sym) {
+        const std::uint64_t key = (static_cast<std::uint64_t>(transform(oMask, sym)) << 32)
+                                | transform(xMask, sym);
+        if (key < best) {
+            best = key;
+            outSym = sym;
+        }
+    }
+    return best;
+}
+
+// Building
+// =====================
+
+namespace {
+    // Memoized negamax over canonical positions. Every position it reaches is
+    // recorded, including the finished games one move below a live position.
+    struct Solver {
+        int cells = 0;
+        int top = 0;                                   // cells + 1, so wins score above 0
+        std::vector<std::vector<std::uint32_t>> linesThrough;   // per cell
+        std::unordered_map<std::uint64_t, std::pair<int, std::uint32_t>> live;   // score, best moves
+        std::unordered_map<std::uint64_t, int> finished;                         // score
+
+        bool completesLine(std::uint32_t stones, int cell) const {
+            for (std::uint32_t line : linesThrough[static_cast<std::size_t>(cell)]) {
+                if ((stones & line) == line) return true;
+            }
+            return false;
+        }
+
+        template <typename Canonical>
+        int solve(std::uint32_t x, std::uint32_t o, const Canonical& canonical) {
+            const std::uint64_t key = (static_cast<std::uint64_t>(o) << 32) | x;
+            auto it = live.find(key);
+            if (it != live.end()) {
+                return it->second.first;
+            }
+
+            const int filled = std::popcount(x | o);
+            const bool xToMove = (filled % 2 == 0);
+            const std::uint32_t empty = ~(x | o) & ((cells == 32) ? ~0u : ((1u << cells) - 1));
+
+            int best = -top - 1;
+            std::uint32_t bestMoves = 0;
+
+            for (std::uint32_t rest = empty; rest != 0; rest &= rest - 1) {
+                const int cell = std::countr_zero(rest);
+                const std::uint32_t bit = 1u << cell;
+                const std::uint32_t nx = xToMove ? (x | bit) : x;
+                const std::uint32_t no = xToMove ? o : (o | bit);
+
+                int score = 0;
+                if (completesLine(xToMove ? nx : no, cell)) {
+                    score = top - (filled + 1);   // win now; the child is a lost position
+                    finished.emplace(canonical(nx, no), -score);
+                } else if (filled + 1 == cells) {
+                    score = 0;
+                    finished.emplace(canonical(nx, no), 0);
+                } else {
+                    const std::uint64_t child = canonical(nx, no);
+                    score = -solve(static_cast<std::uint32_t>(child),
+                                   static_cast<std::uint32_t>(child >> 32), canonical);
+                }
+
+                if (score > best) {
+                    best = score;
+                    bestMoves = bit;
+                } else if (score == best) {
+                    bestMoves |= bit;
+                }
+            }
+
+            live.emplace(key, std::make_pair(best, bestMoves));
+            return best;
+        }
+    };
+}
+
+bool PositionDatabase::build(int rows, int cols, int k, const std::string& path,
+                             std::string& outError, BuildInfo* outInfo) {
+    const auto start = std::chrono::steady_clock::now();
+    const int cells = rows * cols;
+
+    if (rows < 1 || cols < 1 || cells > MAX_CELLS || k < 1 || k > std::max(rows, cols)) {
+        outError = "board must have 1 to " + std::to_string(MAX_CELLS)
+                 + " cells and k between 1 and its longest side";
+        return false;
+    }
+
+    // === Solve ===
+    Symmetries symmetries;
+    symmetries.init(rows, cols);
+
+    Solver solver;
+    solver.cells = cells;
+    solver.top = cells + 1;
+    solver.linesThrough.resize(static_cast<std::size_t>(cells));
+
+    constexpr int DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            for (const auto& d : DIRECTIONS) {
+                const int endR = r + d[0] * (k - 1);
+                const int endC = c + d[1] * (k - 1);
+                if (endR < 0 || endR >= rows || endC < 0 || endC >= cols) continue;
+
+                std::uint32_t line = 0;
+                for (int i = 0; i < k; ++i) {
+                    line |= 1u << ((r + d[0] * i) * cols + (c + d[1] * i));
+                }
+                for (int i = 0; i < k; ++i) {
+                    solver.linesThrough[static_cast<std::size_t>((r + d[0] * i) * cols + (c + d[1] * i))]
+                        .push_back(line);
+                }
+                if (k == 1) break;   // all four directions give the same one-cell line
+            }
+        }
+    }
+
+    auto canonical = [&symmetries](std::uint32_t x, std::uint32_t o) {
+        int sym = 0;
+        return symmetries.canonicalKey(x, o, sym);
+    };
+    solver.solve(0, 0, canonical);
+
+    // === Perfect hash ===
+    std::vector<std::uint64_t> entryKeys;
+    std::vector<Record> entryRecords;
+    entryKeys.reserve(solver.live.size() + solver.finished.size());
+    entryRecords.reserve(entryKeys.capacity());
+    for (const auto& [key, value] : solver.live) {
+        entryKeys.push_back(key);
+        entryRecords.push_back(Record{static_cast<std::int16_t>(value.first), 0, 0, value.second});
+    }
+    for (const auto& [key, score] : solver.finished) {
+        entryKeys.push_back(key);
+        entryRecords.push_back(Record{static_cast<std::int16_t>(score), 1, 0, 0});
+    }
+
+    const std::uint64_t entryCount = entryKeys.size();
+    const std::uint32_t bucketCount = static_cast<std::uint32_t>(entryCount / KEYS_PER_BUCKET + 1);
+    const std::uint64_t slotCount = entryCount + entryCount / 8 + 1;
+
+    // Place the biggest buckets first, while most slots are still free
+    std::vector<std::vector<std::uint32_t>> buckets(bucketCount);
+    for (std::uint32_t i = 0; i < entryCount; ++i) {
+        buckets[bucketOf(entryKeys[i], bucketCount)].push_back(i);
+    }
+    std::vector<std::uint32_t> order(bucketCount);
+    for (std::uint32_t b = 0; b < bucketCount; ++b) order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    std::vector<std::uint32_t> displacement(bucketCount, 0);
+    std::vector<std::uint64_t> slotKeys(slotCount, EMPTY_KEY);
+    std::vector<Record> slotRecords(slotCount, Record{0, 0, 0, 0});
+    std::vector<std::uint64_t> slots;
+
+    for (std::uint32_t b : order) {
+        const auto& members = buckets[b];
+        if (members.empty()) break;
+
+        for (std::uint32_t d = 0;; ++d) {
+            if (d == 1u << 24) {
+                outError = "could not build a perfect hash";
+                return false;
+            }
+
+            slots.clear();
+            bool fits = true;
+            for (std::uint32_t i : members) {
+                const std::uint64_t slot = slotOf(entryKeys[i], d, slotCount);
+                if (slotKeys[slot] != EMPTY_KEY ||
+                    std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                    fits = false;
+                    break;
+                }
+                slots.push_back(slot);
+            }
+            if (!fits) continue;
+
+            displacement[b] = d;
+            for (std::size_t j = 0; j < members.size(); ++j) {
+                slotKeys[slots[j]] = entryKeys[members[j]];
+                slotRecords[slots[j]] = entryRecords[members[j]];
+            }
+            break;
+        }
+    }
+
+    // === Write ===
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.rows = static_cast<std::uint8_t>(rows);
+    header.cols = static_cast<std::uint8_t>(cols);
+    header.k = static_cast<std::uint8_t>(k);
+    header.symmetryCount = static_cast<std::uint8_t>(symmetries.count());
+    header.bucketCount = bucketCount;
+    header.slotCount = slotCount;
+    header.entryCount = entryCount;
+    header.displacementsOffset = align8(sizeof(Header));
+    header.keysOffset = align8(header.displacementsOffset + bucketCount * sizeof(std::uint32_t));
+    header.recordsOffset = header.keysOffset + slotCount * sizeof(std::uint64_t);
+    header.fileSize = header.recordsOffset + slotCount * sizeof(Record);
+
+    // Written beside the target and renamed over it, so a process mapping the
+    // old file never sees a half-written one
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            outError = "cannot write " + temporary;
+            return false;
+        }
+
+        const char padding[8] = {};
+        auto padTo = [&](std::uint64_t offset) {
+            out.write(padding, static_cast<std::streamsize>(offset - static_cast<std::uint64_t>(out.tellp())));
+        };
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        padTo(header.displacementsOffset);
+        out.write(reinterpret_cast<const char*>(displacement.data()),
+                  static_cast<std::streamsize>(displacement.size() * sizeof(std::uint32_t)));
+        padTo(header.keysOffset);
+        out.write(reinterpret_cast<const char*>(slotKeys.data()),
+                  static_cast<std::streamsize>(slotKeys.size() * sizeof(std::uint64_t)));
+        out.write(reinterpret_cast<const char*>(slotRecords.data()),
+                  static_cast<std::streamsize>(slotRecords.size() * sizeof(Record)));
+        if (!out) {
+            outError = "error writing " + temporary;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        outError = "cannot replace " + path + ": " + ec.message();
+        return false;
+    }
+
+    if (outInfo != nullptr) {
+        outInfo->positions = static_cast<std::size_t>(entryCount);
+        outInfo->fileBytes = static_cast<std::size_t>(header.fileSize);
+        outInfo->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    return true;
+}
+
+// Reading
+// =====================
+
+PositionDatabase::~PositionDatabase() {
+    close();
+}
+
+bool PositionDatabase::open(const std::string& path) {
+    close();
+
+    // Lookups hash all over the tables
+    if (!file.open(path, MappedFile::Access::Random)) {
+        error = file.getError();
+        return false;
+    }
+    if (file.size() < sizeof(Header)) {
+        close();
+        error = path + " is too short to be a position database";
+        return false;
+    }
+    const unsigned char* data = file.data();
+    const std::size_t length = file.size();
+
+    // Everything below only checks the header; the tables are used in place
+    const auto* h = reinterpret_cast<const Header*>(data);
+    const char* problem = nullptr;
+    if (std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        problem = "not a position database";
+    } else if (h->byteOrder != BYTE_ORDER_MARK) {
+        problem = "written on a machine with a different byte order";
+    } else if (h->version != VERSION) {
+        problem = "unsupported database version";
+    } else if (h->fileSize != length || h->rows * h->cols > MAX_CELLS || h->bucketCount == 0 ||
+               h->slotCount == 0 || h->entryCount > h->slotCount ||
+               h->displacementsOffset % 8 != 0 || h->keysOffset % 8 != 0 || h->recordsOffset % 8 != 0 ||
+               h->displacementsOffset + h->bucketCount * sizeof(std::uint32_t) > h->keysOffset ||
+               h->keysOffset + h->slotCount * sizeof(std::uint64_t) > h->recordsOffset ||
+               h->recordsOffset + h->slotCount * sizeof(Record) > length) {
+        problem = "truncated or corrupt database";
+    }
+    if (problem != nullptr) {
+        const std::string message = path + ": " + problem;
+        close();
+        error = message;
+        return false;
+    }
+
+    header = h;
+    displacements = reinterpret_cast<const std::uint32_t*>(data + h->displacementsOffset);
+    keys = reinterpret_cast<const std::uint64_t*>(data + h->keysOffset);
+    records = reinterpret_cast<const Record*>(data + h->recordsOffset);
+    rows = h->rows;
+    cols = h->cols;
+    k = h->k;
+    symmetries.init(rows, cols);
+    error.clear();
+    return true;
+}
+
+void PositionDatabase::close() {
+    file.close();
+    header = nullptr;
+    displacements = nullptr;
+    keys = nullptr;
+    records = nullptr;
+    rows = cols = k = 0;
+}
+
+std::size_t PositionDatabase::size() const {
+    return header != nullptr ? static_cast<std::size_t>(header->entryCount) : 0;
+}
+
+std::size_t PositionDatabase::slotFor(std::uint64_t key) const {
+    const std::uint32_t d = displacements[bucketOf(key, header->bucketCount)];
+    return static_cast<std::size_t>(slotOf(key, d, header->slotCount));
+}
+
+bool PositionDatabase::lookup(std::uint32_t xMask, std::uint32_t oMask, Entry& outEntry) const {
+    if (!isOpen()) {
+        return false;
+    }
+
+    int sym = 0;
+    const std::uint64_t key = symmetries.canonicalKey(xMask, oMask, sym);
+    const std::size_t slot = slotFor(key);
+    if (keys[slot] != key) {
+        return false;   // not a reachable position
+    }
+
+    const Record& record = records[slot];
+    outEntry.score = record.score;
+    outEntry.terminal = record.terminal != 0;
+    outEntry.bestMoves = symmetries.inverse(record.bestMoves, sym);   // back to the caller's orientation
+    return true;
+}
+
+bool PositionDatabase::lookup(const Board& board, Entry& outEntry) const {
+    if (rows != 3 || cols != 3 || k != 3) {
+        return false;
+    }
+    return lookup(board.getMask('X'), board.getMask('O'), outEntry);
+}
+
+bool PositionDatabase::lookup(const MNKBoard& board, Entry& outEntry) const {
+    if (board.getRows() != rows || board.getCols() != cols || board.getK() != k) {
+        return false;
+    }
+
+    std::uint32_t xMask = 0;
+    std::uint32_t oMask = 0;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            const char cell = board.getCellValue(r, c);
+            if (cell == 'X') xMask |= 1u << (r * cols + c);
+            if (cell == 'O') oMask |= 1u << (r * cols + c);
+        }
+    }
+    return lookup(xMask, oMask, outEntry);
+}
@@ -0,0 +1,131 @@
+#ifndef FINALPROJECT_POSITIONDATABASE_H
+#define FINALPROJECT_POSITIONDATABASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+class Board;
+class MNKBoard;
+
+/**
+ * PositionDatabase is a solved-game file for one m,n,k board: every position
+ * reachable from the empty board, with its value and best moves.
+ *
+ * build() solves the game (memoized minimax over canonical positions) and
+ * writes the file; open() memory-maps it read-only, so nothing is parsed at
+ * startup and processes using the same file share one copy in the page cache.
+ *
+ * File layout (version 1, native little-endian, every section 8-byte aligned):
+ *   Header           magic, version, board size, section offsets
+ *   displacements    uint32[bucketCount]   perfect-hash displacement per bucket
+ *   keys             uint64[slotCount]     canonical key, EMPTY_KEY for unused slots
+ *   records          Record[slotCount]     score, terminal flag, best-move mask
+ *
+ * Positions are keyed by their canonical form (the smallest key among the
+ * board's rotations/reflections: 8 for square boards, 4 otherwise), and the
+ * keys are placed with a hash-and-displace perfect hash, so a lookup reads
+ * one displacement, one key and one record.
+ */
+class PositionDatabase {
+public:
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr int MAX_CELLS = 32;   // masks are 32 bits per side
+
+    // Value of a position for the side to move, on the MiniMax scale:
+    // cells + 1 - (cells filled when the game ends) for a win, 0 for a draw,
+    // minus that for a loss (10 - filled on a 3x3 board)
+    struct Entry {
+        int score = 0;
+        bool terminal = false;
+        std::uint32_t bestMoves = 0;   // bit (row * cols + col) for every best-scoring cell
+    };
+
+    struct BuildInfo {
+        std::size_t positions = 0;     // entries written
+        std::size_t fileBytes = 0;
+        double seconds = 0.0;
+    };
+
+    PositionDatabase() = default;
+    ~PositionDatabase();
+
+    PositionDatabase(const PositionDatabase&) = delete;
+    PositionDatabase& operator=(const PositionDatabase&) = delete;
+
+    // Solves every position of a rows x cols, k-in-a-row game and writes the
+    // database to `path`. Returns false (with a message in outError) if the
+    // board has more than MAX_CELLS cells or the file can't be written.
+    static bool build(int rows, int cols, int k, const std::string& path,
+                      std::string& outError, BuildInfo* outInfo = nullptr);
+
+    // Maps a database file; returns false and sets getError() if it is missing,
+    // truncated or from an incompatible version. Any earlier file is closed.
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const {return file.isOpen();}
+    const std::string& getError() const {return error;}
+
+    int getRows() const {return rows;}
+    int getCols() const {return cols;}
+    int getK() const {return k;}
+    std::size_t size() const;          // positions stored
+    std::size_t fileBytes() const {return file.size();}
+
+    // Looks up a position given as X and O cell masks (bit row * cols + col).
+    // Returns false for positions not in the database.
+    bool lookup(std::uint32_t xMask, std::uint32_t oMask, Entry& outEntry) const;
+
+    // Same, for boards of the database's size (false for any other size)
+    bool lookup(const Board& board, Entry& outEntry) const;
+    bool lookup(const MNKBoard& board, Entry& outEntry) const;
+
+private:
+    struct Header;
+    struct Record;
+
+    // The board's rotations/reflections as mask permutations (index 0 is the
+    // identity). Each one maps a mask a byte at a time through lookup tables.
+    class Symmetries {
+    public:
+        void init(int rows, int cols);
+        int count() const {return symmetryCount;}
+
+        std::uint32_t transform(std::uint32_t mask, int sym) const {return apply(forward, mask, sym);}
+        std::uint32_t inverse(std::uint32_t mask, int sym) const {return apply(backward, mask, sym);}
+
+        // Smallest key (O mask << 32 | X mask) among the symmetries of a
+        // position, and the symmetry that produces it
+        std::uint64_t canonicalKey(std::uint32_t xMask, std::uint32_t oMask, int& outSym) const;
+
+    private:
+        int symmetryCount = 0;
+        int bytes = 0;                          // bytes of mask that hold cells
+        std::vector<std::uint32_t> forward;     // [sym][byte][value]
+        std::vector<std::uint32_t> backward;
+
+        std::uint32_t apply(const std::vector<std::uint32_t>& tables,
+                            std::uint32_t mask, int sym) const;
+    };
+
+    MappedFile file;
+
+    const Header* header = nullptr;
+    const std::uint32_t* displacements = nullptr;
+    const std::uint64_t* keys = nullptr;
+    const Record* records = nullptr;
+
+    int rows = 0;
+    int cols = 0;
+    int k = 0;
+    Symmetries symmetries;
+    std::string error;
+
+    std::size_t slotFor(std::uint64_t key) const;
+};
+
+#endif // FINALPROJECT_POSITIONDATABASE_H
@@ -0,0 +1,493 @@
+#include "ProofNumberSolver.h"
+#include "Board.h"
+#include "MNKBoard.h"
+#include "Rng.h"
+#include "Symmetry.h"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+namespace {
+    // Right, down, down-right, down-left (same as MNKBoard)
+    constexpr int DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+}
+
+ProofNumberSolver::ProofNumberSolver() : ProofNumberSolver(Options()) {}
+
+ProofNumberSolver::ProofNumberSolver(const Options& options) : options(options) {
+    // Largest power of two that fits the budget (at least one bucket)
+    std::size_t capacity = BUCKET_SIZE;
+    while (capacity * 2 * sizeof(Slot) <= options.tableBytes) {
+        capacity *= 2;
+    }
+    table.resize(capacity);
+    indexMask = capacity - 1;
+
+    // Fixed keys: the same position hashes the same in every run
+    std::uint64_t seed = 0x5052464E534F4C56ull;
+    for (std::uint64_t& key : zobrist) {
+        key = Rng::splitMix64(seed);
+    }
+    drawGoalKey = Rng::splitMix64(seed);
+}
+
+void ProofNumberSolver::clear() {
+    std::fill(table.begin(), table.end(), Slot());
+}
+
+std::size_t ProofNumberSolver::tableSize() const {
+    return static_cast<std::size_t>(std::count_if(table.begin(), table.end(),
+                                                  [](const Slot& slot) {return slot.key != 0;}));
+}
+
+ProofNumberSolver::Result ProofNumberSolver::solve(const Board& board) {
+    return solve(3, 3, 3, board.getMask('X'), board.getMask('O'),
+                 board.winCheck('X'), board.winCheck('O'));
+}
+
+ProofNumberSolver::Result ProofNumberSolver::solve(const MNKBoard& board) {
+    const int boardRows = board.getRows();
+    const int boardCols = board.getCols();
+    if (boardRows * boardCols > 64) {
+        return Result();   // Unknown: doesn't fit the masks
+    }
+
+    std::uint64_t xMask = 0;
+    std::uint64_t oMask = 0;
+    for (int r = 0; r < boardRows; ++r) {
+        for (int c = 0; c < boardCols; ++c) {
+            const char value = board.getCellValue(r, c);
+            if (value == 'X') xMask |= 1ull << (r * boardCols + c);
+            else if (value == 'O') oMask |= 1ull << (r * boardCols + c);
+        }
+    }
+    return solve(boardRows, boardCols, board.getK(), xMask, oMask,
+                 board.winCheck('X'), board.winCheck('O'));
+}
+
+ProofNumberSolver::Result ProofNumberSolver::solve(int boardRows, int boardCols, int boardK,
+                                                   std::uint64_t xMask, std::uint64_t oMask,
+                                                   bool xWon, bool oWon) {
+    const auto start = std::chrono::steady_clock::now();
+    Result result;
+    setGeometry(boardRows, boardCols, boardK);
+
+    nodes = 0;
+    nodeLimit = options.nodeBudget;
+    aborted = false;
+
+    const int side = (std::popcount(xMask) > std::popcount(oMask)) ? 1 : 0;
+    if (xWon || oWon) {
+        // Game over: whoever has the line moved last
+        result.value = ((side == 0) ? xWon : oWon) ? Value::Win : Value::Loss;
+        result.elapsed = std::chrono::steady_clock::now() - start;
+        return result;
+    }
+
+    Node winRoot{{xMask, oMask}, side, false, {}};
+    for (int sym = 0; sym < symmetryCount; ++sym) {
+        for (int s = 0; s < 2; ++s) {
+            for (std::uint64_t rest = winRoot.masks[s]; rest != 0; rest &= rest - 1) {
+                winRoot.hashes[sym] ^= symmetryZobrist[sym * 128 + s * 64 + std::countr_zero(rest)];
+            }
+        }
+    }
+    Node drawRoot = winRoot;
+    drawRoot.drawIsGoal = true;
+    for (std::uint64_t& hash : drawRoot.hashes) {
+        hash ^= drawGoalKey;
+    }
+
+    // "Can the side to move win?", then, if not, "can it avoid losing?"
+    const Status win = prove(winRoot);
+    Status notLose = Status::Open;
+    if (win == Status::Success) {
+        result.value = Value::Win;
+    } else if (win == Status::Failure) {
+        notLose = prove(drawRoot);
+        if (notLose == Status::Success) result.value = Value::Draw;
+        else if (notLose == Status::Failure) result.value = Value::Loss;
+    }
+
+    if (result.value != Value::Unknown) {
+        // Extracting moves and proofs may have to re-search positions that
+        // were replaced in the table; that is part of the answer, so no budget
+        nodeLimit = 0;
+
+        if (result.value == Value::Loss) {
+            // Every move loses: play the most central (or the forced block)
+            int cells[64];
+            int count = 0;
+            if (classify(drawRoot, cells, count) == Status::Open) {
+                result.bestMove = cells[0];
+            } else {
+                const std::uint64_t empty = fullMask & ~(xMask | oMask);
+                const auto first = std::find_if(cellOrder.begin(), cellOrder.end(),
+                                                 [&](int cell) {return (empty >> cell) & 1;});
+                if (first != cellOrder.end()) result.bestMove = *first;
+            }
+        } else {
+            result.bestMove = provingMove(result.value == Value::Win ? winRoot : drawRoot);
+        }
+
+        if (options.countProofTree) {
+            std::unordered_set<std::uint64_t> seen;
+            if (result.value != Value::Loss) result.proofTreeSize += countProof(winRoot, seen);
+            if (result.value != Value::Win) result.proofTreeSize += countProof(drawRoot, seen);
+        }
+    }
+
+    result.nodes = nodes;
+    result.elapsed = std::chrono::steady_clock::now() - start;
+    return result;
+}
+
+void ProofNumberSolver::setGeometry(int boardRows, int boardCols, int boardK) {
+    if (boardRows == rows && boardCols == cols && boardK == k) {
+        return;
+    }
+    rows = boardRows;
+    cols = boardCols;
+    k = boardK;
+    clear();   // entries of another board size would be meaningless
+
+    const int cells = rows * cols;
+    fullMask = (cells == 64) ? ~0ull : (1ull << cells) - 1;
+
+    lines.clear();
+    for (const auto& d : DIRECTIONS) {
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                const int endRow = r + d[0] * (k - 1);
+                const int endCol = c + d[1] * (k - 1);
+                if (endRow >= rows || endCol < 0 || endCol >= cols) continue;
+
+                std::uint64_t line = 0;
+                for (int i = 0; i < k; ++i) {
+                    line |= 1ull << ((r + d[0] * i) * cols + c + d[1] * i);
+                }
+                lines.push_back(line);
+            }
+        }
+    }
+
+    // Center first, like MiniMaxAIPlayer's m,n,k move ordering
+    cellOrder.resize(cells);
+    for (int cell = 0; cell < cells; ++cell) cellOrder[cell] = cell;
+    auto distance = [this](int cell) {
+        const int dr = std::abs(2 * (cell / cols) - (rows - 1));
+        const int dc = std::abs(2 * (cell % cols) - (cols - 1));
+        return std::max(dr, dc);
+    };
+    std::stable_sort(cellOrder.begin(), cellOrder.end(), [&](int a, int b) {
+        return distance(a) < distance(b);
+    });
+
+    // Under symmetry `sym` a piece hashes like a piece on its image
+    symmetryCount = Symmetry::count(rows, cols);
+    symmetryZobrist.assign(static_cast<std::size_t>(symmetryCount) * 128, 0);
+    for (int sym = 0; sym < symmetryCount; ++sym) {
+        for (int cell = 0; cell < cells; ++cell) {
+            const int image = Symmetry::mapCell(sym, rows, cols, cell);
+            for (int s = 0; s < 2; ++s) {
+                symmetryZobrist[sym * 128 + s * 64 + cell] = zobrist[s * 64 + image];
+            }
+        }
+    }
+}
+
+ProofNumberSolver::Status ProofNumberSolver::prove(const Node& node) {
+    int cells[64];
+    int count = 0;
+    const Status status = classify(node, cells, count);
+    if (status != Status::Open) {
+        return status;
+    }
+
+    std::uint32_t phi = 1;
+    std::uint32_t delta = 1;
+    if (!lookup(keyOf(node), phi, delta) || (phi != 0 && delta != 0)) {
+        mid(node, INF, INF);
+        if (aborted) {
+            return Status::Open;
+        }
+        lookup(keyOf(node), phi, delta);
+    }
+    if (phi == 0) return Status::Success;
+    if (delta == 0) return Status::Failure;
+    return Status::Open;
+}
+
+void ProofNumberSolver::mid(const Node& node, std::uint32_t thPhi, std::uint32_t thDelta) {
+    if (nodeLimit != 0 && nodes >= nodeLimit) {
+        aborted = true;
+        return;
+    }
+    const long long startNodes = nodes++;
+
+    int cells[64];
+    int count = 0;
+    const Status status = classify(node, cells, count);
+    if (status != Status::Open) {
+        store(keyOf(node), (status == Status::Success) ? 0 : INF,
+              (status == Status::Success) ? INF : 0, 1);
+        return;
+    }
+
+    // Negamax form: the side to move succeeds if some child fails, so
+    //   phi = min over children of their delta,  delta = sum of their phi
+    // Children settled by classify() get their numbers here once and never
+    // take up table slots; the rest are looked up on every pass
+    const std::uint64_t key = keyOf(node);
+    std::uint64_t childKeys[64];
+    Status childStatus[64];
+    for (int i = 0; i < count; ++i) {
+        const Node child = play(node, cells[i]);
+        int unused = 0;
+        childKeys[i] = keyOf(child);
+        childStatus[i] = classify(child, nullptr, unused);
+    }
+
+    while (true) {
+        std::uint32_t phi = INF;
+        std::uint64_t deltaSum = 0;
+        bool deltaInfinite = false;
+        int best = 0;
+        std::uint32_t bestPhi = 1;
+        std::uint32_t bestDelta = INF;
+        std::uint32_t secondDelta = INF;
+
+        for (int i = 0; i < count; ++i) {
+            std::uint32_t childPhi = 1;
+            std::uint32_t childDelta = 1;
+            if (childStatus[i] == Status::Success) {
+                childPhi = 0;
+                childDelta = INF;
+            } else if (childStatus[i] == Status::Failure) {
+                childPhi = INF;
+                childDelta = 0;
+            } else {
+                lookup(childKeys[i], childPhi, childDelta);
+            }
+
+            phi = std::min(phi, childDelta);
+            if (childPhi >= INF) deltaInfinite = true;
+            else deltaSum += childPhi;
+            if (childDelta < bestDelta) {
+                secondDelta = bestDelta;
+                bestDelta = childDelta;
+                bestPhi = childPhi;
+                best = i;
+            } else if (childDelta < secondDelta) {
+                secondDelta = childDelta;
+            }
+        }
+        // INF is absorbing; finite sums stay just below it
+        const std::uint32_t delta = deltaInfinite
+            ? INF : static_cast<std::uint32_t>(std::min<std::uint64_t>(deltaSum, INF - 1));
+
+        if (phi >= thPhi || delta >= thDelta) {
+            store(key, phi, delta, static_cast<std::uint64_t>(nodes - startNodes));
+            return;
+        }
+
+        // Expand the most-proving child with thresholds that send control back
+        // here once another child (or this node's bound) is clearly better.
+        // The 1 + 1/4 slack on the sibling bound (the "1 + epsilon trick")
+        // stops the search from flip-flopping between two close children.
+        const std::uint64_t childThPhi = std::min<std::uint64_t>(
+            static_cast<std::uint64_t>(thDelta) - delta + bestPhi, INF);
+        const std::uint32_t childThDelta = std::min<std::uint32_t>(
+            thPhi, (secondDelta >= INF) ? INF : secondDelta + secondDelta / 4 + 1);
+
+        mid(play(node, cells[best]), static_cast<std::uint32_t>(childThPhi), childThDelta);
+        if (aborted) {
+            return;
+        }
+    }
+}
+
+ProofNumberSolver::Status ProofNumberSolver::classify(const Node& node, int* outCells,
+                                                      int& outCount) const {
+    const std::uint64_t own = node.masks[node.side];
+    const std::uint64_t opp = node.masks[1 - node.side];
+    const std::uint64_t empty = fullMask & ~(own | opp);
+    outCount = 0;
+
+    // One pass over the lines. A line free of the other side's pieces is
+    // "live" for a side; one empty cell left on it is a threat, two are a
+    // fork candidate (a cell on two such lines makes two threats at once,
+    // as two lines only meet in one cell).
+    std::uint64_t ownWins = 0;
+    std::uint64_t oppThreats = 0;
+    std::uint64_t once = 0;
+    std::uint64_t forks = 0;
+    bool ownLive = false;
+    bool oppLive = false;
+    for (std::uint64_t line : lines) {
+        const std::uint64_t open = line & empty;
+        const std::uint64_t rest = open & (open - 1);   // open minus its lowest cell
+        if ((line & opp) == 0) {
+            ownLive = true;
+            if (rest == 0) {
+                ownWins |= open;
+            } else if ((rest & (rest - 1)) == 0) {
+                forks |= once & open;
+                once |= open;
+            }
+        }
+        if ((line & own) == 0) {
+            oppLive = true;
+            if (rest == 0) oppThreats |= open;
+        }
+    }
+
+    if (ownWins != 0) {
+        return Status::Success;   // completes a line now
+    }
+    if (empty == 0) {
+        return node.drawIsGoal ? Status::Success : Status::Failure;
+    }
+    if (oppThreats & (oppThreats - 1)) {
+        return Status::Failure;   // can only block one of them
+    }
+
+    // A side with no live line can't win any more, so the rest of the game
+    // can only decide between a draw and its loss
+    if (!ownLive && !node.drawIsGoal) {
+        return Status::Failure;
+    }
+    if (!oppLive && node.drawIsGoal) {
+        return Status::Success;
+    }
+
+    if (oppThreats != 0) {
+        if (outCells != nullptr) outCells[outCount++] = std::countr_zero(oppThreats);
+        return Status::Open;
+    }
+    if (forks != 0) {
+        return Status::Success;   // unanswered, the opponent can block only one threat
+    }
+
+    if (outCells != nullptr) {
+        for (int cell : cellOrder) {
+            if ((empty >> cell) & 1) {
+                outCells[outCount++] = cell;
+            }
+        }
+    }
+    return Status::Open;
+}
+
+std::uint64_t ProofNumberSolver::winningCells(std::uint64_t own, std::uint64_t empty) const {
+    std::uint64_t cells = 0;
+    for (std::uint64_t line : lines) {
+        const std::uint64_t missing = line & ~own;
+        if (missing != 0 && (missing & (missing - 1)) == 0) {
+            cells |= missing;
+        }
+    }
+    return cells & empty;
+}
+
+ProofNumberSolver::Node ProofNumberSolver::play(const Node& node, int cell) const {
+    Node child = node;
+    child.masks[node.side] |= 1ull << cell;
+    child.side = 1 - node.side;
+    child.drawIsGoal = !node.drawIsGoal;
+    for (int sym = 0; sym < symmetryCount; ++sym) {
+        child.hashes[sym] = node.hashes[sym] ^ symmetryZobrist[sym * 128 + node.side * 64 + cell] ^ drawGoalKey;
+    }
+    return child;
+}
+
+std::uint64_t ProofNumberSolver::keyOf(const Node& node) const {
+    std::uint64_t key = node.hashes[0];
+    for (int sym = 1; sym < symmetryCount; ++sym) {
+        key = std::min(key, node.hashes[sym]);
+    }
+    return key;
+}
+
+bool ProofNumberSolver::lookup(std::uint64_t hash, std::uint32_t& outPhi,
+                               std::uint32_t& outDelta) const {
+    const std::uint64_t key = hash | 1;
+    const Slot* bucket = &table[hash & indexMask & ~std::size_t{BUCKET_SIZE - 1}];
+    for (int i = 0; i < BUCKET_SIZE; ++i) {
+        if (bucket[i].key == key) {
+            outPhi = bucket[i].phi;
+            outDelta = bucket[i].delta;
+            return true;
+        }
+    }
+    outPhi = 1;
+    outDelta = 1;
+    return false;
+}
+
+void ProofNumberSolver::store(std::uint64_t hash, std::uint32_t phi, std::uint32_t delta,
+                              std::uint64_t work) {
+    const std::uint64_t key = hash | 1;
+    Slot* bucket = &table[hash & indexMask & ~std::size_t{BUCKET_SIZE - 1}];
+
+    // Same position, else the slot that cost least to fill (empty ones cost 0)
+    Slot* slot = &bucket[0];
+    for (int i = 0; i < BUCKET_SIZE; ++i) {
+        if (bucket[i].key == key) {
+            slot = &bucket[i];
+            break;
+        }
+        if (bucket[i].work < slot->work) {
+            slot = &bucket[i];
+        }
+    }
+    slot->key = key;
+    slot->phi = phi;
+    slot->delta = delta;
+    slot->work = work;
+}
+
+int ProofNumberSolver::provingMove(const Node& node) {
+    const std::uint64_t own = node.masks[node.side];
+    const std::uint64_t empty = fullMask & ~(own | node.masks[1 - node.side]);
+    if (const std::uint64_t wins = winningCells(own, empty)) {
+        return std::countr_zero(wins);
+    }
+
+    // Nodes classify() settles (e.g. by a fork) list no moves: try them all
+    int cells[64];
+    int count = 0;
+    if (classify(node, cells, count) != Status::Open) {
+        for (int cell : cellOrder) {
+            if ((empty >> cell) & 1) cells[count++] = cell;
+        }
+    }
+    for (int i = 0; i < count; ++i) {
+        if (prove(play(node, cells[i])) == Status::Failure) {
+            return cells[i];
+        }
+    }
+    return -1;
+}
+
+long long ProofNumberSolver::countProof(const Node& node, std::unordered_set<std::uint64_t>& seen) {
+    if (!seen.insert(keyOf(node)).second) {
+        return 0;
+    }
+
+    int cells[64];
+    int count = 0;
+    if (classify(node, cells, count) != Status::Open) {
+        return 1;
+    }
+
+    // A success needs one refuting move; a failure needs all of them
+    if (prove(node) == Status::Success) {
+        return 1 + countProof(play(node, provingMove(node)), seen);
+    }
+    long long total = 1;
+    for (int i = 0; i < count; ++i) {
+        total += countProof(play(node, cells[i]), seen);
+    }
+    return total;
+}
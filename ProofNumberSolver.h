@@ -0,0 +1,151 @@
+#ifndef FINALPROJECT_PROOFNUMBERSOLVER_H
+#define FINALPROJECT_PROOFNUMBERSOLVER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "Symmetry.h"
+
+class Board;
+class MNKBoard;
+
+/**
+ * ProofNumberSolver proves the game-theoretic value (win, draw or loss for
+ * the side to move) of m,n,k positions with up to 64 cells, using
+ * depth-first proof-number search (df-pn).
+ *
+ * Proof-number search grows the tree where the answer is cheapest to
+ * settle: every node carries a proof number (how many leaves still have to
+ * be shown to be wins) and a disproof number, and the search always expands
+ * the most-proving leaf. df-pn does this depth-first with thresholds, so it
+ * only keeps the numbers in a transposition table, not a tree in memory.
+ *
+ * Proofs are yes/no questions, so a value takes up to two of them: "can the
+ * side to move win?" and, if not, "can it avoid losing?" (where a full board
+ * counts for it). Positions are two 64-bit masks; a move that completes a
+ * line is found by mask tests over the board's lines, a double threat
+ * against the side to move is a loss, and a single threat leaves the block
+ * as its only move.
+ *
+ * The table has a fixed size (Options::tableBytes); a new entry replaces
+ * the one of its bucket's four that took the least work to compute. It
+ * survives between solve() calls on boards of the same size, so the
+ * positions of one game share it. A solve that runs out of its node budget returns Unknown, which
+ * lets AI players use the solver as an oracle: play the proven move if
+ * there is one, search as usual otherwise (see MiniMaxAIPlayer).
+ */
+class ProofNumberSolver {
+public:
+    // For the side to move (X if the piece counts are equal, O otherwise)
+    enum class Value : std::int8_t {
+        Unknown = -2,   // out of budget, or the board is not supported
+        Loss = -1,
+        Draw = 0,
+        Win  = 1
+    };
+
+    struct Options {
+        std::size_t tableBytes = std::size_t{16} << 20;
+        long long nodeBudget = 10'000'000;   // per solve(); 0 means no limit
+        bool countProofTree = true;          // fill Result::proofTreeSize
+    };
+
+    struct Result {
+        Value value = Value::Unknown;
+        int bestMove = -1;            // cell row * cols + col keeping `value`, -1 if none
+        long long nodes = 0;          // positions expanded by the search
+        long long proofTreeSize = 0;  // distinct positions in the proof (and disproof)
+        std::chrono::nanoseconds elapsed{0};
+    };
+
+    ProofNumberSolver();
+    explicit ProofNumberSolver(const Options& options);
+
+    Result solve(const Board& board);
+    Result solve(const MNKBoard& board);   // rows * cols must be at most 64
+
+    const Options& getOptions() const {return options;}
+    void clear();
+
+    // === Table statistics ===
+    std::size_t tableCapacity() const {return table.size();}
+    std::size_t tableSize() const;       // occupied slots
+    std::size_t memoryBytes() const {return table.size() * sizeof(Slot);}
+
+private:
+    static constexpr std::uint32_t INF = 1u << 30;
+    static constexpr int MAX_SYMMETRIES = Symmetry::MAX_COUNT;
+    static constexpr int BUCKET_SIZE = 4;
+
+    // A position from the side to move's point of view
+    struct Node {
+        std::uint64_t masks[2];   // [side]: X pieces, O pieces
+        int side;                 // to move: 0 = X, 1 = O
+        bool drawIsGoal;          // does a full board count as success for the side to move?
+        std::uint64_t hashes[MAX_SYMMETRIES];   // Zobrist key of masks and drawIsGoal,
+                                                // under each symmetry of the board
+    };
+
+    enum class Status {Success, Failure, Open};
+
+    struct Slot {
+        std::uint64_t key = 0;    // hash | 1, so 0 marks an empty slot
+        std::uint32_t phi = 0;    // proof number for the side to move
+        std::uint32_t delta = 0;  // disproof number
+        std::uint64_t work = 0;   // nodes spent computing it
+    };
+
+    Options options;
+    std::vector<Slot> table;      // buckets of BUCKET_SIZE slots
+    std::size_t indexMask = 0;
+
+    // Geometry of the boards the table currently holds
+    int rows = 0;
+    int cols = 0;
+    int k = 0;
+    std::uint64_t fullMask = 0;
+    std::vector<std::uint64_t> lines;
+    std::vector<int> cellOrder;   // cells closest to the center first
+    int symmetryCount = 1;        // 8 for square boards, 4 otherwise
+    std::vector<std::uint64_t> symmetryZobrist;   // [sym * 128 + side * 64 + cell]
+
+    std::array<std::uint64_t, 128> zobrist{};   // [side * 64 + cell]
+    std::uint64_t drawGoalKey = 0;
+
+    long long nodes = 0;
+    long long nodeLimit = 0;      // 0: none (proof extraction)
+    bool aborted = false;
+
+    Result solve(int boardRows, int boardCols, int boardK,
+                 std::uint64_t xMask, std::uint64_t oMask, bool xWon, bool oWon);
+    void setGeometry(int boardRows, int boardCols, int boardK);
+
+    // Resolves `node` (phi == 0 or delta == 0) unless the budget runs out;
+    // a position that fell out of the table is searched again
+    Status prove(const Node& node);
+    void mid(const Node& node, std::uint32_t thPhi, std::uint32_t thDelta);
+
+    // Settles the node from the masks alone where it can; otherwise writes
+    // its moves (best first) to `outCells`, if not null, and returns Open
+    Status classify(const Node& node, int* outCells, int& outCount) const;
+    std::uint64_t winningCells(std::uint64_t own, std::uint64_t empty) const;
+    Node play(const Node& node, int cell) const;
+
+    // Table key: the smallest of the symmetric hashes, so rotated and
+    // mirrored copies of a position share one entry
+    std::uint64_t keyOf(const Node& node) const;
+
+    // Table lookup; false (and 1/1 numbers) for a position never stored
+    bool lookup(std::uint64_t hash, std::uint32_t& outPhi, std::uint32_t& outDelta) const;
+    void store(std::uint64_t hash, std::uint32_t phi, std::uint32_t delta, std::uint64_t work);
+
+    // A move that keeps a Success node a success (-1 for Failure nodes)
+    int provingMove(const Node& node);
+    long long countProof(const Node& node, std::unordered_set<std::uint64_t>& seen);
+};
+
+#endif // FINALPROJECT_PROOFNUMBERSOLVER_H
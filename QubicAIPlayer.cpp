@@ -0,0 +1,215 @@
+#include "QubicAIPlayer.h"
+#include "Board.h"
+#include "QubicBoard.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+namespace {
+    // Worth of an open line (no enemy piece) holding 0-4 of a player's pieces
+    constexpr int LINE_WEIGHT[5] = {0, 1, 6, 40, 0};
+
+    bool exactlyTwo(std::uint64_t bits) {
+        const std::uint64_t rest = bits & (bits - 1);
+        return rest != 0 && (rest & (rest - 1)) == 0;
+    }
+}
+
+QubicAIPlayer::QubicAIPlayer(char symbol, std::string_view name)
+    : QubicAIPlayer(symbol, Options(), name) {}
+
+QubicAIPlayer::QubicAIPlayer(char symbol, const Options& options, std::string_view name)
+    : AIPlayer(symbol, name), options(options) {}
+
+void QubicAIPlayer::makeMove(Board& board) {
+    if (tryWinningMove(board)) {return;}
+    else if (tryBlockingMove(board)) {return;}
+    else if (tryTakeCenter(board)) {return;}
+    else {playRandomMove(board); return;}
+}
+
+void QubicAIPlayer::makeMove(QubicBoard& board) {
+    const auto start = std::chrono::steady_clock::now();
+    lastStats.reset();
+
+    const char opponent = getOpponentSymbol();
+    const std::uint64_t own = board.getMask(symbol);
+    const std::uint64_t opp = board.getMask(opponent);
+    const std::uint64_t empty = board.getEmptyMask();
+    if (empty == 0 || board.winCheck('X') || board.winCheck('O')) {
+        return;   // nothing to play
+    }
+
+    int cell = -1;
+    if (const std::uint64_t wins = QubicBoard::winningCells(own, empty)) {
+        // 1) Win
+        cell = std::countr_zero(wins);
+    } else if (const std::uint64_t threats = QubicBoard::winningCells(opp, empty)) {
+        // 1) Block (with two threats against us this only delays the loss)
+        cell = std::countr_zero(threats);
+    } else {
+        // 2) A forced win by threats alone
+        cell = findThreatWin(own, opp, options.threatDepth);
+    }
+
+    if (cell == -1) {
+        // 3) Alpha-beta over every move, most promising first
+        int moves[QubicBoard::CELLS];
+        const int count = orderMoves(own, opp, moves, QubicBoard::CELLS);
+        int alpha = -WIN_SCORE - 1;
+        const int beta = WIN_SCORE + 1;
+
+        for (int i = 0; i < count; ++i) {
+            const int score = -negamax(opp, own | (1ull << moves[i]), options.maxDepth - 1,
+                                       -beta, -alpha, 1);
+            if (cell == -1 || score > alpha) {
+                alpha = score;
+                cell = moves[i];
+            }
+        }
+        lastStats.completedDepth = options.maxDepth;
+    }
+
+    lastStats.principalVariation.emplace_back(cell / 16, cell % 16);
+    lastStats.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    board.makeMove(cell, symbol);
+}
+
+int QubicAIPlayer::findThreatWin(std::uint64_t own, std::uint64_t opp, int depth) {
+    lastStats.nodes++;
+    const std::uint64_t empty = ~(own | opp);
+
+    if (const std::uint64_t wins = QubicBoard::winningCells(own, empty)) {
+        return std::countr_zero(wins);
+    }
+    if (depth <= 0) {
+        return -1;
+    }
+
+    // A threat needs a line with two of our pieces and nothing of theirs
+    std::uint64_t candidates = 0;
+    for (std::uint64_t line : QubicBoard::LINES) {
+        if ((line & opp) == 0 && exactlyTwo(line & own)) {
+            candidates |= line & empty;
+        }
+    }
+
+    for (; candidates != 0; candidates &= candidates - 1) {
+        const int cell = std::countr_zero(candidates);
+        const std::uint64_t bit = 1ull << cell;
+        const std::uint64_t afterOwn = own | bit;
+        const std::uint64_t threats = QubicBoard::winningCells(afterOwn, empty & ~bit);
+
+        // Two threats: the opponent (who has none) can only block one
+        if (threats & (threats - 1)) {
+            return cell;
+        }
+
+        // One threat: the reply is forced. Only follow it if the block
+        // doesn't give the opponent a threat we would have to answer.
+        const std::uint64_t afterOpp = opp | threats;
+        if (QubicBoard::winningCells(afterOpp, empty & ~bit & ~threats) != 0) {
+            continue;
+        }
+        if (findThreatWin(afterOwn, afterOpp, depth - 1) != -1) {
+            return cell;
+        }
+    }
+    return -1;
+}
+
+int QubicAIPlayer::negamax(std::uint64_t own, std::uint64_t opp, int depth,
+                           int alpha, int beta, int ply) {
+    lastStats.nodes++;
+    lastStats.maxDepth = std::max(lastStats.maxDepth, ply);
+
+    const std::uint64_t empty = ~(own | opp);
+    if (empty == 0) {
+        return 0;
+    }
+    if (QubicBoard::winningCells(own, empty) != 0) {
+        return WIN_SCORE - ply;
+    }
+
+    // Threats against us prune the move list: two lose, one must be blocked.
+    // Forced blocks don't use up depth.
+    const std::uint64_t threats = QubicBoard::winningCells(opp, empty);
+    if (threats & (threats - 1)) {
+        return -(WIN_SCORE - ply - 1);
+    }
+    if (threats != 0) {
+        return -negamax(opp, own | threats, depth, -beta, -alpha, ply + 1);
+    }
+
+    // Replies to the root move: one that lets the opponent (us, here) win by
+    // threats alone is as good as lost for the root
+    if (ply == 1 && findThreatWin(own, opp, options.threatDepth) != -1) {
+        return WIN_SCORE - ply - 1;
+    }
+
+    if (depth <= 0) {
+        lastStats.leafEvaluations++;
+        return evaluate(own, opp);
+    }
+
+    int moves[QubicBoard::CELLS];
+    const int count = orderMoves(own, opp, moves, options.maxCandidates);
+    int best = -WIN_SCORE - 1;
+    for (int i = 0; i < count; ++i) {
+        const int score = -negamax(opp, own | (1ull << moves[i]), depth - 1, -beta, -alpha, ply + 1);
+        best = std::max(best, score);
+        alpha = std::max(alpha, score);
+        if (alpha >= beta) {
+            break;
+        }
+    }
+    return best;
+}
+
+int QubicAIPlayer::evaluate(std::uint64_t own, std::uint64_t opp) {
+    int score = 0;
+    for (std::uint64_t line : QubicBoard::LINES) {
+        const std::uint64_t mine = line & own;
+        const std::uint64_t theirs = line & opp;
+        if (theirs == 0) score += LINE_WEIGHT[std::popcount(mine)];
+        else if (mine == 0) score -= LINE_WEIGHT[std::popcount(theirs)];
+    }
+    return score;
+}
+
+int QubicAIPlayer::orderMoves(std::uint64_t own, std::uint64_t opp, int* outCells, int limit) {
+    int scores[QubicBoard::CELLS];
+    int count = 0;
+
+    for (std::uint64_t empty = ~(own | opp); empty != 0; empty &= empty - 1) {
+        const int cell = std::countr_zero(empty);
+
+        // Lines through the cell that are still open for us (attack) or for them (defence)
+        int score = 0;
+        const QubicBoard::CellLines& through = QubicBoard::CELL_LINES[cell];
+        for (int i = 0; i < through.count; ++i) {
+            const std::uint64_t line = QubicBoard::LINES[through.lines[i]];
+            const std::uint64_t mine = line & own;
+            const std::uint64_t theirs = line & opp;
+            if (theirs == 0) score += 1 + 2 * LINE_WEIGHT[std::popcount(mine)];
+            if (mine == 0) score += LINE_WEIGHT[std::popcount(theirs)];
+        }
+
+        // Insertion into the best-first list, keeping at most `limit`
+        int pos = std::min(count, limit);
+        while (pos > 0 && scores[pos - 1] < score) {
+            if (pos < limit) {
+                scores[pos] = scores[pos - 1];
+                outCells[pos] = outCells[pos - 1];
+            }
+            --pos;
+        }
+        if (pos < limit) {
+            scores[pos] = score;
+            outCells[pos] = cell;
+            count = std::min(count + 1, limit);
+        }
+    }
+    return count;
+}
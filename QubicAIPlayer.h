@@ -0,0 +1,71 @@
+#ifndef FINALPROJECT_QUBICAIPLAYER_H
+#define FINALPROJECT_QUBICAIPLAYER_H
+
+#include "AIPlayer.h"
+#include <cstdint>
+#include <string_view>
+
+class QubicBoard;
+
+/**
+ * QubicAIPlayer plays 4x4x4 Qubic (QubicBoard) with a search built around
+ * threats, all of it on the two 64-bit masks:
+ *
+ *  1. Win if it can; block if the opponent threatens a line.
+ *  2. Threat-space search: look for a sequence of moves that each make a
+ *     threat (three in a line with the fourth empty), so every reply is
+ *     forced, ending in a double threat. Found wins are certain.
+ *  3. Otherwise an alpha-beta search over the most promising moves, where
+ *     a threat against the side to move leaves it a single legal reply (the
+ *     block), two threats are scored as lost, and at the first ply every
+ *     move that gives the opponent a threat-space win is pruned.
+ *
+ * Threats are UnbeatableAIPlayer's rules generalized to the 76 lines of the
+ * cube (QubicBoard::winningCells). Forks are found inside the threat-space
+ * search: only cells on a line holding two of our pieces can make a threat,
+ * and one that makes two is a fork. That is cheaper than asking
+ * QubicBoard::forkCells, which tries every empty cell.
+ * Search statistics are reported in getLastSearchStats(); PV moves are
+ * (layer, row * 4 + col).
+ */
+class QubicAIPlayer final : public AIPlayer {
+public:
+    struct Options {
+        int maxDepth = 3;         // alpha-beta plies (forced blocks don't count)
+        int threatDepth = 6;      // own forcing moves in a threat-space search
+        int maxCandidates = 12;   // moves tried per alpha-beta node, best-ordered first
+    };
+
+    explicit QubicAIPlayer(char symbol, std::string_view name = "Qubic AI");
+    QubicAIPlayer(char symbol, const Options& options, std::string_view name = "Qubic AI");
+
+    using AIPlayer::makeMove;
+
+    // 3x3 boards get the Regular AI strategy (win, block, center, random)
+    void makeMove(Board& board) override;
+
+    void makeMove(QubicBoard& board);
+
+    const Options& getOptions() const {return options;}
+
+    // First move of a forced win by threats alone for a player holding `own`
+    // (to move) against `opp`, using at most `depth` of its own moves, or -1.
+    // The opponent must not already threaten to win.
+    int findThreatWin(std::uint64_t own, std::uint64_t opp, int depth);
+
+private:
+    static constexpr int WIN_SCORE = 1000000;
+
+    Options options;
+
+    int negamax(std::uint64_t own, std::uint64_t opp, int depth, int alpha, int beta, int ply);
+
+    // Line-based score for the player holding `own`: open lines count more
+    // the fuller they are
+    static int evaluate(std::uint64_t own, std::uint64_t opp);
+
+    // Writes up to `limit` empty cells, most promising first; returns how many
+    static int orderMoves(std::uint64_t own, std::uint64_t opp, int* outCells, int limit);
+};
+
+#endif // FINALPROJECT_QUBICAIPLAYER_H
@@ -0,0 +1,154 @@
+#include "QubicBoard.h"
+#include <bit>
+#include <iostream>
+
+static_assert([] {
+    int total = 0;
+    for (const auto& cell : QubicBoard::CELL_LINES) total += cell.count;
+    return total == QubicBoard::LINE_COUNT * QubicBoard::SIZE;
+}(), "every line has four cells");
+
+QubicBoard::QubicBoard() : xMask(0), oMask(0), completedLines(0) {}
+
+void QubicBoard::display() const {
+    // The four layers side by side
+    std::cout << "\n";
+    for (int layer = 0; layer < SIZE; ++layer) {
+        std::cout << "  layer " << layer << "   ";
+    }
+    std::cout << "\n";
+    for (int row = 0; row < SIZE; ++row) {
+        for (int layer = 0; layer < SIZE; ++layer) {
+            std::cout << "  ";
+            for (int col = 0; col < SIZE; ++col) {
+                const char value = getCellValue(layer, row, col);
+                std::cout << (value == ' ' ? '.' : value) << ' ';
+            }
+            std::cout << "  ";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "\n";
+}
+
+char QubicBoard::getCellValue(int layer, int row, int col) const {
+    // assume valid indices, like Board
+    return getCell(cellIndex(layer, row, col));
+}
+
+char QubicBoard::getCell(int cell) const {
+    const std::uint64_t bit = 1ull << cell;
+    if (xMask & bit) return 'X';
+    if (oMask & bit) return 'O';
+    return ' ';
+}
+
+bool QubicBoard::isValidMove(int layer, int row, int col) const {
+    if (layer < 0 || layer >= SIZE || row < 0 || row >= SIZE || col < 0 || col >= SIZE) return false;
+    else return ((xMask | oMask) & (1ull << cellIndex(layer, row, col))) == 0;
+}
+
+void QubicBoard::applyMove(int layer, int row, int col, char symbol) {
+    // Caller should already have checked isValidMove
+    if (isValidMove(layer, row, col) && (symbol == 'X' || symbol == 'O')) {
+        makeMove(cellIndex(layer, row, col), symbol);
+    }
+}
+
+void QubicBoard::makeMove(int cell, char symbol) {
+    const int side = (symbol == 'X') ? 0 : 1;
+    std::uint64_t& own = (side == 0) ? xMask : oMask;
+
+    if (wouldWin(own, cell)) {
+        completedLines |= static_cast<std::uint8_t>(1u << side);
+    }
+    own |= 1ull << cell;
+}
+
+void QubicBoard::unmakeMove(int cell) {
+    const std::uint64_t bit = 1ull << cell;
+    const int side = (xMask & bit) ? 0 : 1;
+    std::uint64_t& own = (side == 0) ? xMask : oMask;
+
+    own &= ~bit;
+    // Only a position that had a line needs a rescan (searches stop at the first one)
+    if (completedLines & (1u << side)) {
+        if (!hasLine(own)) {
+            completedLines &= static_cast<std::uint8_t>(~(1u << side));
+        }
+    }
+}
+
+bool QubicBoard::winCheck(char symbol) const {
+    if (symbol == 'X') return (completedLines & 0x1) != 0;
+    if (symbol == 'O') return (completedLines & 0x2) != 0;
+    return false;
+}
+
+bool QubicBoard::tieCheck() const {
+    return ~(xMask | oMask) == 0 && completedLines == 0;
+}
+
+int QubicBoard::getFilledCells() const {
+    return std::popcount(xMask | oMask);
+}
+
+std::uint64_t QubicBoard::getMask(char symbol) const {
+    if (symbol == 'X') return xMask;
+    if (symbol == 'O') return oMask;
+    return 0;
+}
+
+bool QubicBoard::wouldWin(std::uint64_t own, int cell) {
+    const std::uint64_t after = own | (1ull << cell);
+    const CellLines& through = CELL_LINES[cell];
+    for (int i = 0; i < through.count; ++i) {
+        const std::uint64_t line = LINES[through.lines[i]];
+        if ((after & line) == line) return true;
+    }
+    return false;
+}
+
+bool QubicBoard::hasLine(std::uint64_t own) {
+    for (std::uint64_t line : LINES) {
+        if ((own & line) == line) return true;
+    }
+    return false;
+}
+
+std::uint64_t QubicBoard::winningCells(std::uint64_t own, std::uint64_t empty) {
+    std::uint64_t cells = 0;
+    for (std::uint64_t line : LINES) {
+        const std::uint64_t missing = line & ~own;
+        if ((missing & (missing - 1)) == 0) {   // at most one cell missing
+            cells |= missing;
+        }
+    }
+    return cells & empty;
+}
+
+std::uint64_t QubicBoard::forkCells(std::uint64_t own, std::uint64_t empty) {
+    // Same rule as UnbeatableAIPlayer: a fork leaves two or more winning cells.
+    // Only the lines through the new piece change, so start from the threats
+    // `own` already has and add the ones those lines create.
+    const std::uint64_t existing = winningCells(own, empty);
+    std::uint64_t forks = 0;
+    for (std::uint64_t rest = empty; rest != 0; rest &= rest - 1) {
+        const int cell = std::countr_zero(rest);
+        const std::uint64_t bit = 1ull << cell;
+        const std::uint64_t after = own | bit;
+
+        std::uint64_t threats = existing & ~bit;
+        const CellLines& through = CELL_LINES[cell];
+        for (int i = 0; i < through.count; ++i) {
+            const std::uint64_t missing = LINES[through.lines[i]] & ~after;
+            if ((missing & (missing - 1)) == 0) {
+                threats |= missing & empty;
+            }
+        }
+        if (std::popcount(threats) >= 2) {
+            forks |= bit;
+        }
+    }
+    return forks;
+}
@@ -0,0 +1,123 @@
+#ifndef FINALPROJECT_QUBICBOARD_H
+#define FINALPROJECT_QUBICBOARD_H
+
+#include <array>
+#include <cstdint>
+
+/**
+ * QubicBoard is 3D TicTacToe on a 4x4x4 cube: four in a row along any of the
+ * 76 straight lines wins (48 along an axis, 24 diagonals within a plane and
+ * the 4 space diagonals).
+ *
+ * Each side's pieces are one 64-bit mask; cell (layer, row, col) is bit
+ * (layer * 16 + row * 4 + col). The line table and the cell -> lines table
+ * are generated at compile time, so a move only checks the 4 or 7 lines
+ * through its cell, and threat detection (cells that would complete a line)
+ * is a pass of AND/compare over the 76 masks.
+ */
+class QubicBoard {
+public:
+    static constexpr int SIZE = 4;
+    static constexpr int CELLS = 64;
+    static constexpr int LINE_COUNT = 76;
+    static constexpr int MAX_LINES_PER_CELL = 7;   // corners and the 8 inner cells
+
+    static constexpr auto LINES = [] {
+        std::array<std::uint64_t, LINE_COUNT> lines{};
+        int n = 0;
+        // Every direction (dl, dr, dc) with its first nonzero step positive,
+        // so each line is generated once
+        for (int dl = -1; dl <= 1; ++dl) {
+            for (int dr = -1; dr <= 1; ++dr) {
+                for (int dc = -1; dc <= 1; ++dc) {
+                    const int first = (dl != 0) ? dl : (dr != 0) ? dr : dc;
+                    if (first <= 0) continue;
+
+                    // Lines run across the whole cube, so every start cell
+                    // whose fourth step stays inside begins one
+                    for (int l = 0; l < SIZE; ++l) {
+                        for (int r = 0; r < SIZE; ++r) {
+                            for (int c = 0; c < SIZE; ++c) {
+                                const int el = l + 3 * dl;
+                                const int er = r + 3 * dr;
+                                const int ec = c + 3 * dc;
+                                if (el < 0 || el >= SIZE || er < 0 || er >= SIZE ||
+                                    ec < 0 || ec >= SIZE) continue;
+
+                                std::uint64_t line = 0;
+                                for (int i = 0; i < SIZE; ++i) {
+                                    line |= 1ull << ((l + i * dl) * 16 + (r + i * dr) * 4 + (c + i * dc));
+                                }
+                                lines[n++] = line;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return lines;
+    }();
+
+    // No member initializers (they would not exist yet inside the class);
+    // the table below value-initializes its entries instead
+    struct CellLines {
+        int count;
+        std::array<std::uint8_t, MAX_LINES_PER_CELL> lines;
+    };
+
+    static constexpr auto CELL_LINES = [] {
+        std::array<CellLines, CELLS> table{};
+        for (int line = 0; line < LINE_COUNT; ++line) {
+            for (int cell = 0; cell < CELLS; ++cell) {
+                if (LINES[line] & (1ull << cell)) {
+                    table[cell].lines[table[cell].count++] = static_cast<std::uint8_t>(line);
+                }
+            }
+        }
+        return table;
+    }();
+
+    QubicBoard();
+
+    static int cellIndex(int layer, int row, int col) {return layer * 16 + row * 4 + col;}
+
+    void display() const;
+    char getCellValue(int layer, int row, int col) const;
+    char getCell(int cell) const;
+
+    bool isValidMove(int layer, int row, int col) const;
+    void applyMove(int layer, int row, int col, char symbol);   // checked, like Board
+
+    // Unchecked versions for search code (empty cell, 'X' or 'O')
+    void makeMove(int cell, char symbol);
+    void unmakeMove(int cell);
+
+    bool winCheck(char symbol) const;   // cached
+    bool tieCheck() const;
+    int getFilledCells() const;
+
+    std::uint64_t getMask(char symbol) const;
+    std::uint64_t getOccupiedMask() const {return xMask | oMask;}
+    std::uint64_t getEmptyMask() const {return ~(xMask | oMask);}
+
+    // === Bit tests on masks (shared by the board and the AI) ===
+
+    // Would adding `cell` to `own` complete a line? Checks only its lines.
+    static bool wouldWin(std::uint64_t own, int cell);
+
+    // True if `own` covers a whole line
+    static bool hasLine(std::uint64_t own);
+
+    // Empty cells where a player holding `own` completes a line (its threats)
+    static std::uint64_t winningCells(std::uint64_t own, std::uint64_t empty);
+
+    // Empty cells after which a player holding `own` has two or more threats
+    static std::uint64_t forkCells(std::uint64_t own, std::uint64_t empty);
+
+private:
+    std::uint64_t xMask;
+    std::uint64_t oMask;
+    std::uint8_t completedLines;   // bit 0: X has a line, bit 1: O has a line
+};
+
+#endif // FINALPROJECT_QUBICBOARD_H
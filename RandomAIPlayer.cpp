@@ -0,0 +1,11 @@
+#include "RandomAIPlayer.h"
+#include "Board.h"
+
+RandomAIPlayer::RandomAIPlayer(char symbol, std::uint64_t seed)
+    : AIPlayer(symbol, "Random AI") {
+    setSeed(seed);
+}
+
+void RandomAIPlayer::makeMove(Board& board) {
+    playRandomMove(board);
+}
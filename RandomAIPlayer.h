@@ -0,0 +1,23 @@
+#ifndef FINALPROJECT_RANDOMAIPLAYER_H
+#define FINALPROJECT_RANDOMAIPLAYER_H
+
+#include "AIPlayer.h"
+#include <cstdint>
+
+class Board;
+
+/**
+ * RandomAIPlayer plays a uniformly random valid move every turn.
+ * Used as a baseline opponent in tests and tournaments. Moves come from the
+ * player's own seeded generator, so a given seed always plays the same game.
+ */
+class RandomAIPlayer final : public AIPlayer {
+public:
+    explicit RandomAIPlayer(char symbol, std::uint64_t seed = Rng::defaultSeed());
+
+    using AIPlayer::makeMove;
+
+    void makeMove(Board& board) override;
+};
+
+#endif // FINALPROJECT_RANDOMAIPLAYER_H
@@ -7,7 +7,6 @@
 #include <iostream>
 #include <vector>
 #include <utility>
-#include <random>
 
 RegularAIPlayer::RegularAIPlayer(char symbol) : AIPlayer(symbol, "Regular AI") {}
 
@@ -12,6 +12,10 @@ class Board;
 class RegularAIPlayer final : public AIPlayer {
 public:
     explicit RegularAIPlayer(char symbol);
+
+    // m,n,k boards use the default AIPlayer strategy
+    using AIPlayer::makeMove;
+
     void makeMove(Board& board) override;
 };
 
@@ -0,0 +1,12 @@
+#include "Rng.h"
+#include <atomic>
+#include <random>
+
+std::uint64_t Rng::defaultSeed() {
+    static const std::uint64_t base =
+        (static_cast<std::uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+    static std::atomic<std::uint64_t> counter{0};
+
+    std::uint64_t x = base + counter.fetch_add(1, std::memory_order_relaxed);
+    return splitMix64(x);
+}
@@ -0,0 +1,65 @@
+#ifndef FINALPROJECT_RNG_H
+#define FINALPROJECT_RNG_H
+
+#include <cstdint>
+
+/**
+ * Rng is a small, fast, seedable pseudo-random generator (xoshiro256**).
+ *
+ * Every AI player owns one, so players never share generator state between
+ * threads and never make system calls to get randomness while playing. The
+ * same seed always gives the same sequence, which makes games replayable.
+ */
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed = defaultSeed()) {reseed(seed);}
+
+    void reseed(std::uint64_t seed) {
+        // Expand the 64-bit seed into the 256-bit state with SplitMix64
+        for (auto& word : state) {
+            word = splitMix64(seed);
+        }
+    }
+
+    std::uint64_t next() {
+        const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const std::uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+
+        return result;
+    }
+
+    // Uniform integer in [0, bound); bound must be positive.
+    // Uses the multiply-shift method, which is unbiased enough for game play
+    // and avoids a division.
+    int below(int bound) {
+        return static_cast<int>(((next() >> 32) * static_cast<std::uint64_t>(bound)) >> 32);
+    }
+
+    // Advances `x` and returns the next SplitMix64 output (also handy for
+    // deriving independent seeds from one base seed)
+    static std::uint64_t splitMix64(std::uint64_t& x) {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Different for every call; the OS is asked for entropy only once per process
+    static std::uint64_t defaultSeed();
+
+private:
+    std::uint64_t state[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+#endif // FINALPROJECT_RNG_H
@@ -0,0 +1,55 @@
+#include "SearchStats.h"
+#include <ostream>
+
+void SearchStats::reset() {
+    nodes = 0;
+    leafEvaluations = 0;
+    maxDepth = 0;
+    completedDepth = 0;
+    elapsed = std::chrono::nanoseconds(0);
+    tableProbes = 0;
+    tableHits = 0;
+    playouts = 0;
+    principalVariation.clear();
+}
+
+double SearchStats::nodesPerSecond() const {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    return (seconds > 0.0) ? static_cast<double>(nodes) / seconds : 0.0;
+}
+
+double SearchStats::playoutsPerSecond() const {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    return (seconds > 0.0) ? static_cast<double>(playouts) / seconds : 0.0;
+}
+
+std::ostream& operator<<(std::ostream& out, const SearchStats& stats) {
+    out << "nodes=" << stats.nodes
+        << " leaves=" << stats.leafEvaluations
+        << " depth=" << stats.maxDepth;
+
+    if (stats.completedDepth > 0) {
+        out << " completed=" << stats.completedDepth;
+    }
+
+    out << " time=" << std::chrono::duration_cast<std::chrono::microseconds>(stats.elapsed).count() << "us";
+
+    if (stats.playouts > 0) {
+        out << " playouts=" << stats.playouts
+            << " (" << static_cast<long long>(stats.playoutsPerSecond()) << "/s)";
+    }
+
+    if (stats.tableProbes > 0) {
+        out << " tt=" << stats.tableHits << "/" << stats.tableProbes;
+    }
+
+    if (!stats.principalVariation.empty()) {
+        out << " pv=";
+        for (std::size_t i = 0; i < stats.principalVariation.size(); ++i) {
+            if (i > 0) out << " ";
+            out << "(" << stats.principalVariation[i].first << ","
+                << stats.principalVariation[i].second << ")";
+        }
+    }
+    return out;
+}
@@ -0,0 +1,44 @@
+#ifndef FINALPROJECT_SEARCHSTATS_H
+#define FINALPROJECT_SEARCHSTATS_H
+
+#include <chrono>
+#include <iosfwd>
+#include <utility>
+#include <vector>
+
+/**
+ * SearchStats describes the work done by one AI move: how many positions
+ * were visited, how deep the search went, how long it took, how often the
+ * transposition table helped, and the line of play the search expects
+ * (the principal variation).
+ *
+ * Only searching players fill these in; the rule-based and table-lookup
+ * players leave them at zero.
+ */
+struct SearchStats {
+    long long nodes = 0;             // positions visited
+    long long leafEvaluations = 0;   // positions scored without searching further
+    int maxDepth = 0;                // deepest ply reached below the current position
+    int completedDepth = 0;          // iterative deepening: deepest iteration that finished
+    std::chrono::nanoseconds elapsed{0};
+    long long tableProbes = 0;
+    long long tableHits = 0;
+    long long playouts = 0;          // random games played to the end (Monte Carlo players)
+
+    // Expected line of play as (row, col) moves, starting with the move played.
+    // It stops early where the search took a score straight from the table.
+    std::vector<std::pair<int, int>> principalVariation;
+
+    // Clears everything but keeps the PV's capacity, so reuse doesn't allocate
+    void reset();
+
+    double nodesPerSecond() const;
+    double playoutsPerSecond() const;
+};
+
+// One-line summary, e.g. "nodes=697 leaves=310 depth=9 time=412us tt=85/160 pv=(1,1) (0,0)"
+// ("completed=N" follows the depth when the search was iterative, and
+// "playouts=N (R/s)" is added for Monte Carlo players)
+std::ostream& operator<<(std::ostream& out, const SearchStats& stats);
+
+#endif // FINALPROJECT_SEARCHSTATS_H
@@ -0,0 +1,155 @@
+#include "SolvedGame.h"
+#include "Board.h"
+#include <array>
+#include <bit>
+
+namespace {
+    constexpr int POSITIONS = 19683;   // 3^9
+
+    // Packed entry: score + 16 (5 bits) | value + 1 (2) | reachable (1) | terminal (1)
+    //             | optimal moves (9) | best moves (9)
+    using Packed = std::uint32_t;
+
+    constexpr int POW3[9] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+
+    // BASE3[mask] = sum of 3^i over the set bits of a 9-bit mask
+    constexpr auto BASE3 = [] {
+        std::array<int, 512> table{};
+        for (int mask = 0; mask < 512; ++mask) {
+            for (int cell = 0; cell < 9; ++cell) {
+                if (mask & (1 << cell)) {
+                    table[mask] += POW3[cell];
+                }
+            }
+        }
+        return table;
+    }();
+
+    constexpr bool hasLine(int mask) {
+        return Board::hasLine(static_cast<std::uint16_t>(mask));
+    }
+
+    constexpr void decode(int index, int& x, int& o) {
+        x = 0;
+        o = 0;
+        for (int cell = 0; cell < 9; ++cell) {
+            int digit = index % 3;
+            index /= 3;
+            if (digit == 1) x |= 1 << cell;
+            if (digit == 2) o |= 1 << cell;
+        }
+    }
+
+    constexpr Packed pack(int score, int value, bool reachable, bool terminal,
+                          int optimal, int best) {
+        return static_cast<Packed>(score + 16)
+             | (static_cast<Packed>(value + 1) << 5)
+             | (static_cast<Packed>(reachable) << 7)
+             | (static_cast<Packed>(terminal) << 8)
+             | (static_cast<Packed>(optimal) << 9)
+             | (static_cast<Packed>(best) << 18);
+    }
+
+    constexpr int scoreOf(Packed p) {return static_cast<int>(p & 0x1F) - 16;}
+    constexpr int valueOf(Packed p) {return static_cast<int>((p >> 5) & 0x3) - 1;}
+    constexpr bool reachableOf(Packed p) {return (p >> 7) & 0x1;}
+
+    // Solves every position. Adding a piece always increases the base-3 index,
+    // so walking indices upward finds every reachable position, and walking
+    // downward sees each child before its parent.
+    constexpr auto build() {
+        std::array<bool, POSITIONS> reachable{};
+        reachable[0] = true;
+
+        for (int index = 0; index < POSITIONS; ++index) {
+            if (!reachable[index]) continue;
+
+            int x = 0, o = 0;
+            decode(index, x, o);
+            int filled = std::popcount(static_cast<unsigned>(x | o));
+            if (hasLine(x) || hasLine(o) || filled == 9) continue;
+
+            int moverDigit = (filled % 2 == 0) ? 1 : 2;
+            for (int cell = 0; cell < 9; ++cell) {
+                if (!((x | o) & (1 << cell))) {
+                    reachable[index + moverDigit * POW3[cell]] = true;
+                }
+            }
+        }
+
+        std::array<Packed, POSITIONS> table{};
+        for (int index = POSITIONS - 1; index >= 0; --index) {
+            if (!reachable[index]) continue;
+
+            int x = 0, o = 0;
+            decode(index, x, o);
+            int filled = std::popcount(static_cast<unsigned>(x | o));
+
+            // The side that just moved is the only one who can have a line
+            if (hasLine(x) || hasLine(o)) {
+                table[index] = pack(-10 + filled, -1, true, true, 0, 0);
+                continue;
+            }
+            if (filled == 9) {
+                table[index] = pack(0, 0, true, true, 0, 0);
+                continue;
+            }
+
+            int moverDigit = (filled % 2 == 0) ? 1 : 2;
+            int bestScore = -100;
+            int bestValue = -2;
+            int childScores[9] = {};
+            int childValues[9] = {};
+
+            for (int cell = 0; cell < 9; ++cell) {
+                if ((x | o) & (1 << cell)) continue;
+                Packed child = table[index + moverDigit * POW3[cell]];
+                childScores[cell] = -scoreOf(child);
+                childValues[cell] = -valueOf(child);
+                if (childScores[cell] > bestScore) bestScore = childScores[cell];
+                if (childValues[cell] > bestValue) bestValue = childValues[cell];
+            }
+
+            int optimal = 0;
+            int best = 0;
+            for (int cell = 0; cell < 9; ++cell) {
+                if ((x | o) & (1 << cell)) continue;
+                if (childValues[cell] == bestValue) optimal |= 1 << cell;
+                if (childScores[cell] == bestScore) best |= 1 << cell;
+            }
+            table[index] = pack(bestScore, bestValue, true, false, optimal, best);
+        }
+        return table;
+    }
+
+    constexpr auto TABLE = build();
+
+    constexpr int countReachable() {
+        int count = 0;
+        for (Packed p : TABLE) {
+            if (reachableOf(p)) ++count;
+        }
+        return count;
+    }
+
+    static_assert(countReachable() == SolvedGame::REACHABLE_POSITIONS,
+                  "TicTacToe has 5478 reachable positions");
+    static_assert(valueOf(TABLE[0]) == 0, "Perfect play from the empty board is a draw");
+}
+
+SolvedGame::Entry SolvedGame::lookup(const Board& board) {
+    const Packed p = TABLE[indexOf(board)];
+
+    Entry entry;
+    entry.reachable = reachableOf(p);
+    entry.terminal = (p >> 8) & 0x1;
+    entry.value = static_cast<Value>(valueOf(p));
+    entry.score = scoreOf(p);
+    entry.optimalMoves = static_cast<std::uint16_t>((p >> 9) & 0x1FF);
+    entry.bestMoves = static_cast<std::uint16_t>((p >> 18) & 0x1FF);
+    return entry;
+}
+
+int SolvedGame::indexOf(const Board& board) {
+    return BASE3[board.getMask('X')] + 2 * BASE3[board.getMask('O')];
+}
@@ -0,0 +1,45 @@
+#ifndef FINALPROJECT_SOLVEDGAME_H
+#define FINALPROJECT_SOLVEDGAME_H
+
+#include <cstdint>
+
+class Board;
+
+/**
+ * SolvedGame is a perfect-play oracle for 3x3 TicTacToe.
+ *
+ * Every board is indexed by its base-3 encoding (3^9 = 19683 slots), and the
+ * game-theoretic value of every reachable position is computed at compile
+ * time, so answering a query is a single table lookup with no search.
+ *
+ * Values and scores are from the point of view of the side to move. Scores
+ * use the same scale as MiniMaxAIPlayer (a win at n filled cells is worth
+ * 10 - n), so `bestMoves` is exactly the set of moves minimax prefers.
+ */
+class SolvedGame {
+public:
+    enum class Value : std::int8_t {
+        Loss = -1,
+        Draw = 0,
+        Win  = 1
+    };
+
+    struct Entry {
+        bool reachable = false;          // false for boards no legal game produces
+        bool terminal = false;           // somebody has won, or the board is full
+        Value value = Value::Draw;
+        int score = 0;
+        std::uint16_t optimalMoves = 0;  // cells (row * 3 + col) that keep `value`
+        std::uint16_t bestMoves = 0;     // cells that reach the best minimax score
+    };
+
+    // Number of reachable positions, including the empty board and finished games
+    static constexpr int REACHABLE_POSITIONS = 5478;
+
+    static Entry lookup(const Board& board);
+
+    // Base-3 index of a board: cell i contributes 3^i for X and 2 * 3^i for O
+    static int indexOf(const Board& board);
+};
+
+#endif // FINALPROJECT_SOLVEDGAME_H
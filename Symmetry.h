@@ -0,0 +1,41 @@
+#ifndef FINALPROJECT_SYMMETRY_H
+#define FINALPROJECT_SYMMETRY_H
+
+/**
+ * Symmetry maps cells of a rows x cols board (cell row * cols + col) to
+ * their images under the board's rotations and reflections, the same
+ * numbering everywhere:
+ *
+ *   0 identity        1 rotate 180      2 mirror left-right   3 mirror top-bottom
+ *   4 rotate 90       5 rotate 270      6 main diagonal       7 anti-diagonal
+ *
+ * The first four keep any rectangle; the last four swap rows and columns,
+ * so they only exist on square boards. Tables that share entries between
+ * symmetric positions (TranspositionTable, PositionDatabase,
+ * ProofNumberSolver, OpeningBook) build their per-symmetry maps from here.
+ */
+struct Symmetry {
+    static constexpr int MAX_COUNT = 8;
+
+    // Symmetries of a rows x cols board: 8 if it is square, 4 otherwise
+    static constexpr int count(int rows, int cols) {return (rows == cols) ? 8 : 4;}
+
+    // Where `cell` lands under symmetry `sym` (which must be below count())
+    static constexpr int mapCell(int sym, int rows, int cols, int cell) {
+        const int r = cell / cols;
+        const int c = cell % cols;
+        const int n = rows;
+        switch (sym) {
+            case 0: return r * cols + c;                                  // identity
+            case 1: return (rows - 1 - r) * cols + (cols - 1 - c);        // rotate 180
+            case 2: return r * cols + (cols - 1 - c);                     // mirror left-right
+            case 3: return (rows - 1 - r) * cols + c;                     // mirror top-bottom
+            case 4: return c * n + (n - 1 - r);                           // rotate 90
+            case 5: return (n - 1 - c) * n + r;                           // rotate 270
+            case 6: return c * n + r;                                     // main diagonal
+            default: return (n - 1 - c) * n + (n - 1 - r);                // anti-diagonal
+        }
+    }
+};
+
+#endif // FINALPROJECT_SYMMETRY_H
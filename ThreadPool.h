@@ -0,0 +1,45 @@
+#ifndef FINALPROJECT_THREADPOOL_H
+#define FINALPROJECT_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * ThreadPool runs submitted jobs on a fixed set of worker threads.
+ *
+ * Jobs are taken from a single FIFO queue. waitIdle() blocks until the queue
+ * is empty and every worker has finished its current job; the destructor
+ * waits for outstanding jobs and joins the workers.
+ */
+class ThreadPool {
+public:
+    // 0 threads means one per hardware thread
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> job);
+    void waitIdle();
+
+    std::size_t size() const {return workers.size();}
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable idle;
+    std::size_t activeJobs = 0;
+    bool stopping = false;
+
+    void workerLoop();
+};
+
+#endif // FINALPROJECT_THREADPOOL_H
@@ -3,11 +3,17 @@
 //
 
 #include "TicTacToe.h"
+#include "TranspositionTable.h"
+#include "Rng.h"
+#include <bit>
 #include <iostream>
 #include <limits>
+#include <type_traits>
 
-// Constructor
-TicTacToe::TicTacToe() : board(), player1(nullptr), player2(nullptr), currentPlayer(nullptr) {}
+// Constructor: both seats start out human until choosePlayers() or setPlayers()
+TicTacToe::TicTacToe() : board(),
+                         seats{HumanPlayer('X', "Player 1 (Human)"), HumanPlayer('O', "Player 2 (Human)")},
+                         currentSeat(0), logSearchStats(false), quiet(false) {}
 // Can add additional constructors to allow stuff like custom symbols
 
 // Main program loop: show menu, play games, or quit
@@ -31,7 +37,6 @@ void TicTacToe::run() {
         if (choice == 1) {
             choosePlayers();
             playSingleGame();
-            cleanupPlayers();   // delete players between games
         } else if (choice == 2) {
             std::cout << "Exiting TicTacToe. Goodbye!\n";
             running = false;
@@ -53,9 +58,6 @@ void TicTacToe::showMainMenu() const {
 // Now supports Human, Regular AI, and Unbeatable AI.
 // Minimax AI (4) is still not implemented.
 void TicTacToe::choosePlayers() {
-    // Just in case we are replaying a game
-    cleanupPlayers();
-
     int type1 = 0;
     int type2 = 0;
 
@@ -66,6 +68,8 @@ void TicTacToe::choosePlayers() {
                   << "  2. Regular AI\n"
                   << "  3. Unbeatable AI\n"
                   << "  4. Minimax AI\n"
+                  << "  5. Perfect AI (solved table)\n"
+                  << "  6. MCTS AI (Monte Carlo tree search)\n"
                   << "Choice: ";
 
         std::cin >> type1;
@@ -74,12 +78,12 @@ void TicTacToe::choosePlayers() {
             // handle inputs like 'a'
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "Invalid input. Please enter a number 1-4.\n";
+            std::cout << "Invalid input. Please enter a number 1-6.\n";
             continue;
         }
 
-        if (type1 >= 1 && type1 <= 4) {break;} // valid choice
-        else {std::cout << "Invalid type. Please choose 1-4.\n";}
+        if (type1 >= 1 && type1 <= 6) {break;} // valid choice
+        else {std::cout << "Invalid type. Please choose 1-6.\n";}
     }
 
     // --- Player 2 (O) ---
@@ -89,6 +93,8 @@ void TicTacToe::choosePlayers() {
                   << "  2. Regular AI\n"
                   << "  3. Unbeatable AI\n"
                   << "  4. Minimax AI\n"
+                  << "  5. Perfect AI (solved table)\n"
+                  << "  6. MCTS AI (Monte Carlo tree search)\n"
                   << "Choice: ";
 
         std::cin >> type2;
@@ -97,41 +103,92 @@ void TicTacToe::choosePlayers() {
             // handle inputs like 'a'
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "Invalid input. Please enter a number 1-4.\n";
+            std::cout << "Invalid input. Please enter a number 1-6.\n";
             continue;
         }
 
-        if (type2 >= 1 && type2 <= 4) {break;} // valid choice
-        else {std::cout << "Invalid type. Please choose 1-4.\n";}
+        if (type2 >= 1 && type2 <= 6) {break;} // valid choice
+        else {std::cout << "Invalid type. Please choose 1-6.\n";}
     }
 
-    // Now actually create the players
-    player1 = createPlayer(type1, 'X');
-    player2 = createPlayer(type2, 'O');
-    currentPlayer = player1;
+    // Now actually seat the players (reusing last game's where the type is unchanged)
+    setPlayers(type1, type2);
 
     std::cout << "\nPlayers set up. Let the game begin!\n\n";
 }
 
 
+// Seats players of the given types without going through the menu
+void TicTacToe::setPlayers(int type1, int type2) {
+    seatPlayer(0, type1);
+    seatPlayer(1, type2);
+    currentSeat = 0;
+}
+
+void TicTacToe::setRecorder(GameRecordWriter* writer, std::uint64_t seed) {
+    recordBuffer.reset();   // flushes the old buffer
+    if (writer != nullptr) {
+        recordBuffer = std::make_unique<GameRecordWriter::Buffer>(*writer);
+    }
+    recordSeed = seed;
+}
+
+const Player& TicTacToe::getPlayer(int seat) const {
+    return std::visit([](const auto& player) -> const Player& {return player;}, seats[seat]);
+}
+
 // Runs one full game until win or tie
-void TicTacToe::playSingleGame() {
+char TicTacToe::playSingleGame() {
     resetBoard();
-    currentPlayer = player1;
     char winner = '\0';
 
+    GameRecord record;
+    if (recordBuffer) {
+        // Seat types are in menu order, which is also PlayerKind's order from Human on
+        record.seed = Rng::splitMix64(recordSeed);
+        record.setPlayers(static_cast<GameRecord::PlayerKind>(seats[0].index() + 1),
+                          static_cast<GameRecord::PlayerKind>(seats[1].index() + 1));
+        for (int seat = 0; seat < 2; ++seat) {
+            std::visit([&](auto& player) {
+                using T = std::decay_t<decltype(player)>;
+                if constexpr (std::is_base_of_v<AIPlayer, T>) {
+                    player.setSeed(GameRecord::playerSeed(record.seed, seat));
+                }
+            }, seats[seat]);
+        }
+    }
+
     bool gameOver = false;
 
     while (!gameOver) {
-        board.display();
-
-        std::cout << currentPlayer->getName()
-                  << " (" << currentPlayer->getSymbol()
-                  << ") - it's your move.\n";
-
-        currentPlayer->makeMove(board);
-
-        char symbol = currentPlayer->getSymbol();
+        const std::uint16_t before = board.getOccupiedMask();
+        char symbol = std::visit([this](auto& player) {
+            using T = std::decay_t<decltype(player)>;
+
+            if (!quiet) {
+                board.display();
+                std::cout << player.getName()
+                          << " (" << player.getSymbol()
+                          << ") - it's your move.\n";
+            }
+
+            // The seat knows its exact type, so call it directly instead of through the vtable
+            player.T::makeMove(board);
+
+            if constexpr (std::is_base_of_v<AIPlayer, T>) {
+                if (logSearchStats && !quiet) {
+                    std::cout << "[stats] " << player.getLastSearchStats() << "\n";
+                }
+            }
+            return player.getSymbol();
+        }, seats[currentSeat]);
+
+        if (recordBuffer) {
+            const auto placed = static_cast<std::uint16_t>(board.getOccupiedMask() & ~before);
+            if (placed != 0) {
+                record.addMove(std::countr_zero(placed));
+            }
+        }
 
         if (board.winCheck(symbol)) {
             winner = symbol;
@@ -143,75 +200,88 @@ void TicTacToe::playSingleGame() {
         }
     }
 
+    if (recordBuffer) {
+        record.setResult(winner == '\0' ? 'T' : winner);
+        recordBuffer->append(record);
+    }
+
     // Show final board and announce result
-    board.display();
-    announceResult(winner);
+    if (!quiet) {
+        board.display();
+        announceResult(winner);
+    }
+    return winner == '\0' ? 'T' : winner;
 }
 
-// Creates a player of a chosen type (1 = Human, 2 = Regular AI, 3 = Unbeatable, 4 = Minimax)
-// For now, Minimax is not supported; we default to Human in that case.
-Player* TicTacToe::createPlayer(int type, char symbol) {
-    std::string baseName = (symbol == 'X') ? "Player 1" : "Player 2";
+// Puts a player of a chosen type (1 = Human, 2 = Regular AI, 3 = Unbeatable, 4 = Minimax, 5 = Perfect, 6 = MCTS)
+// in a seat. A player of the same type is already there from the last game, so it is kept as is.
+void TicTacToe::seatPlayer(int seat, int type) {
+    SeatedPlayer& slot = seats[seat];
+    char symbol = (seat == 0) ? 'X' : 'O';
+
+    if (type < 1 || type > static_cast<int>(std::variant_size_v<SeatedPlayer>)) {
+        // Should not happen with our validation, but just in case:
+        std::cout << "Invalid or unsupported player type. Defaulting to Human.\n";
+        type = 1;
+    }
+    if (static_cast<int>(slot.index()) + 1 == type) {
+        return;
+    }
 
     switch (type) {
         case 1:
             // Human player
-            return new HumanPlayer(symbol, baseName + " (Human)");
+            slot.emplace<HumanPlayer>(symbol, (seat == 0) ? "Player 1 (Human)" : "Player 2 (Human)");
+            break;
 
         case 2:
             // Regular AI
-            return new RegularAIPlayer(symbol);
+            slot.emplace<RegularAIPlayer>(symbol);
+            break;
 
         case 3:
             // Unbeatable AI
-            return new UnbeatableAIPlayer(symbol);
+            slot.emplace<UnbeatableAIPlayer>(symbol);
+            break;
+
+        case 4: {
+            // Minimax players share one table, so later games reuse earlier searches
+            MiniMaxAIPlayer::SearchOptions options;
+            options.table = &TranspositionTable::shared();
+            slot.emplace<MiniMaxAIPlayer>(symbol, options);
+            break;
+        }
 
-        case 4:
-            return new MiniMaxAIPlayer(symbol);
+        case 5:
+            // Perfect AI: one lookup in the compile-time solved table
+            slot.emplace<PerfectPlayer>(symbol);
+            break;
 
         default:
-            // Should not happen with our validation, but just in case:
-            std::cout << "Invalid or unsupported player type. Defaulting to Human.\n";
-            return new HumanPlayer(symbol, baseName + " (Human)");
+            // MCTS AI: random playouts guided by UCT
+            slot.emplace<MCTSAIPlayer>(symbol);
+            break;
     }
 }
 
 // Clears the board and resets game state
 void TicTacToe::resetBoard() {
-    board = Board(); // Rely on Board's constructor to clear grid & filledCells
-    currentPlayer = player1;
+    board = Board(); // Rely on Board's constructor to clear both occupancy masks
+    currentSeat = 0;
 }
 
-// Switches current player between player1 and player2
+// Switches current player between player 1 and player 2
 void TicTacToe::switchPlayer() {
-    if (currentPlayer == player1) {
-        currentPlayer = player2;
-    } else {
-        currentPlayer = player1;
-    }
+    currentSeat = 1 - currentSeat;
 }
 
 // Announces winner or tie
 void TicTacToe::announceResult(char winner) const {
     if (winner == 'X' || winner == 'O') {
-        const Player* winnerPtr =
-            (winner == player1->getSymbol()) ? player1 : player2;
-        std::cout << winnerPtr->getName()
+        const Player& winnerRef = getPlayer(winner == 'X' ? 0 : 1);
+        std::cout << winnerRef.getName()
                   << " (" << winner << ") wins!\n";
     } else {
         std::cout << "It's a tie!\n";
     }
-}
-
-// Deletes player1 and player2 (used between games or when quitting)
-void TicTacToe::cleanupPlayers() {
-    if (player1 != nullptr) {
-        delete player1;
-        player1 = nullptr;
-    }
-    if (player2 != nullptr) {
-        delete player2;
-        player2 = nullptr;
-    }
-    currentPlayer = nullptr;
 }
\ No newline at end of file
@@ -1,23 +1,38 @@
 #ifndef FINALPROJECT_TICTACTOE_H
 #define FINALPROJECT_TICTACTOE_H
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <variant>
 
 #include "Board.h"
+#include "GameRecord.h"
 #include "Player.h"
 #include "HumanPlayer.h"
 #include "RegularAIPlayer.h"
 #include "UnbeatableAIPlayer.h"
 #include "MiniMaxAIPlayer.h"
+#include "PerfectPlayer.h"
+#include "MCTSAIPlayer.h"
 
 /**
  * TicTacToe class coordinates the entire TicTacToe program.
  *
  * Responsibilities:
  *  - Display a menu and allow players to choose their player types
- *  - Create player1 and player2 (Human, Regular AI, Unbeatable AI, Minimax AI)
+ *  - Seat player 1 and player 2 (Human, Regular AI, Unbeatable AI, Minimax AI, Perfect AI, MCTS AI)
  *  - Run a full TicTacToe game (turn switching, board display, win/tie detection)
  *  - Allow the user to replay games without restarting the program
+ *
+ * Players are held by value in a std::variant, one per seat, and stay seated
+ * between games: choosing the same type again reuses the player, and moves
+ * are dispatched with std::visit rather than a virtual call. Once warmed up,
+ * replaying games allocates nothing.
+ *
+ * With a recorder set, every game is also kept as a GameRecord: the AI seats
+ * are reseeded before each game from a per-game seed, which goes into the
+ * record with the players and the moves.
  */
 class TicTacToe {
 public:
@@ -26,42 +41,64 @@ public:
     // Starts the whole program: menu, chooses players, and plays games
     void run();
 
+    // When enabled, every AI move is followed by its search statistics
+    void setSearchStatsLogging(bool enabled) {logSearchStats = enabled;}
+
+    // When enabled, games print nothing (for tests and benchmarks)
+    void setQuiet(bool enabled) {quiet = enabled;}
+
+    // Seats players of the given types (1 = Human ... 6 = MCTS, as in the menu)
+    // without asking. A seat that already holds that type keeps its player.
+    void setPlayers(int type1, int type2);
+
+    // Appends every following game to `writer` (nullptr stops recording and
+    // flushes what was buffered). Game seeds are drawn from `seed`.
+    void setRecorder(GameRecordWriter* writer, std::uint64_t seed = 1);
+
+    // Runs one full game with the seated players; returns 'X', 'O' or 'T'
+    char playSingleGame();
+
+    const Player& getPlayer(int seat) const;   // 0 = X, 1 = O
+
 private:
+    // One alternative per menu type, in menu order (index = type - 1)
+    using SeatedPlayer = std::variant<HumanPlayer, RegularAIPlayer, UnbeatableAIPlayer,
+                                      MiniMaxAIPlayer, PerfectPlayer, MCTSAIPlayer>;
+
     Board board;
 
-    Player* player1;   // Always uses symbol 'X'
-    Player* player2;   // Always uses symbol 'O'
-    Player* currentPlayer;   // Whose turn it is
+    SeatedPlayer seats[2];   // seat 0 always uses symbol 'X', seat 1 'O'
+    int currentSeat;         // Whose turn it is
+    bool logSearchStats;
+    bool quiet;
+
+    std::unique_ptr<GameRecordWriter::Buffer> recordBuffer;   // set while recording
+    std::uint64_t recordSeed = 0;                              // next game's seed comes from here
 
     // === Main Flow ===
 
     // Prints the main menu (Play or Quit)
     void showMainMenu() const;
 
-    // Allows user to choose types for player1 and player2
+    // Allows user to choose types for player 1 and player 2
     void choosePlayers();
 
-    // Runs one full game until win or tie
-    void playSingleGame();
-
     // === Player Creation ===
 
-    // Creates a player of a chosen type (1 = Human, 2 = Regular AI, 3 = Unbeatable, 4 = Minimax)
-    Player* createPlayer(int type, char symbol);
+    // Puts a player of a chosen type (1 = Human, 2 = Regular AI, 3 = Unbeatable, 4 = Minimax,
+    // 5 = Perfect, 6 = MCTS) in a seat, unless one is already sitting there
+    void seatPlayer(int seat, int type);
 
     // === Helpers ===
 
     // Clears the board and resets game state
     void resetBoard();
 
-    // Switches current player between player1 and player2
+    // Switches current player between player 1 and player 2
     void switchPlayer();
 
     // Announces winner or tie
     void announceResult(char winner) const;
-
-    // Deletes player1 and player2 (used between games or when quitting)
-    void cleanupPlayers();
 };
 
 #endif // FINALPROJECT_TICTACTOE_H
\ No newline at end of file
@@ -0,0 +1,261 @@
+#include "Tournament.h"
+#include "AIPlayer.h"
+#include "Board.h"
+#include "BoardBatch.h"
+#include "GameRecord.h"
+#include "MiniMaxAIPlayer.h"
+#include "PerfectPlayer.h"
+#include "RandomAIPlayer.h"
+#include "RegularAIPlayer.h"
+#include "Rng.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include "UnbeatableAIPlayer.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+
+namespace {
+    // Turns (seed, pairing, chunk) into well-spread per-chunk seeds
+    std::uint64_t mixSeed(std::uint64_t x) {
+        return Rng::splitMix64(x);
+    }
+
+    GameRecord::PlayerKind recordKind(Tournament::PlayerType type) {
+        switch (type) {
+            case Tournament::PlayerType::Regular:    return GameRecord::PlayerKind::Regular;
+            case Tournament::PlayerType::Unbeatable: return GameRecord::PlayerKind::Unbeatable;
+            case Tournament::PlayerType::MiniMax:    return GameRecord::PlayerKind::MiniMax;
+            case Tournament::PlayerType::Perfect:    return GameRecord::PlayerKind::Perfect;
+            case Tournament::PlayerType::Random:     return GameRecord::PlayerKind::Random;
+        }
+        return GameRecord::PlayerKind::Unknown;
+    }
+}
+
+Tournament::Tournament(const Config& config)
+    : config(config), results(PLAYER_TYPE_COUNT * PLAYER_TYPE_COUNT) {
+    // A chunk of 0 (or less) games would never advance through the pairing
+    this->config.chunkSize = std::max(1, config.chunkSize);
+}
+
+void Tournament::run() {
+    results.assign(PLAYER_TYPE_COUNT * PLAYER_TYPE_COUNT, PairingResult());
+    std::mutex resultsMutex;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(config.threads);
+
+        for (int pairing = 0; pairing < PLAYER_TYPE_COUNT * PLAYER_TYPE_COUNT; ++pairing) {
+            for (int first = 0, chunk = 0; first < config.gamesPerPairing;
+                 first += config.chunkSize, ++chunk) {
+                int games = std::min(config.chunkSize, config.gamesPerPairing - first);
+
+                pool.submit([this, pairing, chunk, games, &resultsMutex] {
+                    PairingResult local;
+                    playChunk(pairing, chunk, games, local);
+
+                    std::lock_guard<std::mutex> lock(resultsMutex);
+                    results[pairing].xWins += local.xWins;
+                    results[pairing].oWins += local.oWins;
+                    results[pairing].draws += local.draws;
+                });
+            }
+        }
+        pool.waitIdle();
+    }
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+const Tournament::PairingResult& Tournament::result(PlayerType x, PlayerType o) const {
+    return results[static_cast<int>(x) * PLAYER_TYPE_COUNT + static_cast<int>(o)];
+}
+
+long long Tournament::totalGames() const {
+    long long total = 0;
+    for (const auto& r : results) {
+        total += r.games();
+    }
+    return total;
+}
+
+double Tournament::gamesPerSecond() const {
+    return (elapsed > 0.0) ? static_cast<double>(totalGames()) / elapsed : 0.0;
+}
+
+void Tournament::printMatrix(std::ostream& out) const {
+    const int width = 18;
+
+    out << "W/L/D for X (rows) against O (columns)\n";
+    out << std::setw(12) << "X \\ O";
+    for (int o = 0; o < PLAYER_TYPE_COUNT; ++o) {
+        out << std::setw(width) << typeName(static_cast<PlayerType>(o));
+    }
+    out << "\n";
+
+    for (int x = 0; x < PLAYER_TYPE_COUNT; ++x) {
+        out << std::setw(12) << typeName(static_cast<PlayerType>(x));
+        for (int o = 0; o < PLAYER_TYPE_COUNT; ++o) {
+            const PairingResult& r = results[x * PLAYER_TYPE_COUNT + o];
+            std::ostringstream cell;
+            cell << r.xWins << "/" << r.oWins << "/" << r.draws;
+            out << std::setw(width) << cell.str();
+        }
+        out << "\n";
+    }
+
+    out << "\n" << totalGames() << " games in " << std::fixed << std::setprecision(3)
+        << elapsed << " s (" << std::setprecision(0) << gamesPerSecond()
+        << " games/s)\n";
+    out.unsetf(std::ios::fixed);
+}
+
+const char* Tournament::typeName(PlayerType type) {
+    switch (type) {
+        case PlayerType::Regular:    return "Regular";
+        case PlayerType::Unbeatable: return "Unbeatable";
+        case PlayerType::MiniMax:    return "MiniMax";
+        case PlayerType::Perfect:    return "Perfect";
+        case PlayerType::Random:     return "Random";
+    }
+    return "?";
+}
+
+std::unique_ptr<Player> Tournament::createPlayer(PlayerType type, char symbol, std::uint64_t seed) {
+    std::unique_ptr<AIPlayer> player;
+
+    switch (type) {
+        case PlayerType::Regular:
+            player = std::make_unique<RegularAIPlayer>(symbol);
+            break;
+        case PlayerType::Unbeatable:
+            player = std::make_unique<UnbeatableAIPlayer>(symbol);
+            break;
+        case PlayerType::MiniMax: {
+            // The shared table is lock-free, so every thread can use it
+            MiniMaxAIPlayer::SearchOptions options;
+            options.table = &TranspositionTable::shared();
+            player = std::make_unique<MiniMaxAIPlayer>(symbol, options);
+            break;
+        }
+        case PlayerType::Perfect:
+            player = std::make_unique<PerfectPlayer>(symbol);
+            break;
+        case PlayerType::Random:
+            player = std::make_unique<RandomAIPlayer>(symbol);
+            break;
+    }
+
+    // Every player's random choices come from the tournament seed
+    if (player) {
+        player->setSeed(seed);
+    }
+    return player;
+}
+
+char Tournament::playGame(Player& xPlayer, Player& oPlayer, GameRecord* outRecord) {
+    Board board;
+    Player* current = &xPlayer;
+
+    while (true) {
+        const std::uint16_t before = board.getOccupiedMask();
+        current->makeMove(board);
+        if (outRecord != nullptr) {
+            // Players only report moves through the board: find the new piece
+            const auto placed = static_cast<std::uint16_t>(board.getOccupiedMask() & ~before);
+            if (placed != 0) {
+                outRecord->addMove(std::countr_zero(placed));
+            }
+        }
+
+        char symbol = current->getSymbol();
+        char winner = ' ';
+        if (board.winCheck(symbol)) {
+            winner = symbol;
+        } else if (board.tieCheck()) {
+            winner = 'T';
+        }
+        if (winner != ' ') {
+            if (outRecord != nullptr) {
+                outRecord->setResult(winner);
+            }
+            return winner;
+        }
+        current = (current == &xPlayer) ? &oPlayer : &xPlayer;
+    }
+}
+
+void Tournament::playChunk(int pairing, int chunk, int games, PairingResult& out) const {
+    auto xType = static_cast<PlayerType>(pairing / PLAYER_TYPE_COUNT);
+    auto oType = static_cast<PlayerType>(pairing % PLAYER_TYPE_COUNT);
+
+    std::uint64_t chunkSeed = mixSeed(mixSeed(config.seed ^ static_cast<std::uint64_t>(pairing))
+                                      + static_cast<std::uint64_t>(chunk));
+
+    // Two random players make no decisions of their own: play the whole chunk
+    // in lockstep on a BoardBatch, with batched win/tie checks
+    if (xType == PlayerType::Random && oType == PlayerType::Random) {
+        BoardBatch batch(static_cast<std::size_t>(games));
+        Rng rng(mixSeed(chunkSeed));
+        if (config.recorder == nullptr) {
+            const BoardBatch::Totals totals = batch.playRandomGames(rng);
+            out.xWins += totals.xWins;
+            out.oWins += totals.oWins;
+            out.draws += totals.draws;
+            return;
+        }
+
+        std::vector<char> winners(static_cast<std::size_t>(games));
+        std::vector<std::uint8_t> moves(static_cast<std::size_t>(games) * 9);
+        const BoardBatch::Totals totals = batch.playRandomGames(rng, winners.data(), moves.data());
+        out.xWins += totals.xWins;
+        out.oWins += totals.oWins;
+        out.draws += totals.draws;
+
+        GameRecordWriter::Buffer buffer(*config.recorder, static_cast<std::size_t>(games));
+        for (int i = 0; i < games; ++i) {
+            GameRecord game;
+            game.seed = chunkSeed;
+            game.setPlayers(GameRecord::PlayerKind::Random, GameRecord::PlayerKind::Random);
+            for (int n = 0; n < 9 && moves[i * 9 + n] != 0xFF; ++n) {
+                game.addMove(moves[i * 9 + n]);
+            }
+            game.setResult(winners[i]);
+            buffer.append(game);
+        }
+        return;
+    }
+
+    auto xPlayer = createPlayer(xType, 'X', mixSeed(chunkSeed));
+    auto oPlayer = createPlayer(oType, 'O', mixSeed(chunkSeed + 1));
+
+    if (config.recorder != nullptr) {
+        // One block per chunk: a single write() once the chunk is done
+        GameRecordWriter::Buffer buffer(*config.recorder, static_cast<std::size_t>(games));
+        GameRecord record;
+        record.seed = chunkSeed;
+        record.setPlayers(recordKind(xType), recordKind(oType));
+
+        for (int i = 0; i < games; ++i) {
+            GameRecord game = record;
+            char winner = playGame(*xPlayer, *oPlayer, &game);
+            buffer.append(game);
+            if (winner == 'X') out.xWins++;
+            else if (winner == 'O') out.oWins++;
+            else out.draws++;
+        }
+        return;
+    }
+
+    for (int i = 0; i < games; ++i) {
+        char winner = playGame(*xPlayer, *oPlayer);
+        if (winner == 'X') out.xWins++;
+        else if (winner == 'O') out.oWins++;
+        else out.draws++;
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef FINALPROJECT_TOURNAMENT_H
+#define FINALPROJECT_TOURNAMENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+class GameRecordWriter;
+class Player;
+struct GameRecord;
+
+/**
+ * Tournament plays every pairing of AI player types against each other
+ * without any console I/O, spreading the games over a thread pool.
+ *
+ * Games are split into fixed-size chunks. Each chunk creates its own players,
+ * seeded from the tournament seed, the pairing and the chunk number, so no
+ * state is shared between threads and a seeded run gives exactly the same
+ * results whatever the thread count.
+ *
+ * With Config::recorder set, every game is also appended to a game-record
+ * file; each chunk collects its records in its own GameRecordWriter::Buffer.
+ */
+class Tournament {
+public:
+    enum class PlayerType {
+        Regular,
+        Unbeatable,
+        MiniMax,
+        Perfect,
+        Random
+    };
+    static constexpr int PLAYER_TYPE_COUNT = 5;
+
+    struct Config {
+        int gamesPerPairing = 1000;
+        std::size_t threads = 0;    // 0 = one per hardware thread
+        std::uint64_t seed = 1;
+        int chunkSize = 250;        // games per job (at least 1)
+        GameRecordWriter* recorder = nullptr;   // records every game if set (not owned)
+    };
+
+    // Results from X's point of view
+    struct PairingResult {
+        long long xWins = 0;
+        long long oWins = 0;
+        long long draws = 0;
+        long long games() const {return xWins + oWins + draws;}
+    };
+
+    explicit Tournament(const Config& config);
+
+    void run();
+
+    const PairingResult& result(PlayerType x, PlayerType o) const;
+    long long totalGames() const;
+    double elapsedSeconds() const {return elapsed;}
+    double gamesPerSecond() const;
+
+    // W/L/D matrix: rows are the X player, columns the O player
+    void printMatrix(std::ostream& out) const;
+
+    static const char* typeName(PlayerType type);
+    static std::unique_ptr<Player> createPlayer(PlayerType type, char symbol, std::uint64_t seed);
+
+    // Plays one headless game. Returns 'X' or 'O' for a win, 'T' for a tie.
+    // If `outRecord` is given, the moves and result are added to it.
+    static char playGame(Player& xPlayer, Player& oPlayer, GameRecord* outRecord = nullptr);
+
+private:
+    Config config;
+    std::vector<PairingResult> results;   // PLAYER_TYPE_COUNT x PLAYER_TYPE_COUNT
+    double elapsed = 0.0;
+
+    void playChunk(int pairing, int chunk, int games, PairingResult& out) const;
+};
+
+#endif // FINALPROJECT_TOURNAMENT_H
@@ -0,0 +1,160 @@
+#include "TranspositionTable.h"
+#include "Board.h"
+#include "Symmetry.h"
+#include <array>
+
+namespace {
+    // SYM_CELL[s][cell] = index of `cell` after applying symmetry s.
+    // Cells are numbered row * 3 + col.
+    constexpr auto SYM_CELL = [] {
+        std::array<std::array<int, 9>, 8> table{};
+        for (int s = 0; s < 8; ++s) {
+            for (int cell = 0; cell < 9; ++cell) {
+                table[s][cell] = Symmetry::mapCell(s, 3, 3, cell);
+            }
+        }
+        return table;
+    }();
+    static_assert(SYM_CELL[4][0] == 2 && SYM_CELL[7][0] == 8, "rotate 90 and anti-diagonal");
+
+    // Every 9-bit mask under every symmetry, built once at compile time
+    constexpr auto SYM_MASK = [] {
+        std::array<std::array<std::uint16_t, 512>, 8> table{};
+        for (int s = 0; s < 8; ++s) {
+            for (int mask = 0; mask < 512; ++mask) {
+                int out = 0;
+                for (int cell = 0; cell < 9; ++cell) {
+                    if (mask & (1 << cell)) {
+                        out |= 1 << SYM_CELL[s][cell];
+                    }
+                }
+                table[s][mask] = static_cast<std::uint16_t>(out);
+            }
+        }
+        return table;
+    }();
+
+    // Slot layout: key (18 bits) | score + 128 (8) | bound (2) | best move + 1 (4)
+    constexpr int SCORE_SHIFT = 18;
+    constexpr int BOUND_SHIFT = 26;
+    constexpr int MOVE_SHIFT  = 28;
+
+    std::uint64_t pack(std::uint32_t key, int score, TranspositionTable::Bound bound, int move) {
+        return static_cast<std::uint64_t>(key)
+             | (static_cast<std::uint64_t>(score + 128) << SCORE_SHIFT)
+             | (static_cast<std::uint64_t>(bound) << BOUND_SHIFT)
+             | (static_cast<std::uint64_t>(move + 1) << MOVE_SHIFT);
+    }
+}
+
+TranspositionTable::TranspositionTable(std::size_t capacity) {
+    std::size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    slots = std::vector<std::atomic<std::uint64_t>>(size);
+    indexMask = size - 1;
+    clear();
+}
+
+TranspositionTable& TranspositionTable::shared() {
+    static TranspositionTable table;
+    return table;
+}
+
+bool TranspositionTable::probe(const Board& board, Entry& outEntry) {
+    probeCount.fetch_add(1, std::memory_order_relaxed);
+
+    int sym = 0;
+    std::uint32_t key = canonicalKey(board, sym);
+    std::uint64_t slot = slots[slotFor(key)].load(std::memory_order_relaxed);
+
+    auto bound = static_cast<Bound>((slot >> BOUND_SHIFT) & 0x3);
+    if (bound == Bound::None || (slot & 0x3FFFF) != key) {
+        return false;
+    }
+
+    hitCount.fetch_add(1, std::memory_order_relaxed);
+
+    int move = static_cast<int>((slot >> MOVE_SHIFT) & 0xF) - 1;
+    outEntry.score = static_cast<int>((slot >> SCORE_SHIFT) & 0xFF) - 128;
+    outEntry.bound = bound;
+    outEntry.bestMove = (move < 0) ? -1 : inverseTransformCell(move, sym);
+    return true;
+}
+
+void TranspositionTable::store(const Board& board, const Entry& entry) {
+    int sym = 0;
+    std::uint32_t key = canonicalKey(board, sym);
+
+    // Best moves are kept in canonical orientation so every symmetric copy can use them
+    int move = (entry.bestMove < 0) ? -1 : transformCell(entry.bestMove, sym);
+    slots[slotFor(key)].store(pack(key, entry.score, entry.bound, move),
+                              std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (auto& slot : slots) {
+        slot.store(0, std::memory_order_relaxed);
+    }
+    probeCount.store(0, std::memory_order_relaxed);
+    hitCount.store(0, std::memory_order_relaxed);
+}
+
+std::size_t TranspositionTable::size() const {
+    std::size_t used = 0;
+    for (const auto& slot : slots) {
+        if (((slot.load(std::memory_order_relaxed) >> BOUND_SHIFT) & 0x3) != 0) {
+            ++used;
+        }
+    }
+    return used;
+}
+
+std::size_t TranspositionTable::memoryBytes() const {
+    return sizeof(*this) + slots.size() * sizeof(std::atomic<std::uint64_t>);
+}
+
+double TranspositionTable::hitRate() const {
+    long long p = probes();
+    return (p == 0) ? 0.0 : static_cast<double>(hits()) / static_cast<double>(p);
+}
+
+std::uint32_t TranspositionTable::canonicalKey(const Board& board, int& outSymmetry) {
+    const std::uint16_t x = board.getMask('X');
+    const std::uint16_t o = board.getMask('O');
+
+    std::uint32_t best = (static_cast<std::uint32_t>(x) << 9) | o;
+    outSymmetry = 0;
+
+    for (int s = 1; s < SYMMETRY_COUNT; ++s) {
+        std::uint32_t key = (static_cast<std::uint32_t>(SYM_MASK[s][x]) << 9) | SYM_MASK[s][o];
+        if (key < best) {
+            best = key;
+            outSymmetry = s;
+        }
+    }
+    return best;
+}
+
+int TranspositionTable::transformCell(int cell, int sym) {
+    return SYM_CELL[sym][cell];
+}
+
+int TranspositionTable::inverseTransformCell(int cell, int sym) {
+    for (int i = 0; i < 9; ++i) {
+        if (SYM_CELL[sym][i] == cell) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+std::uint16_t TranspositionTable::transformMask(std::uint16_t mask, int sym) {
+    return SYM_MASK[sym][mask & Board::FULL_MASK];
+}
+
+std::size_t TranspositionTable::slotFor(std::uint32_t key) const {
+    // Fibonacci hashing spreads the small canonical keys over the table
+    return static_cast<std::size_t>((key * 0x9E3779B1u) >> 7) & indexMask;
+}
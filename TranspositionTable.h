@@ -0,0 +1,77 @@
+#ifndef FINALPROJECT_TRANSPOSITIONTABLE_H
+#define FINALPROJECT_TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Board;
+
+/**
+ * TranspositionTable caches search results for 3x3 positions.
+ *
+ * Positions are keyed by their canonical form: the smallest encoding among
+ * the eight rotations/reflections (the D4 symmetries) of the board, so all
+ * symmetric copies of a position share one entry. Scores are stored from the
+ * point of view of the side to move, which lets X and O players (and
+ * different games) share the same table.
+ *
+ * Each slot is a single atomic 64-bit word, so one table can be shared by
+ * players running on different threads without locking.
+ */
+class TranspositionTable {
+public:
+    enum class Bound : std::uint8_t {
+        None  = 0,
+        Exact = 1,
+        Lower = 2,   // real score >= stored score
+        Upper = 3    // real score <= stored score
+    };
+
+    struct Entry {
+        int score = 0;        // from the side to move's point of view
+        Bound bound = Bound::None;
+        int bestMove = -1;    // cell 0-8 in the caller's orientation, -1 if unknown
+    };
+
+    // `capacity` is rounded up to a power of two
+    explicit TranspositionTable(std::size_t capacity = 4096);
+
+    // Process-wide table used when players should share results across games
+    static TranspositionTable& shared();
+
+    bool probe(const Board& board, Entry& outEntry);
+    void store(const Board& board, const Entry& entry);
+    void clear();
+
+    // === Statistics ===
+    std::size_t capacity() const {return slots.size();}
+    std::size_t size() const;             // occupied slots
+    std::size_t memoryBytes() const;
+    long long probes() const {return probeCount.load(std::memory_order_relaxed);}
+    long long hits() const {return hitCount.load(std::memory_order_relaxed);}
+    double hitRate() const;
+
+    // === Symmetry helpers ===
+    static constexpr int SYMMETRY_COUNT = 8;
+
+    // Canonical 18-bit key (X mask << 9 | O mask) and the symmetry that produces it
+    static std::uint32_t canonicalKey(const Board& board, int& outSymmetry);
+
+    // Where `cell` lands under symmetry `sym`, and the reverse mapping
+    static int transformCell(int cell, int sym);
+    static int inverseTransformCell(int cell, int sym);
+    static std::uint16_t transformMask(std::uint16_t mask, int sym);
+
+private:
+    std::vector<std::atomic<std::uint64_t>> slots;
+    std::size_t indexMask;
+
+    std::atomic<long long> probeCount{0};
+    std::atomic<long long> hitCount{0};
+
+    std::size_t slotFor(std::uint32_t key) const;
+};
+
+#endif // FINALPROJECT_TRANSPOSITIONTABLE_H
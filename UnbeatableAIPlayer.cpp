@@ -18,8 +18,15 @@
 
 #include "UnbeatableAIPlayer.h"
 #include "Board.h"
+#include <bit>
 #include <iostream>  // for debug output
 
+namespace {
+    int lowestCell(std::uint16_t cells) {
+        return std::countr_zero(static_cast<unsigned>(cells));
+    }
+}
+
 UnbeatableAIPlayer::UnbeatableAIPlayer(char symbol)
     : AIPlayer(symbol, "Unbeatable AI") {}
 
@@ -46,6 +53,11 @@ void UnbeatableAIPlayer::makeMove(Board& board) {
         return;
     }
 
+    // 2b) A move from the opening book, if one was given and knows this position
+    if (tryBookMove(board)) {
+        return;
+    }
+
     // 3) SPECIAL CASE:
     // If we have the center AND the opponent has opposite corners,
     // we MUST play an EDGE, not a corner.
@@ -93,7 +105,7 @@ void UnbeatableAIPlayer::makeMove(Board& board) {
     }
 
     // 5) Block opponent's fork
-    if (blockOpponentFork(board, me, opp, r, c)) {
+    if (blockOpponentFork(board, opp, r, c)) {
         // std::cout << "[Unbeatable AI] Rule 5: block opponent's fork at (" << r << ", " << c << ").\n";
         board.applyMove(r, c, me);
         return;
@@ -135,120 +147,60 @@ char UnbeatableAIPlayer::opponentSymbol() const {
     return (symbol == 'X') ? 'O' : 'X';
 }
 
-// Count how many distinct immediate winning moves `player` has
-// on the given board.
-int UnbeatableAIPlayer::countImmediateWinningMoves(Board& board,
-                                                   char player) const {
-    int count = 0;
-    for (int r = 0; r < 3; ++r) {
-        for (int c = 0; c < 3; ++c) {
-            if (!board.isValidMove(r, c)) {
-                continue;
-            }
-            // wouldWinIfPlayed is defined in AIPlayer (protected)
-            if (wouldWinIfPlayed(board, r, c, player)) {
-                ++count;
-            }
-        }
-    }
-    return count;
+// A cell is a fork if, after playing it, at least two other empty cells win;
+// from the compile-time line table (unrolled for 3x3)
+std::uint16_t UnbeatableAIPlayer::forkCells(std::uint16_t own,
+                                            std::uint16_t empty) {
+    return Board::Lines::forkCells(own, empty);
 }
 
-// Is placing `player` at (r,c) a *fork*? (creates >= 2 immediate winning moves)
-bool UnbeatableAIPlayer::isForkMove(Board& board,
-                                    char player,
-                                    int r,
-                                    int c) const {
-    if (!board.isValidMove(r, c)) {
-        return false;
-    }
-
-    Board temp = board;           // copy
-    temp.applyMove(r, c, player); // pretend player moves here
-
-    int wins = countImmediateWinningMoves(temp, player);
-    return wins >= 2;
-}
-
-// Step: Find any fork move for `player`
-bool UnbeatableAIPlayer::findForkMove(Board& board,
+// Step: Find any fork move for `player` (first in row-major order)
+bool UnbeatableAIPlayer::findForkMove(const Board& board,
                                       char player,
                                       int& outRow,
                                       int& outCol) const {
-    for (int r = 0; r < 3; ++r) {
-        for (int c = 0; c < 3; ++c) {
-            if (isForkMove(board, player, r, c)) {
-                outRow = r;
-                outCol = c;
-                return true;
-            }
-        }
+    const std::uint16_t forks = forkCells(board.getMask(player), board.getEmptyMask());
+    if (forks == 0) {
+        return false;
     }
-    return false;
+
+    const int cell = lowestCell(forks);
+    outRow = cell / 3;
+    outCol = cell % 3;
+    return true;
 }
 
 // Step: Block opponent's fork (general logic)
-bool UnbeatableAIPlayer::blockOpponentFork(Board& board,
-                                           char me,
+bool UnbeatableAIPlayer::blockOpponentFork(const Board& board,
                                            char opp,
                                            int& outRow,
                                            int& outCol) const {
-    bool opponentHasFork = false;
+    const std::uint16_t oppMask = board.getMask(opp);
+    const std::uint16_t empty = board.getEmptyMask();
 
     // First, see if there is *any* fork available to the opponent
-    for (int r = 0; r < 3 && !opponentHasFork; ++r) {
-        for (int c = 0; c < 3 && !opponentHasFork; ++c) {
-            if (isForkMove(board, opp, r, c)) {
-                opponentHasFork = true;
-            }
-        }
-    }
-
-    if (!opponentHasFork) {
+    const std::uint16_t oppForks = forkCells(oppMask, empty);
+    if (oppForks == 0) {
         return false;  // nothing to block
     }
 
-    // Try moves for us that leave opponent with NO fork
-    for (int r = 0; r < 3; ++r) {
-        for (int c = 0; c < 3; ++c) {
-            if (!board.isValidMove(r, c)) {
-                continue;
-            }
-
-            Board temp = board;
-            temp.applyMove(r, c, me);
-
-            bool oppCanForkAfter = false;
-            for (int rr = 0; rr < 3 && !oppCanForkAfter; ++rr) {
-                for (int cc = 0; cc < 3 && !oppCanForkAfter; ++cc) {
-                    if (isForkMove(temp, opp, rr, cc)) {
-                        oppCanForkAfter = true;
-                    }
-                }
-            }
-
-            if (!oppCanForkAfter) {
-                outRow = r;
-                outCol = c;
-                return true;
-            }
+    // Try moves for us that leave opponent with NO fork. Our piece only
+    // matters to the opponent as one less empty cell.
+    for (std::uint16_t rest = empty; rest != 0; rest &= rest - 1) {
+        const std::uint16_t bit = rest & -rest;
+        if (forkCells(oppMask, empty & ~bit) == 0) {
+            const int cell = lowestCell(bit);
+            outRow = cell / 3;
+            outCol = cell % 3;
+            return true;
         }
     }
 
     // Fallback: directly occupy one of the fork squares
-    for (int r = 0; r < 3; ++r) {
-        for (int c = 0; c < 3; ++c) {
-            if (isForkMove(board, opp, r, c)) {
-                if (board.isValidMove(r, c)) {
-                    outRow = r;
-                    outCol = c;
-                    return true;
-                }
-            }
-        }
-    }
-
-    return false;
+    const int cell = lowestCell(oppForks);
+    outRow = cell / 3;
+    outCol = cell % 3;
+    return true;
 }
 
 // Step: Opposite corner
@@ -6,6 +6,7 @@
 #define FINALPROJECT_UNBEATABLEAIPLAYER_H
 
 #include "AIPlayer.h"
+#include <cstdint>
 
 class Board;
 
@@ -20,11 +21,17 @@ class Board;
  *    6) Take opposite corner
  *    7) Take empty corner
  *    8) Take empty side
+ *  - With an opening book set (AIPlayer::setOpeningBook), the book is consulted
+ *    after 1) and 2): a book move never passes over a win or a block, and when
+ *    the book knows the position its move replaces steps 3-8.
  */
 class UnbeatableAIPlayer final : public AIPlayer {
 public:
     explicit UnbeatableAIPlayer(char symbol);
 
+    // m,n,k boards use the default AIPlayer strategy
+    using AIPlayer::makeMove;
+
     // Main decision function: applies the best move to the board.
     void makeMove(Board& board) override;
 
@@ -32,31 +39,23 @@ private:
     // Helper: return opponent symbol ('X' -> 'O', 'O' -> 'X')
     char opponentSymbol() const;
 
-    // Count how many distinct immediate winning moves `player` has
-    // on the given board.
-    int countImmediateWinningMoves(Board& board, char player) const;
+    // Threat and fork detection works on bitmasks (bit row * 3 + col), so
+    // none of it copies the board.
 
-    // True if placing `player` at (row, col) creates a fork
+    // Empty cells that give a player holding `own` a fork
     // (i.e., at least 2 immediate winning moves next turn).
-    bool isForkMove(Board& board,
-                    char player,
-                    int row,
-                    int col) const;
+    static std::uint16_t forkCells(std::uint16_t own, std::uint16_t empty);
 
     // Step 3: find a fork move for `player`.
-    bool findForkMove(Board& board,
+    bool findForkMove(const Board& board,
                       char player,
                       int& outRow,
                       int& outCol) const;
 
-    // Step 4: block opponent's fork according to the description:
-    //  - If there is exactly one fork square, occupy it.
-    //  - Otherwise, try to play a move that both:
-    //       (a) creates an immediate threat (two-in-a-row),
-    //       (b) leaves the opponent with no fork.
-    //  - If that fails, fall back to occupying one of the fork squares.
-    bool blockOpponentFork(Board& board,
-                           char me,
+    // Step 4: block opponent's fork:
+    //  - Play the first move (row-major) that leaves the opponent with no fork.
+    //  - If there is none, fall back to occupying one of the fork squares.
+    bool blockOpponentFork(const Board& board,
                            char opp,
                            int& outRow,
                            int& outCol) const;
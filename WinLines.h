@@ -0,0 +1,149 @@
+#ifndef FINALPROJECT_WINLINES_H
+#define FINALPROJECT_WINLINES_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+/**
+ * WinLines<Rows, Cols, K> is the table of winning lines for a Rows x Cols
+ * board where K in a row wins, generated at compile time, plus the
+ * bitboard tests built on it. Cell (row, col) is bit (row * Cols + col).
+ *
+ *   LINES        every line as a cell mask: horizontal, vertical, then the
+ *                two diagonals, each in row-major order of its first cell
+ *                (for 3x3: the 3 rows, 3 columns, main and anti diagonal)
+ *   CELL_LINES   for each cell, the indices of the lines through it
+ *
+ * Everything is constexpr, so each board size gets its own code: up to
+ * UNROLL_LIMIT lines the scans over LINES are expanded by a fold expression
+ * (fully unrolled for 3x3, with the line masks as immediates); larger
+ * tables get a plain loop over the constant array.
+ */
+template <int Rows, int Cols, int K>
+struct WinLines {
+    static_assert(Rows >= 1 && Cols >= 1 && K >= 2, "need a board and K >= 2");
+    static_assert(Rows * Cols <= 64, "cells must fit in a 64-bit mask");
+
+    static constexpr int CELLS = Rows * Cols;
+
+    // Smallest unsigned type holding one bit per cell
+    using Mask = std::conditional_t<(CELLS <= 16), std::uint16_t,
+                 std::conditional_t<(CELLS <= 32), std::uint32_t, std::uint64_t>>;
+
+    static constexpr Mask FULL_MASK = static_cast<Mask>(CELLS == 64 ? ~0ull : (1ull << CELLS) - 1);
+
+    static constexpr int UNROLL_LIMIT = 16;
+
+private:
+    static constexpr int spans(int length) {return length >= K ? length - K + 1 : 0;}
+
+public:
+    static constexpr int COUNT = Rows * spans(Cols) + spans(Rows) * Cols
+                               + 2 * spans(Rows) * spans(Cols);
+
+    // Most lines one cell can be on: K per direction
+    static constexpr int MAX_PER_CELL = 4 * K;
+
+    static constexpr auto LINES = [] {
+        std::array<Mask, COUNT> lines{};
+        // (row step, col step, first col) for horizontal, vertical, diagonal, anti-diagonal
+        constexpr int directions[4][3] = {{0, 1, 0}, {1, 0, 0}, {1, 1, 0}, {1, -1, K - 1}};
+        int n = 0;
+        for (const auto& d : directions) {
+            for (int r = 0; r + d[0] * (K - 1) < Rows; ++r) {
+                for (int c = d[2]; c < Cols && c + d[1] * (K - 1) < Cols; ++c) {
+                    Mask line = 0;
+                    for (int i = 0; i < K; ++i) {
+                        line |= static_cast<Mask>(Mask{1} << ((r + d[0] * i) * Cols + c + d[1] * i));
+                    }
+                    lines[n++] = line;
+                }
+            }
+        }
+        return lines;
+    }();
+
+    struct CellLines {
+        int count = 0;
+        std::array<std::uint16_t, MAX_PER_CELL> lines{};
+    };
+
+    static constexpr auto CELL_LINES = [] {
+        std::array<CellLines, CELLS> table{};
+        for (int line = 0; line < COUNT; ++line) {
+            for (int cell = 0; cell < CELLS; ++cell) {
+                if (LINES[line] & (Mask{1} << cell)) {
+                    CellLines& entry = table[cell];
+                    entry.lines[entry.count++] = static_cast<std::uint16_t>(line);
+                }
+            }
+        }
+        return table;
+    }();
+
+    // Calls visit(line) for every line until it returns true; true if one did
+    template <typename Visit>
+    static constexpr bool anyLine(Visit&& visit) {
+        if constexpr (COUNT <= UNROLL_LIMIT) {
+            return [&]<std::size_t... I>(std::index_sequence<I...>) {
+                return (visit(LINES[I]) || ...);
+            }(std::make_index_sequence<COUNT>{});
+        } else {
+            for (Mask line : LINES) {
+                if (visit(line)) return true;
+            }
+            return false;
+        }
+    }
+
+    // True if any line is fully covered by `own`
+    static constexpr bool hasLine(Mask own) {
+        return anyLine([own](Mask line) {return (own & line) == line;});
+    }
+
+    // Would adding `cell` to `own` complete a line? Only the lines through
+    // that cell are looked at.
+    static constexpr bool wouldWin(Mask own, int cell) {
+        const Mask after = static_cast<Mask>(own | (Mask{1} << cell));
+        const CellLines& through = CELL_LINES[cell];
+        for (int i = 0; i < through.count; ++i) {
+            const Mask line = LINES[through.lines[i]];
+            if ((after & line) == line) return true;
+        }
+        return false;
+    }
+
+    // Empty cells where a player holding `own` completes a line: the last
+    // cell of every line where it has K - 1 pieces
+    static constexpr Mask winningCells(Mask own, Mask empty) {
+        Mask cells = 0;
+        anyLine([&](Mask line) {
+            const Mask missing = static_cast<Mask>(line & ~own);
+            if ((missing & (missing - 1)) == 0) {   // at most one cell missing
+                cells |= missing;
+            }
+            return false;
+        });
+        return static_cast<Mask>(cells & empty);
+    }
+
+    // Empty cells that give a player holding `own` a fork: after playing
+    // there it has at least two winning cells
+    static constexpr Mask forkCells(Mask own, Mask empty) {
+        Mask forks = 0;
+        for (Mask rest = empty; rest != 0; rest &= rest - 1) {
+            const Mask bit = static_cast<Mask>(rest & (~rest + 1));
+            const Mask after = static_cast<Mask>(empty & ~bit);
+            if (std::popcount(winningCells(static_cast<Mask>(own | bit), after)) >= 2) {
+                forks |= bit;
+            }
+        }
+        return forks;
+    }
+};
+
+#endif // FINALPROJECT_WINLINES_H
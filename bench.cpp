@@ -0,0 +1,559 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "Board.h"
+#include "BoardBatch.h"
+#include "MNKBoard.h"
+#include "AIPlayer.h"
+#include "DatabaseAIPlayer.h"
+#include "GameRecord.h"
+#include "MiniMaxAIPlayer.h"
+#include "MCTSAIPlayer.h"
+#include "MetaBoard.h"
+#include "OpeningBook.h"
+#include "PositionDatabase.h"
+#include "ProofNumberSolver.h"
+#include "QubicAIPlayer.h"
+#include "QubicBoard.h"
+#include "Rng.h"
+#include "ThreadPool.h"
+#include "Tournament.h"
+#include "TranspositionTable.h"
+#include "UnbeatableAIPlayer.h"
+
+/**
+ * Microbenchmarks for the Board and AI hot paths.
+ *
+ * Usage: bench [--min-time SECONDS] [--filter SUBSTRING]
+ *
+ * Prints one JSON object per benchmark (JSON Lines) with ns/op, nodes/sec
+ * (for searches) and heap allocations per op, so runs can be diffed across
+ * commits by a script.
+ */
+
+// Allocation counting
+// ============================================================
+namespace {
+    std::atomic<long long> allocationCount{0};
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {std::free(p);}
+void operator delete(void* p, std::size_t) noexcept {std::free(p);}
+
+// Harness
+// ============================================================
+namespace {
+    volatile long long sink = 0;   // keeps results observable so loops aren't optimized out
+
+    double minTimeSeconds = 0.25;
+    std::string filter;
+
+    // Runs `op` in growing batches until it has taken at least minTimeSeconds.
+    // `op` returns how much work it did in `unit`s (search nodes, or playouts
+    // for Monte Carlo players; 0 if not a search), reported as <unit>_per_sec.
+    void runBenchmark(const std::string& name, const std::function<long long()>& op,
+                      const char* unit = "nodes") {
+        if (!filter.empty() && name.find(filter) == std::string::npos) {
+            return;
+        }
+
+        op();  // warm-up (caches, lazily built tables)
+
+        long long iterations = 1;
+        while (true) {
+            long long work = 0;
+            long long allocsBefore = allocationCount.load();
+            auto start = std::chrono::steady_clock::now();
+
+            for (long long i = 0; i < iterations; ++i) {
+                work += op();
+            }
+
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            long long allocs = allocationCount.load() - allocsBefore;
+
+            if (seconds >= minTimeSeconds || iterations >= (1LL << 40)) {
+                double ns = seconds * 1e9 / static_cast<double>(iterations);
+                std::cout << "{\"name\":\"" << name << "\""
+                          << ",\"iterations\":" << iterations
+                          << ",\"ns_per_op\":" << ns
+                          << ",\"" << unit << "_per_sec\":" << (work > 0 ? static_cast<double>(work) / seconds : 0.0)
+                          << ",\"allocs_per_op\":" << static_cast<double>(allocs) / static_cast<double>(iterations)
+                          << "}" << std::endl;
+                return;
+            }
+            iterations *= (seconds < minTimeSeconds / 100) ? 10 : 2;
+        }
+    }
+
+    Board boardFrom(const char* cells) {
+        // 9 characters, row-major; anything but X/O is empty
+        Board b;
+        for (int i = 0; i < 9; ++i) {
+            if (cells[i] == 'X' || cells[i] == 'O') {
+                b.applyMove(i / 3, i % 3, cells[i]);
+            }
+        }
+        return b;
+    }
+
+    // Exposes the protected AIPlayer helpers to the benchmarks
+    class HelperProbe : public AIPlayer {
+    public:
+        explicit HelperProbe(char symbol) : AIPlayer(symbol, "probe") {}
+        using AIPlayer::makeMove;
+        void makeMove(Board&) override {}
+        bool find(Board& b, char s, int& r, int& c) const {return findWinningMove(b, s, r, c);}
+    };
+}
+
+// Benchmarks
+// ============================================================
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minTimeSeconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--min-time SECONDS] [--filter SUBSTRING]\n";
+            return 2;
+        }
+    }
+
+    const Board empty;
+    const Board midgame = boardFrom("X.O.X...O");   // X to move, 4 stones
+    const Board full = boardFrom("XOXXOOOXX");       // tie
+    const Board boards[3] = {empty, midgame, full};
+
+    // --- Board ---
+    runBenchmark("Board::winCheck", [&] {
+        long long wins = 0;
+        for (const Board& b : boards) {
+            wins += b.winCheck('X') + b.winCheck('O');
+        }
+        sink = sink + wins;
+        return 0LL;
+    });
+
+    runBenchmark("Board::tieCheck", [&] {
+        long long ties = 0;
+        for (const Board& b : boards) {
+            ties += b.tieCheck();
+        }
+        sink = sink + ties;
+        return 0LL;
+    });
+
+    // --- Batched status checks: 1024 boards cycling through every 3^9 cell pattern ---
+    {
+        BoardBatch batch(1024);
+        std::vector<Board> singles;
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            Board b;
+            for (int cell = 0, rest = static_cast<int>(i * 19); cell < 9; ++cell, rest /= 3) {
+                if (rest % 3 == 1) b.makeMove(cell / 3, cell % 3, 'X');
+                if (rest % 3 == 2) b.makeMove(cell / 3, cell % 3, 'O');
+            }
+            batch.set(i, b);
+            singles.push_back(b);
+        }
+        std::vector<char> status(batch.size());
+
+        runBenchmark("Board::winCheck+tieCheck/1024", [&] {
+            long long over = 0;
+            for (const Board& b : singles) {
+                over += b.winCheck('X') || b.winCheck('O') || b.tieCheck();
+            }
+            sink = sink + over;
+            return static_cast<long long>(singles.size());
+        }, "boards");
+
+        for (auto path : {BoardBatch::Path::Scalar, BoardBatch::Path::Sse2, BoardBatch::Path::Avx2}) {
+            if (!BoardBatch::supports(path)) continue;
+            runBenchmark(std::string("BoardBatch::classify/1024/") + BoardBatch::pathName(path), [&] {
+                batch.classify(status.data(), path);
+                sink = sink + status[0];
+                return static_cast<long long>(batch.size());
+            }, "boards");
+        }
+    }
+
+    // --- AIPlayer helpers ---
+    runBenchmark("AIPlayer::findWinningMove", [&] {
+        HelperProbe probe('X');
+        Board b = midgame;
+        int r = -1, c = -1;
+        sink = sink + probe.find(b, 'X', r, c) + probe.find(b, 'O', r, c);
+        return 0LL;
+    });
+
+    // --- Full players ---
+    runBenchmark("UnbeatableAIPlayer::makeMove/empty", [&] {
+        UnbeatableAIPlayer ai('X');
+        Board b = empty;
+        ai.makeMove(b);
+        sink = sink + b.getOccupiedMask();
+        return 0LL;
+    });
+
+    runBenchmark("UnbeatableAIPlayer::makeMove/midgame", [&] {
+        UnbeatableAIPlayer ai('X');
+        Board b = midgame;
+        ai.makeMove(b);
+        sink = sink + b.getOccupiedMask();
+        return 0LL;
+    });
+
+    // Solved-position file, built once into the temp directory and mapped
+    const std::string dbPath = (std::filesystem::temp_directory_path() / "bench_3x3k3.mnkdb").string();
+    std::string dbError;
+    PositionDatabase database;
+    if (PositionDatabase::build(3, 3, 3, dbPath, dbError) && database.open(dbPath)) {
+        runBenchmark("DatabaseAIPlayer::makeMove/midgame", [&] {
+            DatabaseAIPlayer ai('X', database);
+            Board b = midgame;
+            ai.makeMove(b);
+            sink = sink + b.getOccupiedMask();
+            return 0LL;
+        });
+        database.close();
+    }
+    std::filesystem::remove(dbPath);
+
+    struct SearchVariant {
+        const char* name;
+        MiniMaxAIPlayer::SearchOptions options;
+    };
+    MiniMaxAIPlayer::SearchOptions fullOptions;
+    fullOptions.mode = MiniMaxAIPlayer::SearchMode::Full;
+    MiniMaxAIPlayer::SearchOptions alphaBetaOptions;
+    TranspositionTable table;
+    MiniMaxAIPlayer::SearchOptions tableOptions;
+    tableOptions.table = &table;
+
+    const SearchVariant variants[] = {
+        {"full", fullOptions},
+        {"alphabeta", alphaBetaOptions},
+        {"alphabeta+tt", tableOptions}
+    };
+
+    for (const auto& variant : variants) {
+        for (const auto& [label, start] : {std::pair<const char*, Board>{"empty", empty},
+                                           std::pair<const char*, Board>{"midgame", midgame}}) {
+            MiniMaxAIPlayer ai('X', variant.options);
+            runBenchmark(std::string("MiniMaxAIPlayer::makeMove/") + label + "/" + variant.name, [&] {
+                Board b = start;
+                ai.makeMove(b);
+                sink = sink + b.getOccupiedMask();
+                return ai.getLastNodeCount();
+            });
+        }
+    }
+
+    // --- Root-split search on a 4x4, k = 4 board, serial vs. one thread per core ---
+    MNKBoard mnk(4, 4, 4);
+    mnk.applyMove(1, 1, 'X');
+    mnk.applyMove(2, 2, 'O');
+    mnk.applyMove(1, 2, 'X');
+    mnk.applyMove(0, 0, 'O');
+
+    ThreadPool pool;
+    MiniMaxAIPlayer::SearchOptions parallelOptions;
+    parallelOptions.pool = &pool;
+
+    for (const auto& variant : {SearchVariant{"serial", alphaBetaOptions},
+                                SearchVariant{"parallel", parallelOptions}}) {
+        MiniMaxAIPlayer ai('X', variant.options);
+        runBenchmark(std::string("MiniMaxAIPlayer::makeMove/mnk4x4/") + variant.name, [&] {
+            MNKBoard b = mnk;
+            ai.makeMove(b);
+            sink = sink + b.getLastRow();
+            return ai.getLastNodeCount();
+        });
+    }
+
+    // --- Proof-number solver on the same position and on the empty 4x4 board (fresh table each time) ---
+    {
+        ProofNumberSolver solver;
+        for (const auto& [label, start] : {std::pair<const char*, MNKBoard>{"mnk4x4", mnk},
+                                           std::pair<const char*, MNKBoard>{"mnk4x4/empty", MNKBoard(4, 4, 4)}}) {
+            runBenchmark(std::string("ProofNumberSolver::solve/") + label, [&] {
+                solver.clear();
+                const ProofNumberSolver::Result result = solver.solve(start);
+                sink = sink + result.bestMove;
+                return result.nodes;
+            });
+        }
+    }
+
+    // --- Bulk analysis of every reachable position: makeMove() one at a time vs. evaluateBatch() ---
+    std::vector<Board> positions;
+    {
+        std::vector<bool> seen(1u << 18, false);
+        std::vector<Board> stack{Board()};
+        while (!stack.empty()) {
+            Board b = stack.back();
+            stack.pop_back();
+            unsigned key = (static_cast<unsigned>(b.getMask('X')) << 9) | b.getMask('O');
+            if (seen[key] || b.winCheck('X') || b.winCheck('O') || b.tieCheck()) continue;
+            seen[key] = true;
+            positions.push_back(b);
+
+            char toMove = (b.getFilledCells() % 2 == 0) ? 'X' : 'O';
+            for (int cell = 0; cell < 9; ++cell) {
+                if (b.isValidMove(cell / 3, cell % 3)) {
+                    Board next = b;
+                    next.applyMove(cell / 3, cell % 3, toMove);
+                    stack.push_back(next);
+                }
+            }
+        }
+    }
+    const long long positionCount = static_cast<long long>(positions.size());
+
+    {
+        MiniMaxAIPlayer xPlayer('X', tableOptions);
+        MiniMaxAIPlayer oPlayer('O', tableOptions);
+        runBenchmark("MiniMaxAIPlayer::analyse/makeMove-each", [&] {
+            for (const Board& position : positions) {
+                Board b = position;
+                MiniMaxAIPlayer& ai = (b.getFilledCells() % 2 == 0) ? xPlayer : oPlayer;
+                ai.makeMove(b);
+                sink = sink + b.getOccupiedMask();
+            }
+            return positionCount;
+        }, "positions");
+    }
+
+    MiniMaxAIPlayer::SearchOptions batchOptions = tableOptions;
+    batchOptions.pool = &pool;
+    std::vector<MiniMaxAIPlayer::Evaluation> evaluations(positions.size());
+
+    for (const auto& variant : {SearchVariant{"serial+tt", tableOptions},
+                                SearchVariant{"parallel+tt", batchOptions}}) {
+        MiniMaxAIPlayer ai('X', variant.options);
+        runBenchmark(std::string("MiniMaxAIPlayer::analyse/evaluateBatch/") + variant.name, [&] {
+            ai.evaluateBatch(positions.data(), positions.size(), evaluations.data());
+            sink = sink + static_cast<std::uint16_t>(evaluations.back().bestMove);
+            return positionCount;
+        }, "positions");
+    }
+
+    // --- Monte Carlo tree search: playouts per second, 3x3 and Gomoku ---
+    for (const auto& [label, start] : {std::pair<const char*, MNKBoard>{"3x3", MNKBoard()},
+                                       std::pair<const char*, MNKBoard>{"gomoku", MNKBoard(15, 15, 5)}}) {
+        MCTSAIPlayer::Options mctsOptions;
+        mctsOptions.playouts = 2000;
+        mctsOptions.reuseTree = false;
+        MCTSAIPlayer ai('X', mctsOptions);
+        ai.setSeed(1);
+
+        runBenchmark(std::string("MCTSAIPlayer::makeMove/") + label, [&] {
+            MNKBoard b = start;
+            ai.makeMove(b);
+            sink = sink + b.getLastRow();
+            return ai.getLastSearchStats().playouts;
+        }, "playouts");
+    }
+
+    // --- The same Gomoku move from an opening book (compare with MCTS above) ---
+    {
+        OpeningBook::Options bookOptions;
+        bookOptions.minGames = 1;
+        OpeningBook book(15, 15, 5, bookOptions);
+        Rng rng(7);
+        for (int game = 0; game < 500; ++game) {
+            // Eight random moves in the central 7x7, then a random result
+            int cells[8];
+            int count = 0;
+            while (count < 8) {
+                const int cell = static_cast<int>((4 + rng.next() % 7) * 15 + (4 + rng.next() % 7));
+                if (std::find(cells, cells + count, cell) == cells + count) {
+                    cells[count++] = cell;
+                }
+            }
+            book.addGame(cells, count, "XOT"[rng.next() % 3]);
+        }
+
+        MCTSAIPlayer ai('X');
+        ai.setOpeningBook(&book);
+        const MNKBoard start(15, 15, 5);
+        runBenchmark("MCTSAIPlayer::makeMove/gomoku/book", [&] {
+            MNKBoard b = start;
+            ai.makeMove(b);
+            sink = sink + b.getLastRow();
+            return 0LL;
+        });
+    }
+
+    // --- Ultimate TicTacToe: move generation and MCTS from the opening ---
+    {
+        MetaBoard opening;
+        opening.makeMove(4, 4, 'X');   // O is sent to the center sub-board
+        opening.makeMove(3, 3, 'O');   // X is sent to sub-board 0
+        std::uint8_t moves[MetaBoard::CELLS];
+
+        runBenchmark("MetaBoard::generateMoves", [&] {
+            sink = sink + opening.generateMoves(moves);
+            return 0LL;
+        });
+
+        MCTSAIPlayer::Options mctsOptions;
+        mctsOptions.playouts = 2000;
+        mctsOptions.reuseTree = false;
+        MCTSAIPlayer ai('X', mctsOptions);
+        ai.setSeed(1);
+
+        runBenchmark("MCTSAIPlayer::makeMove/ultimate", [&] {
+            MetaBoard b;
+            ai.makeMove(b);
+            sink = sink + b.getFilledCells();
+            return ai.getLastSearchStats().playouts;
+        }, "playouts");
+    }
+
+    // --- Qubic (4x4x4): threat masks and a full move from a quiet middlegame ---
+    {
+        QubicBoard middle;
+        for (int cell : {21, 0, 42, 63, 22, 5, 41, 38}) {
+            middle.makeMove(cell, (middle.getFilledCells() % 2 == 0) ? 'X' : 'O');
+        }
+        const std::uint64_t x = middle.getMask('X');
+
+        runBenchmark("QubicBoard::winningCells", [&] {
+            sink = sink + QubicBoard::winningCells(x, middle.getEmptyMask());
+            return 0LL;
+        });
+        runBenchmark("QubicBoard::forkCells", [&] {
+            sink = sink + QubicBoard::forkCells(x, middle.getEmptyMask());
+            return 0LL;
+        });
+
+        QubicAIPlayer ai('X');
+        runBenchmark("QubicAIPlayer::makeMove", [&] {
+            QubicBoard b = middle;
+            ai.makeMove(b);
+            sink = sink + b.getFilledCells();
+            return ai.getLastSearchStats().nodes;
+        });
+    }
+
+    // --- MCTS on a 3x3 Board: one playout per leaf vs a lockstep batch of 8 ---
+    for (int leafPlayouts : {1, 8}) {
+        MCTSAIPlayer::Options mctsOptions;
+        mctsOptions.playouts = 2000;
+        mctsOptions.reuseTree = false;
+        mctsOptions.leafPlayouts = leafPlayouts;
+        MCTSAIPlayer ai('X', mctsOptions);
+        ai.setSeed(1);
+
+        runBenchmark("MCTSAIPlayer::makeMove/board3x3/leaf" + std::to_string(leafPlayouts), [&] {
+            Board b;
+            ai.makeMove(b);
+            sink = sink + b.getFilledCells();
+            return ai.getLastSearchStats().playouts;
+        }, "playouts");
+    }
+
+    // --- Random games in lockstep (compare with Game/Random-vs-Random below) ---
+    {
+        BoardBatch batch(1024);
+        Rng rng(1);
+        runBenchmark("BoardBatch::playRandomGames/1024", [&] {
+            batch.resize(1024);
+            BoardBatch::Totals totals = batch.playRandomGames(rng);
+            sink = sink + totals.xWins;
+            return 1024LL;
+        }, "games");
+    }
+
+    // --- Game records: buffered appends (to /dev/null, so only our side of the
+    // write is timed) and iterating a mapped file ---
+    {
+        std::vector<GameRecord> games(1024);
+        for (std::size_t i = 0; i < games.size(); ++i) {
+            games[i].seed = i;
+            games[i].setPlayers(GameRecord::PlayerKind::Random, GameRecord::PlayerKind::Random);
+            for (int n = 0; n < 7; ++n) {
+                games[i].addMove(static_cast<int>((i + n * 4) % 9));
+            }
+            games[i].setResult('X');
+        }
+
+        GameRecordWriter sinkWriter;
+        if (sinkWriter.open("/dev/null")) {
+            GameRecordWriter::Buffer buffer(sinkWriter);
+            runBenchmark("GameRecordWriter::Buffer::append/1024", [&] {
+                for (const GameRecord& game : games) {
+                    buffer.append(game);
+                }
+                return 1024LL;
+            }, "games");
+        }
+
+        const std::string recordPath = (std::filesystem::temp_directory_path() / "bench_games.tttrec").string();
+        std::filesystem::remove(recordPath);
+        GameRecordWriter fileWriter;
+        GameRecordReader reader;
+        if (fileWriter.open(recordPath)) {
+            {
+                GameRecordWriter::Buffer buffer(fileWriter);
+                for (int copy = 0; copy < 64; ++copy) {
+                    for (const GameRecord& game : games) {
+                        buffer.append(game);
+                    }
+                }
+            }
+            fileWriter.close();
+        }
+        if (reader.open(recordPath)) {
+            runBenchmark("GameRecordReader::iterate/65536", [&] {
+                long long moves = 0;
+                for (const GameRecord& game : reader) {
+                    moves += game.moveCount() + game.move(0);
+                }
+                sink = sink + moves;
+                return static_cast<long long>(reader.size());
+            }, "games");
+            reader.close();
+        }
+        std::filesystem::remove(recordPath);
+    }
+
+    // --- Whole games, one per pairing ---
+    for (int x = 0; x < Tournament::PLAYER_TYPE_COUNT; ++x) {
+        for (int o = 0; o < Tournament::PLAYER_TYPE_COUNT; ++o) {
+            auto xType = static_cast<Tournament::PlayerType>(x);
+            auto oType = static_cast<Tournament::PlayerType>(o);
+            auto xPlayer = Tournament::createPlayer(xType, 'X', 1);
+            auto oPlayer = Tournament::createPlayer(oType, 'O', 2);
+
+            runBenchmark(std::string("Game/") + Tournament::typeName(xType) + "-vs-" +
+                         Tournament::typeName(oType), [&] {
+                sink = sink + Tournament::playGame(*xPlayer, *oPlayer);
+                return 0LL;
+            });
+        }
+    }
+
+    return 0;
+}
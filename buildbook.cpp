@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "GameRecord.h"
+#include "MCTSAIPlayer.h"
+#include "MNKBoard.h"
+#include "OpeningBook.h"
+#include "Rng.h"
+#include "ThreadPool.h"
+
+/**
+ * Builds an opening book from self-play and/or recorded games.
+ *
+ * Usage: buildbook [--rows R] [--cols C] [--k K] [--games N] [--playouts P]
+ *                  [--plies D] [--min-games G] [--threads T] [--seed S]
+ *                  [--records FILE]... [--output PATH]
+ *   --rows, --cols  board size (default 3 x 3)
+ *   --k             stones in a row to win (default 3)
+ *   --games         MCTS self-play games (default 2000, or 0 with --records)
+ *   --playouts      MCTS playouts per move (default 2000)
+ *   --plies         opening moves kept per game (default 8)
+ *   --min-games     games a position needs before the book plays into it (default 20)
+ *   --threads       worker threads (default: one per hardware thread)
+ *   --seed          base seed: a seeded book is the same for any thread count (default 1)
+ *   --records       game-record file to learn from too (3x3 only; repeatable)
+ *   --output        file to write (default <R>x<C>k<K>.book)
+ *
+ * Self-play is the headless version of TicTacToe's game loop on an MNKBoard:
+ * both sides are MCTS players, reseeded before every game from its own seed,
+ * so the games differ while the search stays the same strength. Every worker
+ * fills its own book and the books are merged at the end.
+ */
+namespace {
+    // Plays one game and returns 'X', 'O' or 'T'; the cells played go to `moves`
+    char playSelfPlayGame(MCTSAIPlayer& xPlayer, MCTSAIPlayer& oPlayer,
+                          int rows, int cols, int k, std::vector<int>& moves) {
+        MNKBoard board(rows, cols, k);
+        MCTSAIPlayer* current = &xPlayer;
+        moves.clear();
+
+        while (true) {
+            current->makeMove(board);
+            moves.push_back(board.getLastRow() * cols + board.getLastCol());
+
+            const char symbol = current->getSymbol();
+            if (board.winCheck(symbol)) {
+                return symbol;
+            } else if (board.tieCheck()) {
+                return 'T';
+            }
+            current = (current == &xPlayer) ? &oPlayer : &xPlayer;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int rows = 3;
+    int cols = 3;
+    int k = 3;
+    int games = -1;
+    long long playouts = 2000;
+    OpeningBook::Options bookOptions;
+    std::size_t threads = 0;
+    std::uint64_t seed = 1;
+    std::vector<std::string> recordPaths;
+    std::string output;
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--rows") == 0 && hasValue) {
+            rows = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--cols") == 0 && hasValue) {
+            cols = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--k") == 0 && hasValue) {
+            k = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--games") == 0 && hasValue) {
+            games = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--playouts") == 0 && hasValue) {
+            playouts = std::atoll(argv[++i]);
+        } else if (std::strcmp(argv[i], "--plies") == 0 && hasValue) {
+            bookOptions.maxPly = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--min-games") == 0 && hasValue) {
+            bookOptions.minGames = std::atoll(argv[++i]);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threads = static_cast<std::size_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--records") == 0 && hasValue) {
+            recordPaths.emplace_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            output = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--rows R] [--cols C] [--k K] [--games N] [--playouts P]"
+                      << " [--plies D] [--min-games G] [--threads T] [--seed S] [--records FILE]..."
+                      << " [--output PATH]\n";
+            return 2;
+        }
+    }
+    if (rows < 1 || rows > MNKBoard::MAX_DIM || cols < 1 || cols > MNKBoard::MAX_DIM ||
+        k < 1 || k > std::max(rows, cols)) {
+        std::cerr << "buildbook: unsupported board " << rows << "x" << cols << " k=" << k << "\n";
+        return 2;
+    }
+    if (games < 0) {
+        games = recordPaths.empty() ? 2000 : 0;
+    }
+    if (output.empty()) {
+        output = std::to_string(rows) + "x" + std::to_string(cols) + "k" + std::to_string(k) + ".book";
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    OpeningBook book(rows, cols, k, bookOptions);
+
+    // === Recorded games ===
+    for (const std::string& path : recordPaths) {
+        if (rows != 3 || cols != 3 || k != 3) {
+            std::cerr << "buildbook: game records are 3x3 games; " << path << " skipped\n";
+            continue;
+        }
+        GameRecordReader reader;
+        if (!reader.open(path)) {
+            std::cerr << "buildbook: " << reader.getError() << "\n";
+            return 1;
+        }
+        for (const GameRecord& record : reader) {
+            book.addGame(record);
+        }
+    }
+
+    // === Self-play ===
+    if (games > 0) {
+        const int chunkSize = 50;
+        std::mutex bookMutex;
+        ThreadPool pool(threads);
+
+        for (int first = 0; first < games; first += chunkSize) {
+            const int count = std::min(chunkSize, games - first);
+            pool.submit([&, first, count] {
+                MCTSAIPlayer::Options options;
+                options.playouts = playouts;
+                MCTSAIPlayer xPlayer('X', options);
+                MCTSAIPlayer oPlayer('O', options);
+                OpeningBook local(rows, cols, k, bookOptions);
+                std::vector<int> moves;
+
+                for (int i = first; i < first + count; ++i) {
+                    std::uint64_t gameSeed = seed + static_cast<std::uint64_t>(i);
+                    gameSeed = Rng::splitMix64(gameSeed);
+                    xPlayer.setSeed(GameRecord::playerSeed(gameSeed, 0));
+                    oPlayer.setSeed(GameRecord::playerSeed(gameSeed, 1));
+                    const char winner = playSelfPlayGame(xPlayer, oPlayer, rows, cols, k, moves);
+                    local.addGame(moves.data(), static_cast<int>(moves.size()), winner);
+                }
+
+                std::lock_guard<std::mutex> lock(bookMutex);
+                book.merge(local);
+            });
+        }
+        pool.waitIdle();
+    }
+
+    if (!book.save(output)) {
+        std::cerr << "buildbook: " << book.getError() << "\n";
+        return 1;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << output << ": " << book.gamesAdded() << " games, " << book.size()
+              << " positions, " << seconds << " s\n";
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "GameServer.h"
+
+/**
+ * Game server: hosts TicTacToe games against the AI players over a
+ * line-based protocol (see GameServer.h). Stop it with Ctrl+C.
+ *
+ * Usage: gameserver [--port P | --unix PATH] [--threads T] [--max-connections N]
+ *   --port             TCP port on 127.0.0.1 (default 7878)
+ *   --unix             listen on a Unix socket instead
+ *   --threads          AI worker threads (default: one per hardware thread)
+ *   --max-connections  session slots (default 16384)
+ */
+namespace {
+    GameServer* running = nullptr;
+
+    void onSignal(int) {
+        if (running != nullptr) running->stop();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    GameServer::Config config;
+    config.port = 7878;
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--port") == 0 && hasValue) {
+            config.port = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--unix") == 0 && hasValue) {
+            config.unixPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            config.threads = static_cast<std::size_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-connections") == 0 && hasValue) {
+            config.maxConnections = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--port P | --unix PATH] [--threads T] [--max-connections N]\n";
+            return 2;
+        }
+    }
+
+    GameServer server(config);
+    std::string error;
+    if (!server.start(error)) {
+        std::cerr << "gameserver: " << error << "\n";
+        return 1;
+    }
+
+    running = &server;
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    if (config.unixPath.empty()) {
+        std::cout << "Listening on 127.0.0.1:" << server.getPort() << std::endl;
+    } else {
+        std::cout << "Listening on " << config.unixPath << std::endl;
+    }
+    server.run();
+
+    GameServer::Counters counters = server.getCounters();
+    std::cout << "Served " << counters.games << " games (" << counters.aiMoves << " AI moves) on "
+              << counters.connections << " connections\n";
+    return 0;
+}
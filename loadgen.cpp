@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Board.h"
+#include "Rng.h"
+
+/**
+ * Load generator for gameserver.
+ *
+ * Keeps --connections games going at once, each client playing random legal
+ * moves as X against the chosen AI, until --games games have finished. Every
+ * request is timed from sending its line to reading the first line of the
+ * reply, and the run ends with throughput and latency percentiles.
+ *
+ * Usage: loadgen [--port P | --unix PATH] [--connections C] [--games N] [--ai TYPE] [--seed S]
+ *   --port         server TCP port on 127.0.0.1 (default 7878)
+ *   --unix         connect to a Unix socket instead
+ *   --connections  concurrent games (default 100)
+ *   --games        games to play in total (default 10000)
+ *   --ai           regular, unbeatable, minimax, perfect or random (default perfect)
+ *   --seed         seed for the clients' moves (default 1)
+ */
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Client {
+        int fd = -1;
+        Board board;
+        std::string input;
+        Clock::time_point sentAt;
+        bool waiting = false;     // a request is out and not yet answered
+    };
+
+    int connectTo(int port, const std::string& unixPath) {
+        int fd = -1;
+        if (unixPath.empty()) {
+            fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons(static_cast<std::uint16_t>(port));
+            if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                if (fd >= 0) ::close(fd);
+                return -1;
+            }
+            int on = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        } else {
+            fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, unixPath.c_str(), sizeof(address.sun_path) - 1);
+            if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                if (fd >= 0) ::close(fd);
+                return -1;
+            }
+        }
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        return fd;
+    }
+
+    bool sendLine(Client& client, const std::string& line) {
+        client.sentAt = Clock::now();
+        client.waiting = true;
+        return ::send(client.fd, line.data(), line.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(line.size());
+    }
+
+    bool gameOver(const Board& board) {
+        return board.winCheck('X') || board.winCheck('O') || board.tieCheck();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int port = 7878;
+    std::string unixPath;
+    int connections = 100;
+    long long totalGames = 10000;
+    std::string ai = "perfect";
+    std::uint64_t seed = 1;
+
+    auto usage = [&] {
+        std::cerr << "Usage: " << argv[0] << " [--port P | --unix PATH] [--connections C]"
+                  << " [--games N] [--ai TYPE] [--seed S]\n";
+        return 2;
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--port") == 0 && hasValue) {
+            port = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--unix") == 0 && hasValue) {
+            unixPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--connections") == 0 && hasValue) {
+            connections = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--games") == 0 && hasValue) {
+            totalGames = std::atoll(argv[++i]);
+        } else if (std::strcmp(argv[i], "--ai") == 0 && hasValue) {
+            ai = argv[++i];
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            return usage();
+        }
+    }
+    if (totalGames < 1) {
+        std::cerr << "loadgen: --games must be positive\n";
+        return usage();
+    }
+
+    Rng rng(seed);
+    const std::string newGame = "NEW " + ai + "\n";
+    std::vector<Client> clients(static_cast<std::size_t>(connections));
+    std::vector<long long> latencies;   // nanoseconds
+    latencies.reserve(static_cast<std::size_t>(totalGames) * 6);
+    long long started = 0;
+    long long finished = 0;
+    long long errors = 0;
+    int open = 0;
+
+    const int epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    const auto start = Clock::now();
+
+    for (std::size_t i = 0; i < clients.size() && started < totalGames; ++i) {
+        Client& client = clients[i];
+        client.fd = connectTo(port, unixPath);
+        if (client.fd < 0) {
+            std::cerr << "loadgen: cannot connect to the server\n";
+            return 1;
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = i;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, client.fd, &event);
+        ++open;
+        ++started;
+        sendLine(client, newGame);
+    }
+
+    // Plays X's next move on the client's board and sends it
+    auto playMove = [&](Client& client) {
+        int cell = 0;
+        do {cell = rng.below(9);} while (!client.board.isValidMove(cell / 3, cell % 3));
+        client.board.applyMove(cell / 3, cell % 3, 'X');
+        return sendLine(client, "MOVE " + std::to_string(cell / 3) + " " + std::to_string(cell % 3) + "\n");
+    };
+
+    auto disconnect = [&](Client& client) {
+        ::epoll_ctl(epollFd, EPOLL_CTL_DEL, client.fd, nullptr);
+        ::close(client.fd);
+        client.fd = -1;
+        --open;
+    };
+
+    epoll_event events[256];
+    char buffer[4096];
+
+    while (open > 0) {
+        const int count = ::epoll_wait(epollFd, events, 256, -1);
+        for (int e = 0; e < count; ++e) {
+            Client& client = clients[events[e].data.u64];
+            if (client.fd < 0) continue;
+
+            const ssize_t n = ::read(client.fd, buffer, sizeof(buffer));
+            if (n <= 0) {
+                if (n < 0 && errno == EAGAIN) continue;
+                ++errors;
+                disconnect(client);
+                continue;
+            }
+            client.input.append(buffer, static_cast<std::size_t>(n));
+
+            std::size_t newline;
+            while (client.fd >= 0 && (newline = client.input.find('\n')) != std::string::npos) {
+                const std::string line = client.input.substr(0, newline);
+                client.input.erase(0, newline + 1);
+
+                if (client.waiting) {
+                    client.waiting = false;
+                    latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::now() - client.sentAt).count());
+                }
+
+                bool ok = true;
+                if (line == "OK") {
+                    client.board = Board();
+                    ok = playMove(client);
+                } else if (line.rfind("MOVE ", 0) == 0 && line.size() >= 8) {
+                    client.board.applyMove(line[5] - '0', line[7] - '0', 'O');
+                    // If that ended the game, END follows; otherwise it's our turn
+                    if (!gameOver(client.board)) {
+                        ok = playMove(client);
+                    }
+                } else if (line.rfind("END", 0) == 0) {
+                    ++finished;
+                    if (started < totalGames) {
+                        ++started;
+                        ok = sendLine(client, newGame);
+                    } else {
+                        disconnect(client);
+                    }
+                } else {
+                    std::cerr << "loadgen: server replied \"" << line << "\"\n";
+                    ok = false;
+                }
+
+                if (!ok) {
+                    ++errors;
+                    disconnect(client);
+                }
+            }
+        }
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        if (latencies.empty()) return 0.0;
+        std::size_t index = static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1));
+        return static_cast<double>(latencies[index]) / 1000.0;
+    };
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "games       " << finished << " in " << seconds << " s ("
+              << static_cast<double>(finished) / seconds << " games/s, " << connections << " connections)\n"
+              << "requests    " << latencies.size() << " ("
+              << static_cast<double>(latencies.size()) / seconds << " requests/s)\n"
+              << "latency us  p50 " << percentile(0.50) << "  p90 " << percentile(0.90)
+              << "  p99 " << percentile(0.99) << "  max " << percentile(1.0) << "\n"
+              << "errors      " << errors << "\n";
+
+    ::close(epollFd);
+    return errors == 0 ? 0 : 1;
+}
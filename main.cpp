@@ -1,15 +1,23 @@
 #include <iostream>
+#include <string>
 #include "TicTacToe.h"
 
 /**
  * Entry point for the TicTacToe program.
  * For this stage of the project, we just construct a TicTacToe object
  * and call run(), which will eventually handle the main menu and game loop.
+ *
+ * Pass --stats to print search statistics after every AI move.
  */
-int main() {
+int main(int argc, char* argv[]) {
     std::cout << "=== TicTacToe AI ===" << std::endl;
 
     TicTacToe game;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--stats") {
+            game.setSearchStatsLogging(true);
+        }
+    }
     game.run();  // Will coordinate menu, player selection, and gameplay
 
     std::cout << "Thanks for playing!" << std::endl;
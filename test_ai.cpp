@@ -6,44 +6,78 @@
 // Tests for RegularAIPlayer, UnbeatableAIPlayer, and MiniMaxAIPlayer, including
 // heavy simulations to verify Unbeatable AI never loses and MiniMax AI never loses.
 
+#include <bit>
+#include <chrono>
+#include <atomic>
 #include <iostream>
 #include <cassert>
 #include <vector>
 #include <random>
+#include <thread>
 #include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 
 #include "Board.h"
+#include "BoardBatch.h"
+#include "MNKBoard.h"
 #include "Player.h"
 #include "RegularAIPlayer.h"
 #include "UnbeatableAIPlayer.h"
 #include "MiniMaxAIPlayer.h"
-
-// Simple random-move AI for testing
+#include "RandomAIPlayer.h"
+#include "Rng.h"
+#include "Tournament.h"
+#include "TranspositionTable.h"
+#include "SolvedGame.h"
+#include "PerfectPlayer.h"
+#include "PositionDatabase.h"
+#include "ProofNumberSolver.h"
+#include "DatabaseAIPlayer.h"
+#include "GameRecord.h"
+#include "MCTSAIPlayer.h"
+#include "MetaBoard.h"
+#include "OpeningBook.h"
+#include "QubicAIPlayer.h"
+#include "QubicBoard.h"
+#include "SearchStats.h"
+#include "ThreadPool.h"
+#include "TicTacToe.h"
+
+#ifdef __linux__
+#include "GameServer.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// Allocation counting (for the game loop test)
 // ------------------------------------------------------------
-class RandomAIPlayer : public Player {
-public:
-    explicit RandomAIPlayer(char symbol)
-        : Player(symbol, "Random AI") {}
-
-    void makeMove(Board& board) override {
-        // Collect all valid moves
-        std::vector<std::pair<int, int>> moves;
-        for (int r = 0; r < 3; r++) {
-            for (int c = 0; c < 3; c++) {
-                if (board.isValidMove(r, c)) {moves.emplace_back(r, c);}
-            }
-        }
-
-        assert(!moves.empty()); // should never be called on a full board
-
-        // Choose one at random
-        static std::mt19937 rng(std::random_device{}());
-        std::uniform_int_distribution<int> dist(0, static_cast<int>(moves.size()) - 1);
+namespace {
+    std::atomic<long long> allocationCount{0};
+}
 
-        auto [row, col] = moves[dist(rng)];
-        board.applyMove(row, col, symbol);
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
     }
-};
+    throw std::bad_alloc();
+}
+
+// GCC 12 sees new and free() meet once both are inlined into a caller and
+// warns, although the replacement new above does come from malloc()
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept {std::free(p);}
+void operator delete(void* p, std::size_t) noexcept {std::free(p);}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
 
 // Helper: play one full AI vs AI game
 // Returns 'X' if X wins, 'O' if O wins, 'T' for tie.
@@ -74,6 +108,33 @@ char playAIGame(Player& xPlayer, Player& oPlayer) {
     return 'T';
 }
 
+// Helper: play `ai` against random moves on a larger board (MetaBoard,
+// QubicBoard) until the game ends. Every AI move must add exactly one piece;
+// checkAiMove(before, after) adds the board's own checks, and
+// playRandom(board, symbol) makes the random side's move.
+// Returns 'X', 'O' or 'T'.
+// ------------------------------------------------------------
+template <typename GameBoard, typename AI, typename CheckAiMove, typename PlayRandom>
+char playAgainstRandom(AI& ai, CheckAiMove checkAiMove, PlayRandom playRandom) {
+    GameBoard board;
+    char mover = 'X';
+
+    while (true) {
+        if (mover == ai.getSymbol()) {
+            const GameBoard before = board;
+            ai.makeMove(board);
+            assert(board.getFilledCells() == before.getFilledCells() + 1);
+            checkAiMove(before, board);
+        } else {
+            playRandom(board, mover);
+        }
+
+        if (board.winCheck(mover)) return mover;
+        if (board.tieCheck()) return 'T';
+        mover = (mover == 'X') ? 'O' : 'X';
+    }
+}
+
 // Basic unit tests (small, deterministic)
 // ============================================================
 void testRegularAI_CenterOnEmptyBoard() {
@@ -177,6 +238,1824 @@ void testAIs_DoNotOverwriteOccupiedCells() {
     std::cout << "PASSED\n";
 }
 
+// Visits every reachable, unfinished position (each distinct board once)
+// and calls visit(board, sideToMove).
+// ------------------------------------------------------------
+template <typename Visit>
+void forEachReachablePosition(Visit visit) {
+    std::vector<bool> seen(1u << 18, false);
+    std::vector<Board> stack{Board()};
+
+    while (!stack.empty()) {
+        Board b = stack.back();
+        stack.pop_back();
+
+        unsigned key = (static_cast<unsigned>(b.getMask('X')) << 9) | b.getMask('O');
+        if (seen[key]) {continue;}
+        seen[key] = true;
+
+        if (b.winCheck('X') || b.winCheck('O') || b.tieCheck()) {continue;}
+
+        char toMove = (b.getFilledCells() % 2 == 0) ? 'X' : 'O';
+        visit(b, toMove);
+
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                if (b.isValidMove(r, c)) {
+                    Board next = b;
+                    next.applyMove(r, c, toMove);
+                    stack.push_back(next);
+                }
+            }
+        }
+    }
+}
+
+void testMiniMax_AlphaBetaMatchesFullSearch() {
+    std::cout << "Test 5 (MiniMax): alpha-beta picks the same move as full search... ";
+
+    using Options = MiniMaxAIPlayer::SearchOptions;
+
+    Options full;
+    full.mode = MiniMaxAIPlayer::SearchMode::Full;
+
+    Options rowMajor;
+    rowMajor.ordering = MiniMaxAIPlayer::MoveOrdering::RowMajor;
+
+    Options ordered;  // defaults: alpha-beta, center/corners/edges
+
+    Options heuristics;
+    heuristics.killerMoves = true;
+    heuristics.historyHeuristic = true;
+
+    int positions = 0;
+    forEachReachablePosition([&](const Board& start, char toMove) {
+        Board expected = start;
+        MiniMaxAIPlayer reference(toMove, full);
+        reference.makeMove(expected);
+
+        for (const Options& opts : {rowMajor, ordered, heuristics}) {
+            Board actual = start;
+            MiniMaxAIPlayer ai(toMove, opts);
+            ai.makeMove(actual);
+
+            assert(actual.getMask('X') == expected.getMask('X'));
+            assert(actual.getMask('O') == expected.getMask('O'));
+        }
+        positions++;
+    });
+
+    std::cout << "PASSED (" << positions << " positions)\n";
+}
+
+void testMiniMax_AlphaBetaPrunesEmptyBoard() {
+    std::cout << "Test 6 (MiniMax): alpha-beta node counts on the empty board... ";
+
+    MiniMaxAIPlayer::SearchOptions full;
+    full.mode = MiniMaxAIPlayer::SearchMode::Full;
+
+    MiniMaxAIPlayer::SearchOptions heuristics;
+    heuristics.killerMoves = true;
+    heuristics.historyHeuristic = true;
+
+    Board b1, b2, b3;
+    MiniMaxAIPlayer fullAI('X', full);
+    MiniMaxAIPlayer orderedAI('X');
+    MiniMaxAIPlayer heuristicAI('X', heuristics);
+
+    fullAI.makeMove(b1);
+    orderedAI.makeMove(b2);
+    heuristicAI.makeMove(b3);
+
+    // At least an order of magnitude fewer nodes than the full tree
+    assert(orderedAI.getLastNodeCount() * 10 < fullAI.getLastNodeCount());
+    assert(heuristicAI.getLastNodeCount() * 10 < fullAI.getLastNodeCount());
+
+    std::cout << "PASSED (full: " << fullAI.getLastNodeCount()
+              << ", ordered: " << orderedAI.getLastNodeCount()
+              << ", killer+history: " << heuristicAI.getLastNodeCount() << ")\n";
+}
+
+void testMiniMax_TranspositionTable() {
+    std::cout << "Test 7 (MiniMax): transposition table keeps moves and is reused... ";
+
+    // Symmetric boards share one canonical key
+    {
+        Board corner, rotated;
+        corner.applyMove(0, 0, 'X');
+        corner.applyMove(1, 2, 'O');
+        rotated.applyMove(2, 2, 'X');   // same position rotated 180 degrees
+        rotated.applyMove(1, 0, 'O');
+
+        int s1 = 0, s2 = 0;
+        assert(TranspositionTable::canonicalKey(corner, s1) ==
+               TranspositionTable::canonicalKey(rotated, s2));
+    }
+
+    // One table shared by every X and O player still gives the full-search move
+    TranspositionTable table(1024);
+    MiniMaxAIPlayer::SearchOptions full;
+    full.mode = MiniMaxAIPlayer::SearchMode::Full;
+    MiniMaxAIPlayer::SearchOptions cached;
+    cached.table = &table;
+
+    forEachReachablePosition([&](const Board& start, char toMove) {
+        Board expected = start;
+        MiniMaxAIPlayer reference(toMove, full);
+        reference.makeMove(expected);
+
+        Board actual = start;
+        MiniMaxAIPlayer ai(toMove, cached);
+        ai.makeMove(actual);
+
+        assert(actual.getMask('X') == expected.getMask('X'));
+        assert(actual.getMask('O') == expected.getMask('O'));
+    });
+
+    // A second opening search on a warm table costs almost nothing
+    TranspositionTable fresh(1024);
+    MiniMaxAIPlayer::SearchOptions opts;
+    opts.table = &fresh;
+    MiniMaxAIPlayer first('X', opts);
+    MiniMaxAIPlayer second('X', opts);
+
+    Board b1, b2;
+    first.makeMove(b1);
+    second.makeMove(b2);
+
+    assert(b1.getMask('X') == b2.getMask('X'));
+    assert(second.getLastNodeCount() * 10 < first.getLastNodeCount());
+    assert(fresh.capacity() == 1024);
+    assert(fresh.size() > 0 && fresh.size() <= fresh.capacity());
+    assert(fresh.hitRate() > 0.0 && fresh.hitRate() <= 1.0);
+    assert(fresh.memoryBytes() >= fresh.capacity() * sizeof(std::uint64_t));
+
+    std::cout << "PASSED (first: " << first.getLastNodeCount()
+              << " nodes, second: " << second.getLastNodeCount()
+              << " nodes, " << fresh.size() << " entries, hit rate "
+              << fresh.hitRate() << ")\n";
+}
+
+// Returns the cell (row * 3 + col) that `after` filled compared to `before`
+int movedCell(const Board& before, const Board& after) {
+    unsigned diff = before.getOccupiedMask() ^ after.getOccupiedMask();
+    assert(diff != 0 && (diff & (diff - 1)) == 0);   // exactly one new piece
+    int cell = 0;
+    while (!(diff & (1u << cell))) {cell++;}
+    return cell;
+}
+
+void testSolvedGame_MatchesMiniMaxAndPerfectPlayer() {
+    std::cout << "Test 8 (SolvedGame): MiniMax and PerfectPlayer agree with the table... ";
+
+    int positions = 0;
+    forEachReachablePosition([&](const Board& start, char toMove) {
+        SolvedGame::Entry entry = SolvedGame::lookup(start);
+        assert(entry.reachable && !entry.terminal);
+
+        Board viaMiniMax = start;
+        MiniMaxAIPlayer miniMax(toMove);
+        miniMax.makeMove(viaMiniMax);
+
+        Board viaTable = start;
+        PerfectPlayer perfect(toMove);
+        perfect.makeMove(viaTable);
+
+        int cell = movedCell(start, viaMiniMax);
+        assert(entry.bestMoves & (1u << cell));
+        assert(entry.optimalMoves & (1u << cell));
+        assert(movedCell(start, viaTable) == cell);
+        positions++;
+    });
+
+    // Every non-terminal reachable position was checked
+    assert(positions == 4520);
+
+    std::cout << "PASSED (" << positions << " positions)\n";
+}
+
+void testSolvedGame_UnbeatableNeverGivesUpValue() {
+    std::cout << "Test 9 (SolvedGame): Unbeatable never gives up a draw or win... ";
+
+    // Walk every position where Unbeatable plays one side and the opponent
+    // plays anything. At each of Unbeatable's turns its move must keep the
+    // game-theoretic value of the position.
+    int checked = 0;
+    for (char me : {'X', 'O'}) {
+        std::vector<Board> stack{Board()};
+        while (!stack.empty()) {
+            Board b = stack.back();
+            stack.pop_back();
+            if (b.winCheck('X') || b.winCheck('O') || b.tieCheck()) {continue;}
+
+            char toMove = (b.getFilledCells() % 2 == 0) ? 'X' : 'O';
+            if (toMove == me) {
+                Board next = b;
+                UnbeatableAIPlayer ai(me);
+                ai.makeMove(next);
+
+                SolvedGame::Entry entry = SolvedGame::lookup(b);
+                assert(entry.optimalMoves & (1u << movedCell(b, next)));
+                checked++;
+                stack.push_back(next);
+            } else {
+                for (int cell = 0; cell < 9; cell++) {
+                    if (b.isValidMove(cell / 3, cell % 3)) {
+                        Board next = b;
+                        next.applyMove(cell / 3, cell % 3, toMove);
+                        stack.push_back(next);
+                    }
+                }
+            }
+        }
+    }
+
+    std::cout << "PASSED (" << checked << " decisions)\n";
+}
+
+void testMNK_HelpersAndMiniMax() {
+    std::cout << "Test 10 (MNK): AI helpers and MiniMax on m,n,k boards... ";
+
+    // MiniMax on a 3x3, k = 3 MNKBoard picks the same moves as on Board
+    int positions = 0;
+    forEachReachablePosition([&](const Board& start, char toMove) {
+        if (start.getFilledCells() < 2) {return;}   // keep the exhaustive search quick
+
+        MNKBoard mnk;
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                if (start.getCellValue(r, c) != ' ') {
+                    mnk.applyMove(r, c, start.getCellValue(r, c));
+                }
+            }
+        }
+
+        Board b = start;
+        MiniMaxAIPlayer ai(toMove);
+        ai.makeMove(b);
+        ai.makeMove(mnk);
+
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                assert(mnk.getCellValue(r, c) == b.getCellValue(r, c));
+            }
+        }
+        positions++;
+    });
+
+    // Gomoku: Regular AI finishes its own five before blocking
+    {
+        MNKBoard g(15, 15, 5);
+        for (int c = 3; c < 7; c++) {
+            g.applyMove(7, c, 'X');      // X X X X at (7,3)-(7,6)
+            g.applyMove(2, c + 5, 'O');  // O O O O at (2,8)-(2,11)
+        }
+        RegularAIPlayer ai('X');
+        ai.makeMove(g);
+        assert(g.winCheck('X'));
+    }
+
+    // Gomoku: Regular AI blocks an open four and takes the center when quiet
+    {
+        MNKBoard g(15, 15, 5);
+        for (int r = 0; r < 4; r++) {
+            g.applyMove(r, 0, 'O');
+        }
+        RegularAIPlayer ai('X');
+        ai.makeMove(g);
+        assert(g.getCellValue(4, 0) == 'X');
+
+        MNKBoard empty(15, 15, 5);
+        ai.makeMove(empty);
+        assert(empty.getCellValue(7, 7) == 'X');
+    }
+
+    std::cout << "PASSED (" << positions << " positions)\n";
+}
+
+void testTournament_MultithreadedMatrix() {
+    std::cout << "Test 11 (Tournament): threaded W/L/D matrix... ";
+
+    using Type = Tournament::PlayerType;
+
+    Tournament::Config config;
+    config.gamesPerPairing = 200;
+    config.threads = 4;
+    config.chunkSize = 50;
+    config.seed = 42;
+
+    Tournament t(config);
+    t.run();
+
+    const int types = Tournament::PLAYER_TYPE_COUNT;
+    assert(t.totalGames() == 200LL * types * types);
+
+    for (int x = 0; x < types; x++) {
+        for (int o = 0; o < types; o++) {
+            const auto& r = t.result(static_cast<Type>(x), static_cast<Type>(o));
+            assert(r.games() == 200);
+        }
+    }
+
+    // The perfect players never lose, whichever side they play
+    for (Type strong : {Type::Unbeatable, Type::MiniMax, Type::Perfect}) {
+        for (int other = 0; other < types; other++) {
+            assert(t.result(strong, static_cast<Type>(other)).oWins == 0);
+            assert(t.result(static_cast<Type>(other), strong).xWins == 0);
+        }
+    }
+
+    // Same seed, different thread count: the whole matrix is identical
+    config.threads = 1;
+    Tournament single(config);
+    single.run();
+    for (int x = 0; x < types; x++) {
+        for (int o = 0; o < types; o++) {
+            const auto& a = t.result(static_cast<Type>(x), static_cast<Type>(o));
+            const auto& b = single.result(static_cast<Type>(x), static_cast<Type>(o));
+            assert(a.xWins == b.xWins && a.oWins == b.oWins && a.draws == b.draws);
+        }
+    }
+
+    std::cout << "PASSED (" << static_cast<long long>(t.gamesPerSecond()) << " games/s)\n";
+}
+
+void testRng_SeededPlayersReplayGames() {
+    std::cout << "Test 12 (Rng): seeded players replay the same games... ";
+
+    // Two independent runs with the same seeds produce identical move sequences
+    auto playSeededGames = [](std::uint64_t seed) {
+        RegularAIPlayer x('X');
+        RandomAIPlayer o('O', seed + 1);
+        x.setSeed(seed);
+
+        std::vector<unsigned> finalBoards;
+        for (int i = 0; i < 200; i++) {
+            Board b;
+            Player* current = &x;
+            while (!b.winCheck('X') && !b.winCheck('O') && !b.tieCheck()) {
+                current->makeMove(b);
+                current = (current == &x) ? static_cast<Player*>(&o) : &x;
+            }
+            finalBoards.push_back((static_cast<unsigned>(b.getMask('X')) << 9) | b.getMask('O'));
+        }
+        return finalBoards;
+    };
+
+    assert(playSeededGames(7) == playSeededGames(7));
+    assert(playSeededGames(7) != playSeededGames(8));
+
+    // below() stays in range and reaches every value
+    Rng rng(123);
+    int seen[9] = {};
+    for (int i = 0; i < 9000; i++) {
+        int v = rng.below(9);
+        assert(v >= 0 && v < 9);
+        seen[v]++;
+    }
+    for (int count : seen) {assert(count > 700);}
+
+    std::cout << "PASSED\n";
+}
+
+void testSearchStats_MiniMaxReportsWork() {
+    std::cout << "Test 13 (SearchStats): MiniMax reports nodes, depth and its expected line... ";
+
+    // Full search from the empty board: the PV starts with the move played and
+    // is a legal line all the way to the end of the game
+    MiniMaxAIPlayer::SearchOptions full;
+    full.mode = MiniMaxAIPlayer::SearchMode::Full;
+    MiniMaxAIPlayer fullAI('X', full);
+
+    Board start;
+    Board played = start;
+    fullAI.makeMove(played);
+    const SearchStats& stats = fullAI.getLastSearchStats();
+
+    assert(stats.nodes == fullAI.getLastNodeCount());
+    assert(stats.leafEvaluations > 0 && stats.leafEvaluations < stats.nodes);
+    assert(stats.maxDepth == 9);
+    assert(stats.tableProbes == 0 && stats.tableHits == 0);
+    assert(!stats.principalVariation.empty());
+
+    int first = stats.principalVariation.front().first * 3 + stats.principalVariation.front().second;
+    assert(first == movedCell(start, played));
+
+    Board line;
+    char mover = 'X';
+    for (const auto& move : stats.principalVariation) {
+        assert(!line.winCheck('X') && !line.winCheck('O'));
+        assert(line.isValidMove(move.first, move.second));
+        line.applyMove(move.first, move.second, mover);
+        mover = (mover == 'X') ? 'O' : 'X';
+    }
+    assert(line.winCheck('X') || line.winCheck('O') || line.tieCheck());
+
+    // With a table the probes and hits are counted, and the next move's stats replace these
+    TranspositionTable table(1024);
+    MiniMaxAIPlayer::SearchOptions cached;
+    cached.table = &table;
+    MiniMaxAIPlayer cachedAI('O', cached);
+
+    cachedAI.makeMove(played);
+    assert(cachedAI.getLastSearchStats().tableProbes > 0);
+    assert(cachedAI.getLastSearchStats().tableHits > 0);
+    assert(cachedAI.getLastSearchStats().tableHits <= cachedAI.getLastSearchStats().tableProbes);
+
+    long long firstNodes = cachedAI.getLastSearchStats().nodes;
+    Board again = start;
+    again.applyMove(1, 1, 'X');
+    cachedAI.makeMove(again);
+    assert(cachedAI.getLastSearchStats().nodes < firstNodes);
+    assert(!cachedAI.getLastSearchStats().principalVariation.empty());
+
+    // MNK search fills the same stats
+    MNKBoard mnk(3, 3, 3);
+    mnk.applyMove(0, 0, 'X');
+    MiniMaxAIPlayer mnkAI('O');
+    mnkAI.makeMove(mnk);
+    const SearchStats& mnkStats = mnkAI.getLastSearchStats();
+    assert(mnkStats.nodes > 0 && mnkStats.maxDepth > 0);
+    assert(mnkStats.principalVariation.front() ==
+           std::make_pair(mnk.getLastRow(), mnk.getLastCol()));
+
+    // Rule-based players don't search
+    RegularAIPlayer regular('X');
+    Board r;
+    regular.makeMove(r);
+    assert(regular.getLastSearchStats().nodes == 0);
+
+    std::cout << "PASSED (" << stats << ")\n";
+}
+
+void testMiniMax_ParallelRootSplit() {
+    std::cout << "Test 14 (MiniMax): parallel root search returns the serial move... ";
+
+    ThreadPool pool(4);
+    TranspositionTable table(1024);
+
+    MiniMaxAIPlayer::SearchOptions parallel;
+    parallel.pool = &pool;
+    MiniMaxAIPlayer::SearchOptions parallelCached = parallel;
+    parallelCached.table = &table;
+
+    int positions = 0;
+    forEachReachablePosition([&](const Board& start, char toMove) {
+        Board expected = start;
+        MiniMaxAIPlayer serial(toMove);
+        serial.makeMove(expected);
+
+        Board viaPool = start;
+        MiniMaxAIPlayer ai(toMove, parallel);
+        ai.makeMove(viaPool);
+        assert(viaPool.getMask('X') == expected.getMask('X'));
+        assert(viaPool.getMask('O') == expected.getMask('O'));
+
+        // The PV still starts with the move played
+        const auto& pv = ai.getLastSearchStats().principalVariation;
+        assert(!pv.empty() && pv.front().first * 3 + pv.front().second == movedCell(start, viaPool));
+
+        Board viaPoolAndTable = start;
+        MiniMaxAIPlayer cached(toMove, parallelCached);
+        cached.makeMove(viaPoolAndTable);
+        assert(viaPoolAndTable.getMask('X') == expected.getMask('X'));
+        assert(viaPoolAndTable.getMask('O') == expected.getMask('O'));
+        positions++;
+    });
+
+    // 4x4, k = 4 from a few stones in: same move as the serial search
+    MNKBoard start(4, 4, 4);
+    start.applyMove(1, 1, 'X');
+    start.applyMove(2, 2, 'O');
+    start.applyMove(1, 2, 'X');
+    start.applyMove(0, 0, 'O');
+
+    MNKBoard serialBoard = start;
+    MiniMaxAIPlayer serial('X');
+    serial.makeMove(serialBoard);
+
+    MNKBoard parallelBoard = start;
+    MiniMaxAIPlayer ai('X', parallel);
+    ai.makeMove(parallelBoard);
+    assert(parallelBoard.getLastRow() == serialBoard.getLastRow());
+    assert(parallelBoard.getLastCol() == serialBoard.getLastCol());
+
+    // A player may search from inside one of its own pool's jobs (the
+    // tournament does this) without waiting on itself forever
+    ThreadPool single(1);
+    MiniMaxAIPlayer::SearchOptions nested;
+    nested.pool = &single;
+    Board fromJob;
+    single.submit([&] {
+        MiniMaxAIPlayer inner('X', nested);
+        inner.makeMove(fromJob);
+    });
+    single.waitIdle();
+    assert(fromJob.getFilledCells() == 1);
+
+    std::cout << "PASSED (" << positions << " positions, " << pool.size() << " threads)\n";
+}
+
+void testMiniMax_IterativeDeepeningBudgets() {
+    std::cout << "Test 15 (MiniMax): iterative deepening respects time, node and depth budgets... ";
+
+    // Deep enough to reach the end of the game: same moves as the exhaustive search
+    MiniMaxAIPlayer::SearchOptions deep;
+    deep.depthLimit = 9;
+
+    int positions = 0;
+    forEachReachablePosition([&](const Board& start, char toMove) {
+        if (start.getFilledCells() < 3) {return;}   // keep the exhaustive search quick
+
+        MNKBoard mnk;
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                if (start.getCellValue(r, c) != ' ') {
+                    mnk.applyMove(r, c, start.getCellValue(r, c));
+                }
+            }
+        }
+
+        MNKBoard expected = mnk;
+        MiniMaxAIPlayer exhaustive(toMove);
+        exhaustive.makeMove(expected);
+
+        MiniMaxAIPlayer iterative(toMove, deep);
+        iterative.makeMove(mnk);
+        assert(mnk.getLastRow() == expected.getLastRow());
+        assert(mnk.getLastCol() == expected.getLastCol());
+        positions++;
+    });
+
+    // Gomoku with a time budget: answers in time, and still takes a win
+    {
+        MNKBoard g(15, 15, 5);
+        for (int c = 3; c < 7; c++) {
+            g.applyMove(7, c, 'X');      // X X X X at (7,3)-(7,6)
+            g.applyMove(2, c + 5, 'O');  // O O O O at (2,8)-(2,11)
+        }
+
+        MiniMaxAIPlayer::SearchOptions timed;
+        timed.timeBudget = std::chrono::milliseconds(20);
+        MiniMaxAIPlayer ai('X', timed);
+        ai.makeMove(g);
+
+        assert(g.winCheck('X'));
+        assert(ai.getLastSearchStats().completedDepth >= 1);
+        assert(ai.getLastSearchStats().elapsed < std::chrono::milliseconds(250));
+    }
+
+    // Two plies are enough to see the open four and block it
+    {
+        MNKBoard g(15, 15, 5);
+        g.applyMove(7, 7, 'X');
+        for (int r = 0; r < 4; r++) {
+            g.applyMove(r, 0, 'O');
+            if (r < 3) g.applyMove(10, 10 + r, 'X');
+        }
+
+        MiniMaxAIPlayer::SearchOptions shallow;
+        shallow.depthLimit = 2;
+        MiniMaxAIPlayer ai('X', shallow);
+        ai.makeMove(g);
+
+        assert(g.getCellValue(4, 0) == 'X');
+        assert(ai.getLastSearchStats().completedDepth == 2);
+    }
+
+    // A node budget makes the result repeatable, move for move and node for node
+    {
+        MNKBoard start(15, 15, 5);
+        start.applyMove(7, 7, 'X');
+        start.applyMove(7, 8, 'O');
+        start.applyMove(8, 8, 'X');
+
+        MiniMaxAIPlayer::SearchOptions counted;
+        counted.nodeBudget = 20000;
+        MiniMaxAIPlayer first('O', counted);
+        MiniMaxAIPlayer second('O', counted);
+
+        MNKBoard a = start;
+        MNKBoard b = start;
+        first.makeMove(a);
+        second.makeMove(b);
+
+        assert(a.getLastRow() == b.getLastRow() && a.getLastCol() == b.getLastCol());
+        assert(first.getLastNodeCount() == second.getLastNodeCount());
+        assert(first.getLastSearchStats().completedDepth >= 1);
+        assert(first.getLastNodeCount() < 21000);   // budget is checked every few dozen nodes
+    }
+
+    std::cout << "PASSED (" << positions << " positions)\n";
+}
+
+void testMCTS_PlaysSoundlyAndScales() {
+    std::cout << "Test 16 (MCTS): takes wins, holds perfect play to draws, reuses its tree... ";
+
+    MCTSAIPlayer::Options options;
+    options.playouts = 5000;
+
+    // Takes an immediate win over a block
+    {
+        Board b;
+        b.applyMove(0, 0, 'X');
+        b.applyMove(1, 0, 'O');
+        b.applyMove(0, 1, 'X');
+        b.applyMove(1, 1, 'O');
+
+        MCTSAIPlayer ai('X', options);
+        ai.setSeed(1);
+        ai.makeMove(b);
+        assert(b.winCheck('X'));
+    }
+
+    // Seeded games against the solved table are all draws, from either side
+    for (std::uint64_t seed = 0; seed < 10; seed++) {
+        MCTSAIPlayer x('X', options);
+        MCTSAIPlayer o('O', options);
+        PerfectPlayer perfectX('X');
+        PerfectPlayer perfectO('O');
+        x.setSeed(seed);
+        o.setSeed(seed);
+
+        assert(playAIGame(x, perfectO) == 'T');
+        assert(playAIGame(perfectX, o) == 'T');
+    }
+
+    // The subtree under the opponent's reply is kept for the next move
+    {
+        MCTSAIPlayer ai('X', options);
+        ai.setSeed(3);
+        Board b;
+        ai.makeMove(b);
+        assert(ai.getReusedNodeCount() == 0);
+        assert(ai.getLastSearchStats().playouts == options.playouts);
+        assert(ai.getLastSearchStats().playoutsPerSecond() > 0.0);
+
+        // Reply with the most likely answer, which the tree has explored most
+        const auto& pv = ai.getLastSearchStats().principalVariation;
+        assert(pv.size() >= 2);
+        b.applyMove(pv[1].first, pv[1].second, 'O');
+        ai.makeMove(b);
+        assert(ai.getReusedNodeCount() > 1);
+
+        // An unrelated position starts over
+        Board other;
+        other.applyMove(2, 2, 'O');
+        ai.makeMove(other);
+        assert(ai.getReusedNodeCount() == 0);
+    }
+
+    // Root-parallel on Gomoku: same seed, same move; the playout budget is shared out
+    {
+        ThreadPool pool(3);
+        MCTSAIPlayer::Options parallel;
+        parallel.playouts = 2000;
+        parallel.pool = &pool;
+
+        MCTSAIPlayer first('O', parallel);
+        MCTSAIPlayer second('O', parallel);
+        first.setSeed(5);
+        second.setSeed(5);
+
+        MNKBoard a(15, 15, 5);
+        MNKBoard b(15, 15, 5);
+        a.applyMove(7, 7, 'X');
+        b.applyMove(7, 7, 'X');
+        first.makeMove(a);
+        second.makeMove(b);
+
+        assert(a.getLastRow() == b.getLastRow() && a.getLastCol() == b.getLastCol());
+        assert(first.getLastSearchStats().playouts == parallel.playouts);
+    }
+
+    // A time budget bounds the move time
+    {
+        MCTSAIPlayer::Options timed;
+        timed.timeBudget = std::chrono::milliseconds(20);
+        MCTSAIPlayer ai('O', timed);
+
+        MNKBoard g(15, 15, 5);
+        g.applyMove(7, 7, 'X');
+        ai.makeMove(g);
+        assert(g.getFilledCells() == 2);
+        assert(ai.getLastSearchStats().playouts > 0);
+        assert(ai.getLastSearchStats().elapsed < std::chrono::milliseconds(250));
+    }
+
+    std::cout << "PASSED\n";
+}
+
+void testMiniMax_BatchEvaluation() {
+    std::cout << "Test 17 (MiniMax): batch evaluation agrees with the solved game... ";
+
+    std::vector<Board> positions;
+    forEachReachablePosition([&](const Board& start, char) {
+        positions.push_back(start);
+    });
+
+    // A finished game: O just lost, nothing left to play
+    Board xWon;
+    xWon.applyMove(0, 0, 'X');
+    xWon.applyMove(1, 0, 'O');
+    xWon.applyMove(0, 1, 'X');
+    xWon.applyMove(1, 1, 'O');
+    xWon.applyMove(0, 2, 'X');
+    positions.push_back(xWon);
+
+    ThreadPool pool(4);
+    TranspositionTable table(4096);
+    MiniMaxAIPlayer::SearchOptions options;
+    options.pool = &pool;
+    options.table = &table;
+
+    std::vector<MiniMaxAIPlayer::Evaluation> results(positions.size());
+    MiniMaxAIPlayer analyser('X', options);
+    analyser.evaluateBatch(positions.data(), positions.size(), results.data());
+
+    for (std::size_t i = 0; i < positions.size(); i++) {
+        SolvedGame::Entry entry = SolvedGame::lookup(positions[i]);
+        assert(results[i].score == entry.score);
+
+        if (entry.terminal) {
+            assert(results[i].bestMove == -1);
+        } else {
+            // Ties go to the lowest cell, as in makeMove()
+            assert(results[i].bestMove == std::countr_zero(static_cast<unsigned>(entry.bestMoves)));
+        }
+    }
+    assert(results.back().score == -10 + 5);
+
+    // The whole batch shared the table and is counted in the stats
+    const SearchStats& stats = analyser.getLastSearchStats();
+    assert(stats.nodes > 0 && stats.tableProbes > 0 && stats.tableHits > 0);
+    assert(stats.principalVariation.empty());
+
+    // Without a pool or table: same answers, one position at a time
+    MiniMaxAIPlayer serial('O');
+    for (std::size_t i = 0; i < positions.size(); i += 97) {
+        MiniMaxAIPlayer::Evaluation single = serial.evaluate(positions[i]);
+        assert(single.score == results[i].score);
+        assert(single.bestMove == results[i].bestMove);
+    }
+
+    // An empty batch is fine too
+    analyser.evaluateBatch(nullptr, 0, nullptr);
+    assert(analyser.getLastSearchStats().nodes == 0);
+
+    std::cout << "PASSED (" << positions.size() << " positions, " << pool.size() << " threads)\n";
+}
+
+void testPositionDatabase_BuildMapAndPlay() {
+    std::cout << "Test 18 (PositionDatabase): built file matches the solved game, player uses it... ";
+
+    const std::string path = (std::filesystem::temp_directory_path() / "ai_tests_3x3k3.mnkdb").string();
+    std::string error;
+    PositionDatabase::BuildInfo info;
+    bool built = PositionDatabase::build(3, 3, 3, path, error, &info);
+    assert(built && error.empty());
+
+    // 765 positions up to rotation and reflection
+    PositionDatabase db;
+    bool opened = db.open(path);
+    assert(opened && db.isOpen());
+    assert(db.size() == 765 && info.positions == 765);
+    assert(db.fileBytes() == info.fileBytes);
+    assert(db.getRows() == 3 && db.getCols() == 3 && db.getK() == 3);
+
+    // Every reachable position, in every orientation, agrees with SolvedGame
+    PerfectPlayer perfectX('X');
+    PerfectPlayer perfectO('O');
+    DatabaseAIPlayer fromDbX('X', db);
+    DatabaseAIPlayer fromDbO('O', db);
+    int positions = 0;
+    forEachReachablePosition([&](const Board& start, char toMove) {
+        SolvedGame::Entry expected = SolvedGame::lookup(start);
+        PositionDatabase::Entry entry;
+        bool found = db.lookup(start, entry);
+        assert(found && !entry.terminal);
+        assert(entry.score == expected.score);
+        assert(entry.bestMoves == expected.bestMoves);
+
+        Board viaDb = start;
+        Board viaTable = start;
+        (toMove == 'X' ? fromDbX : fromDbO).makeMove(viaDb);
+        (toMove == 'X' ? perfectX : perfectO).makeMove(viaTable);
+        assert(movedCell(start, viaDb) == movedCell(start, viaTable));
+        positions++;
+    });
+    assert(positions == 4520);
+    assert(fromDbX.getLastSearchStats().tableHits == 1);
+
+    // Finished games are stored too
+    Board xWon;
+    xWon.applyMove(0, 0, 'X');
+    xWon.applyMove(1, 0, 'O');
+    xWon.applyMove(0, 1, 'X');
+    xWon.applyMove(1, 1, 'O');
+    xWon.applyMove(0, 2, 'X');
+    PositionDatabase::Entry finished;
+    bool found = db.lookup(xWon, finished);
+    assert(found && finished.terminal && finished.score == -10 + 5 && finished.bestMoves == 0);
+
+    // Unreachable positions (two X moves in a row) aren't
+    Board illegal;
+    illegal.applyMove(0, 0, 'X');
+    illegal.applyMove(2, 2, 'X');
+    assert(!db.lookup(illegal, finished));
+
+    // A second mapping of the same file sees the same data
+    PositionDatabase again;
+    opened = again.open(path);
+    assert(opened && again.size() == db.size());
+
+    // Bad files are rejected with a reason, never mapped half-checked
+    PositionDatabase bad;
+    opened = bad.open(path + ".missing");
+    assert(!opened && !bad.isOpen() && !bad.getError().empty());
+    {
+        std::ofstream truncated(path + ".short", std::ios::binary);
+        truncated << "MNKSOLV";
+    }
+    opened = bad.open(path + ".short");
+    assert(!opened && !bad.isOpen());
+    std::filesystem::remove(path + ".short");
+
+    // A rectangular board (4 symmetries): same moves as MiniMax from a few stones in
+    const std::string rectPath = (std::filesystem::temp_directory_path() / "ai_tests_3x4k3.mnkdb").string();
+    built = PositionDatabase::build(3, 4, 3, rectPath, error);
+    assert(built);
+    PositionDatabase rect;
+    opened = rect.open(rectPath);
+    assert(opened);
+
+    Rng rng(7);
+    for (int game = 0; game < 20; game++) {
+        MNKBoard b(3, 4, 3);
+        char toMove = 'X';
+        for (int i = 0; i < 4; i++) {
+            int cell = 0;
+            do {cell = static_cast<int>(rng.below(12));} while (!b.isValidMove(cell / 4, cell % 4));
+            b.applyMove(cell / 4, cell % 4, toMove);
+            toMove = (toMove == 'X') ? 'O' : 'X';
+        }
+        if (b.winCheck('X') || b.winCheck('O')) {continue;}
+
+        MNKBoard viaDb = b;
+        MNKBoard viaSearch = b;
+        DatabaseAIPlayer dbPlayer(toMove, rect);
+        MiniMaxAIPlayer search(toMove);
+        dbPlayer.makeMove(viaDb);
+        search.makeMove(viaSearch);
+        assert(viaDb.getLastRow() == viaSearch.getLastRow());
+        assert(viaDb.getLastCol() == viaSearch.getLastCol());
+    }
+
+    // Another board size isn't answered from this file: the player falls back
+    MNKBoard otherSize(4, 4, 3);
+    PositionDatabase::Entry none;
+    assert(!rect.lookup(otherSize, none));
+    DatabaseAIPlayer fallback('X', rect);
+    fallback.makeMove(otherSize);
+    assert(otherSize.getFilledCells() == 1 && fallback.getLastSearchStats().tableHits == 0);
+
+    // Same on a 3x3 board: the default strategy takes the win, not a random cell
+    Board notInRect;
+    notInRect.applyMove(0, 0, 'X');
+    notInRect.applyMove(1, 0, 'O');
+    notInRect.applyMove(0, 1, 'X');
+    notInRect.applyMove(1, 1, 'O');
+    fallback.makeMove(notInRect);
+    assert(notInRect.winCheck('X') && fallback.getLastSearchStats().tableHits == 0);
+
+    db.close();
+    again.close();
+    rect.close();
+    std::filesystem::remove(path);
+    std::filesystem::remove(rectPath);
+
+    std::cout << "PASSED (" << positions << " positions, " << info.fileBytes << " bytes)\n";
+}
+
+#ifdef __linux__
+// Blocking client helpers for the game server test
+int connectToServer(const std::string& path) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    int result = ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    assert(fd >= 0 && result == 0);
+    return fd;
+}
+
+void sendLine(int fd, const std::string& line) {
+    std::string text = line + "\n";
+    ssize_t sent = ::send(fd, text.data(), text.size(), MSG_NOSIGNAL);
+    assert(sent == static_cast<ssize_t>(text.size()));
+}
+
+std::string readLine(int fd) {
+    std::string line;
+    char c = 0;
+    while (::read(fd, &c, 1) == 1 && c != '\n') {
+        line += c;
+    }
+    return line;
+}
+
+void testGameServer_ConcurrentGames() {
+    std::cout << "Test 19 (GameServer): plays games over a socket, many at once... ";
+
+    GameServer::Config config;
+    config.unixPath = (std::filesystem::temp_directory_path() / "ai_tests_server.sock").string();
+    config.threads = 2;
+    config.maxConnections = 300;
+
+    GameServer server(config);
+    std::string error;
+    bool started = server.start(error);
+    assert(started);
+    std::thread loop([&] {server.run();});
+
+    // One full game as X against Perfect: every reply is PerfectPlayer's move
+    int fd = connectToServer(config.unixPath);
+    sendLine(fd, "BOARD");
+    assert(readLine(fd) == "BOARD .........");
+    sendLine(fd, "MOVE 1 1");
+    assert(readLine(fd) == "ERR no game in progress");
+    sendLine(fd, "NEW perfect");
+    assert(readLine(fd) == "OK");
+
+    Board mirror;
+    PerfectPlayer reference('O');
+    std::string end;
+    while (end.empty()) {
+        int cell = 0;
+        while (!mirror.isValidMove(cell / 3, cell % 3)) {cell++;}
+        mirror.applyMove(cell / 3, cell % 3, 'X');
+        sendLine(fd, "MOVE " + std::to_string(cell / 3) + " " + std::to_string(cell % 3));
+
+        if (mirror.winCheck('X') || mirror.tieCheck()) {
+            end = readLine(fd);
+            break;
+        }
+
+        Board expected = mirror;
+        reference.makeMove(expected);
+        int aiCell = movedCell(mirror, expected);
+        assert(readLine(fd) == "MOVE " + std::to_string(aiCell / 3) + " " + std::to_string(aiCell % 3));
+        mirror = expected;
+        if (mirror.winCheck('O') || mirror.tieCheck()) {
+            end = readLine(fd);
+        }
+    }
+    // Row-major first moves lose to perfect play
+    assert(end == "END O");
+
+    sendLine(fd, "BOARD");
+    assert(readLine(fd).size() == 15);
+    sendLine(fd, "NEW nobody");
+    assert(readLine(fd).rfind("ERR unknown AI", 0) == 0);
+    sendLine(fd, "NEW perfect");
+    assert(readLine(fd) == "OK");
+    sendLine(fd, "MOVE 3 0");
+    assert(readLine(fd) == "ERR illegal move");
+    sendLine(fd, "DANCE");
+    assert(readLine(fd) == "ERR unknown command");
+    sendLine(fd, std::string(200, 'A'));
+    assert(readLine(fd) == "ERR line too long");
+    sendLine(fd, "QUIT");
+    assert(readLine(fd).empty());   // closed
+    ::close(fd);
+
+    // 200 games at once, the AI moving first in each: MiniMax always opens in the corner
+    std::vector<int> clients;
+    for (int i = 0; i < 200; i++) {
+        clients.push_back(connectToServer(config.unixPath));
+        sendLine(clients.back(), "NEW minimax O");
+    }
+    // Some clients hang up while the AI is still thinking
+    for (int i = 0; i < 20; i++) {
+        int quitter = connectToServer(config.unixPath);
+        sendLine(quitter, "NEW minimax O");
+        ::close(quitter);
+    }
+    for (int client : clients) {
+        assert(readLine(client) == "OK");
+        assert(readLine(client) == "MOVE 0 0");
+        ::close(client);
+    }
+
+    // A client that floods BOARD and never reads: the server stops reading it
+    // while replies wait and drops it once they pass the limit, rather than
+    // queueing replies without end, and carries on serving everyone else
+    int flooder = connectToServer(config.unixPath);
+    std::string boards;
+    for (int i = 0; i < 1000; i++) {
+        boards += "BOARD\n";
+    }
+    while (::send(flooder, boards.data(), boards.size(), MSG_NOSIGNAL | MSG_DONTWAIT) > 0) {}
+    ::shutdown(flooder, SHUT_WR);
+    char drain[4096];
+    while (::read(flooder, drain, sizeof(drain)) > 0) {}   // ends: the server closed it
+    ::close(flooder);
+
+    fd = connectToServer(config.unixPath);
+    sendLine(fd, "BOARD");
+    assert(readLine(fd) == "BOARD .........");
+    ::close(fd);
+
+    server.stop();
+    loop.join();
+
+    GameServer::Counters counters = server.getCounters();
+    assert(counters.connections == 223);
+    assert(counters.games >= 202);
+    assert(counters.aiMoves >= 200);
+
+    std::cout << "PASSED (" << counters.connections << " connections, "
+              << counters.aiMoves << " AI moves)\n";
+}
+#endif
+
+void testTicTacToe_ReplaysWithoutAllocating() {
+    std::cout << "Test 20 (TicTacToe): seated players are reused, replays allocate nothing... ";
+
+    // Names are interned: every player of a type points at the same string
+    RegularAIPlayer regularX('X');
+    RegularAIPlayer regularO('O');
+    assert(&regularX.getName() == &regularO.getName());
+
+    // ...and handed over as a view: a name too long for the small-string
+    // buffer costs nothing once it has been seen
+    HumanPlayer first('X', "Player 1 (Human)");
+    long long beforeName = allocationCount.load();
+    HumanPlayer again('X', "Player 1 (Human)");
+    assert(allocationCount.load() == beforeName && &again.getName() == &first.getName());
+
+    TicTacToe game;
+    game.setQuiet(true);
+
+    // Every AI pairing except MCTS, whose node arena keeps growing to its high-water mark
+    const int types[] = {2, 3, 4, 5};
+    for (int typeX : types) {
+        for (int typeO : types) {
+            game.setPlayers(typeX, typeO);
+            for (int i = 0; i < 3; i++) {
+                game.playSingleGame();   // warm-up: tables, lazily built state
+            }
+
+            long long before = allocationCount.load();
+            for (int i = 0; i < 50; i++) {
+                char result = game.playSingleGame();
+                assert(result == 'X' || result == 'O' || result == 'T');
+            }
+            assert(allocationCount.load() == before);
+
+            // Same type again: the player stays in its seat, with the stats of
+            // its last move (a new MiniMax player would have searched nothing)
+            const SearchStats lastX = dynamic_cast<const AIPlayer&>(game.getPlayer(0)).getLastSearchStats();
+            assert(typeX != 4 || lastX.nodes > 0);
+            game.setPlayers(typeX, typeO);
+            const SearchStats& seatedX = dynamic_cast<const AIPlayer&>(game.getPlayer(0)).getLastSearchStats();
+            assert(seatedX.nodes == lastX.nodes && seatedX.principalVariation == lastX.principalVariation);
+            assert(game.getPlayer(0).getSymbol() == 'X' && game.getPlayer(1).getSymbol() == 'O');
+        }
+    }
+
+    // Perfect play from both sides is always a tie
+    game.setPlayers(5, 5);
+    assert(game.playSingleGame() == 'T');
+
+    // MCTS still plays through the same seats
+    game.setPlayers(6, 5);
+    char result = game.playSingleGame();
+    assert(result == 'O' || result == 'T');
+
+    std::cout << "PASSED\n";
+}
+
+
+void testBoardBatch_DrivesTournamentAndMCTS() {
+    std::cout << "Test 21 (BoardBatch): batched random games in tournaments and MCTS leaves ("
+              << BoardBatch::pathName(BoardBatch::bestPath()) << ")... ";
+
+    // Random vs Random goes through the batch; seeded results stay repeatable
+    Tournament::Config config;
+    config.gamesPerPairing = 2000;
+    config.chunkSize = 300;
+    config.threads = 2;
+    config.seed = 9;
+    Tournament first(config);
+    first.run();
+    config.threads = 1;
+    Tournament second(config);
+    second.run();
+
+    const auto& r = first.result(Tournament::PlayerType::Random, Tournament::PlayerType::Random);
+    const auto& again = second.result(Tournament::PlayerType::Random, Tournament::PlayerType::Random);
+    assert(r.games() == 2000);
+    assert(r.xWins == again.xWins && r.oWins == again.oWins && r.draws == again.draws);
+    // Random play on 3x3: X wins about 58%, O about 29%, 13% draws
+    assert(r.xWins > 1000 && r.xWins < 1300);
+    assert(r.oWins > 450 && r.oWins < 700);
+
+    // MCTS with batched leaf playouts still holds the solved table to draws
+    MCTSAIPlayer::Options options;
+    options.playouts = 5000;
+    options.leafPlayouts = 8;
+    for (std::uint64_t seed = 0; seed < 5; seed++) {
+        MCTSAIPlayer x('X', options);
+        MCTSAIPlayer o('O', options);
+        PerfectPlayer perfectX('X');
+        PerfectPlayer perfectO('O');
+        x.setSeed(seed);
+        o.setSeed(seed);
+
+        assert(playAIGame(x, perfectO) == 'T');
+        assert(playAIGame(perfectX, o) == 'T');
+        assert(x.getLastSearchStats().playouts >= options.playouts);
+    }
+
+    std::cout << "PASSED\n";
+}
+
+void testMetaBoard_MCTSPlaysUltimate() {
+    std::cout << "Test 22 (Ultimate): MCTS plays legal Ultimate TicTacToe and beats random play... ";
+
+    MCTSAIPlayer::Options options;
+    options.playouts = 1000;
+
+    int mctsWins = 0;
+    for (std::uint64_t seed = 0; seed < 6; seed++) {
+        const char mctsSymbol = (seed % 2 == 0) ? 'X' : 'O';
+        MCTSAIPlayer ai(mctsSymbol, options);
+        ai.setSeed(seed);
+        Rng rng(seed + 100);
+
+        // The new piece is on a cell that was legal (the sent-to rule)
+        auto checkAiMove = [&](const MetaBoard& before, const MetaBoard& after) {
+            const auto& pv = ai.getLastSearchStats().principalVariation;
+            assert(!pv.empty() && before.isValidMove(pv[0].first, pv[0].second));
+            assert(after.getCellValue(pv[0].first, pv[0].second) == mctsSymbol);
+        };
+        auto playRandom = [&](MetaBoard& board, char mover) {
+            const int cell = board.nthMove(rng.below(board.countMoves()));
+            board.applyMove(cell / 9, cell % 9, mover);
+        };
+        if (playAgainstRandom<MetaBoard>(ai, checkAiMove, playRandom) == mctsSymbol) mctsWins++;
+    }
+    assert(mctsWins >= 5);
+
+    std::cout << "PASSED (MCTS won " << mctsWins << "/6)\n";
+}
+
+void testQubic_ThreatSearchPlays() {
+    std::cout << "Test 23 (Qubic): Qubic AI wins, blocks, forks and beats random play... ";
+
+    // Takes an immediate win (row 0 of layer 0) over blocking O's
+    {
+        QubicBoard board;
+        for (int cell : {0, 1, 2}) board.makeMove(cell, 'X');
+        for (int cell : {16, 17, 18}) board.makeMove(cell, 'O');
+        QubicAIPlayer ai('X');
+        ai.makeMove(board);
+        assert(board.winCheck('X') && board.getCell(3) == 'X');
+    }
+
+    // Blocks the only threat
+    {
+        QubicBoard board;
+        for (int cell : {21, 42}) board.makeMove(cell, 'X');
+        for (int cell : {0, 1, 2}) board.makeMove(cell, 'O');
+        QubicAIPlayer ai('X');
+        ai.makeMove(board);
+        assert(board.getCell(3) == 'X');
+    }
+
+    // Forces a win by threats: the threat sequence ends in a double threat
+    {
+        QubicBoard board;
+        for (int cell : {1, 2, 4, 8}) board.makeMove(cell, 'X');
+        for (int cell : {63, 62, 43, 26}) board.makeMove(cell, 'O');
+        QubicAIPlayer ai('X');
+        const int first = ai.findThreatWin(board.getMask('X'), board.getMask('O'), 1);
+        assert(first != -1);
+        ai.makeMove(board);
+        const std::uint64_t threats = QubicBoard::winningCells(board.getMask('X'), board.getEmptyMask());
+        assert(std::popcount(threats) >= 2);
+        assert(ai.getLastSearchStats().nodes > 0);
+
+        // Either block leaves the other line open
+        board.makeMove(std::countr_zero(threats), 'O');
+        ai.makeMove(board);
+        assert(board.winCheck('X'));
+    }
+
+    // Beats random play from either side with legal moves, never missing a
+    // win or a block (facing two threats, it still blocks one of them)
+    int aiWins = 0;
+    for (std::uint64_t seed = 0; seed < 4; seed++) {
+        const char aiSymbol = (seed % 2 == 0) ? 'X' : 'O';
+        const char randomSymbol = (aiSymbol == 'X') ? 'O' : 'X';
+        QubicAIPlayer ai(aiSymbol);
+        Rng rng(seed + 200);
+
+        auto checkAiMove = [&](const QubicBoard& before, const QubicBoard& after) {
+            const std::uint64_t played = after.getMask(aiSymbol) ^ before.getMask(aiSymbol);
+            assert(std::popcount(played) == 1 && (played & before.getEmptyMask()) != 0);
+            assert(after.getMask(randomSymbol) == before.getMask(randomSymbol));
+
+            const std::uint64_t wins = QubicBoard::winningCells(before.getMask(aiSymbol), before.getEmptyMask());
+            const std::uint64_t threats = QubicBoard::winningCells(before.getMask(randomSymbol), before.getEmptyMask());
+            if (wins != 0) {
+                assert(after.winCheck(aiSymbol));
+            } else if (threats != 0) {
+                assert((played & threats) != 0);
+            }
+        };
+        auto playRandom = [&](QubicBoard& board, char mover) {
+            std::uint64_t empty = board.getEmptyMask();
+            for (int skip = static_cast<int>(rng.below(std::popcount(empty))); skip > 0; skip--) {
+                empty &= empty - 1;
+            }
+            board.makeMove(std::countr_zero(empty), mover);
+        };
+        if (playAgainstRandom<QubicBoard>(ai, checkAiMove, playRandom) == aiSymbol) aiWins++;
+    }
+    assert(aiWins == 4);
+
+    std::cout << "PASSED (won " << aiWins << "/4)\n";
+}
+
+void testProofNumberSolver_ProvesValues() {
+    std::cout << "Test 24 (df-pn): proof-number solver proves m,n,k values... ";
+
+    // Every non-terminal 3x3 position: the solved table's value, and a move that keeps it
+    ProofNumberSolver solver;
+    int positions = 0;
+    forEachReachablePosition([&](const Board& b, char) {
+        const SolvedGame::Entry expected = SolvedGame::lookup(b);
+        const ProofNumberSolver::Result result = solver.solve(b);
+        assert(static_cast<int>(result.value) == static_cast<int>(expected.value));
+        assert(result.bestMove >= 0 && (expected.optimalMoves >> result.bestMove) & 1);
+        positions++;
+    });
+
+    // Known m,n,k values: 3x3 and 4x4 (k = 4) are draws, 4x4 with k = 3 a first-player win.
+    // Playing the proven move and solving again gives the opponent the mirror value.
+    struct Game {int rows, cols, k; ProofNumberSolver::Value value;};
+    for (const Game& game : {Game{3, 3, 3, ProofNumberSolver::Value::Draw},
+                             Game{4, 4, 3, ProofNumberSolver::Value::Win},
+                             Game{4, 4, 4, ProofNumberSolver::Value::Draw}}) {
+        ProofNumberSolver fresh;
+        MNKBoard b(game.rows, game.cols, game.k);
+        const ProofNumberSolver::Result result = fresh.solve(b);
+        assert(result.value == game.value);
+        assert(result.proofTreeSize > 0 && result.nodes > 0);
+
+        b.applyMove(result.bestMove / game.cols, result.bestMove % game.cols, 'X');
+        const ProofNumberSolver::Value reply = fresh.solve(b).value;
+        assert(static_cast<int>(reply) == -static_cast<int>(game.value));
+    }
+
+    // Memory and node bounds: a 64 KB table still proves 4x4 (k = 3); a tiny
+    // budget leaves 5x5 (k = 4) unsolved, and boards over 64 cells are refused
+    {
+        ProofNumberSolver::Options small;
+        small.tableBytes = 64 * 1024;
+        small.nodeBudget = 1000;
+        ProofNumberSolver bounded(small);
+        assert(bounded.memoryBytes() <= small.tableBytes);
+        assert(bounded.solve(MNKBoard(4, 4, 3)).value == ProofNumberSolver::Value::Win);
+        const ProofNumberSolver::Result unsolved = bounded.solve(MNKBoard(5, 5, 4));
+        assert(unsolved.value == ProofNumberSolver::Value::Unknown && unsolved.bestMove == -1);
+        assert(unsolved.nodes == small.nodeBudget);
+        assert(bounded.solve(MNKBoard(9, 9, 5)).value == ProofNumberSolver::Value::Unknown);
+        assert(bounded.tableSize() <= bounded.tableCapacity());
+    }
+
+    // As MiniMax's oracle: a whole 4x4 (k = 4) game from proven moves, a draw
+    {
+        ProofNumberSolver shared;
+        MiniMaxAIPlayer::SearchOptions options;
+        options.oracle = &shared;
+        MiniMaxAIPlayer x('X', options);
+        MiniMaxAIPlayer o('O', options);
+
+        MNKBoard b(4, 4, 4);
+        MiniMaxAIPlayer* current = &x;
+        while (!b.winCheck('X') && !b.winCheck('O') && !b.tieCheck()) {
+            current->makeMove(b);
+            assert(current->getLastSearchStats().principalVariation.size() == 1);
+            current = (current == &x) ? &o : &x;
+        }
+        assert(b.tieCheck());
+
+        // On a 3x3 Board too, against perfect play
+        Board board;
+        PerfectPlayer perfect('X');
+        MiniMaxAIPlayer oracleO('O', options);
+        for (int turn = 0; !board.winCheck('X') && !board.winCheck('O') && !board.tieCheck(); turn++) {
+            if (turn % 2 == 0) {
+                perfect.makeMove(board);
+            } else {
+                oracleO.makeMove(board);
+                assert(oracleO.getLastSearchStats().principalVariation.size() == 1);
+            }
+        }
+        assert(board.tieCheck());
+
+        // A proven loss is played from the solver as well: X threatens (0,2), (2,1) and (2,2)
+        Board lost;
+        for (int cell : {0, 1, 4}) lost.applyMove(cell / 3, cell % 3, 'X');
+        for (int cell : {5, 6}) lost.applyMove(cell / 3, cell % 3, 'O');
+        const ProofNumberSolver::Result proven = ProofNumberSolver().solve(lost);
+        assert(proven.value == ProofNumberSolver::Value::Loss && proven.bestMove >= 0);
+        oracleO.makeMove(lost);
+        assert(lost.getCellValue(proven.bestMove / 3, proven.bestMove % 3) == 'O');
+        assert(oracleO.getLastSearchStats().principalVariation.size() == 1);
+    }
+
+    std::cout << "PASSED (" << positions << " positions)\n";
+}
+
+void testGameRecord_WriteFromThreadsAndReplay() {
+    std::cout << "Test 25 (GameRecord): games recorded from many threads read back and replay... ";
+
+    const std::string path = (std::filesystem::temp_directory_path() / "ai_tests_games.tttrec").string();
+    std::filesystem::remove(path);
+
+    // A whole tournament, chunks on three threads appending to one file
+    GameRecordWriter writer;
+    bool opened = writer.open(path);
+    assert(opened && writer.isOpen());
+
+    Tournament::Config config;
+    config.gamesPerPairing = 200;
+    config.chunkSize = 50;
+    config.threads = 3;
+    config.seed = 5;
+    config.recorder = &writer;
+    Tournament tournament(config);
+    tournament.run();
+    assert(writer.ok());
+    assert(writer.recordsWritten() == 25 * 200);
+    assert(writer.blocksWritten() == 25 * 4);   // one block per chunk
+    writer.close();
+
+    // Recording doesn't change the games
+    config.recorder = nullptr;
+    Tournament unrecorded(config);
+    unrecorded.run();
+
+    GameRecordReader reader;
+    bool mapped = reader.open(path);
+    assert(mapped && reader.size() == 25 * 200);
+
+    auto typeOf = [](GameRecord::PlayerKind kind) {
+        switch (kind) {
+            case GameRecord::PlayerKind::Regular:    return Tournament::PlayerType::Regular;
+            case GameRecord::PlayerKind::Unbeatable: return Tournament::PlayerType::Unbeatable;
+            case GameRecord::PlayerKind::MiniMax:    return Tournament::PlayerType::MiniMax;
+            case GameRecord::PlayerKind::Perfect:    return Tournament::PlayerType::Perfect;
+            default:                                 return Tournament::PlayerType::Random;
+        }
+    };
+
+    // Every record is a legal game that ends where it says; tallied per
+    // pairing they give the tournament's results
+    std::vector<Tournament::PairingResult> tally(Tournament::PLAYER_TYPE_COUNT * Tournament::PLAYER_TYPE_COUNT);
+    std::vector<std::uint64_t> seedsSeen;
+    int replayed = 0;
+    for (const GameRecord& record : reader) {
+        Board board;
+        char winner = ' ';
+        for (int i = 0; i < record.moveCount(); i++) {
+            assert(winner == ' ');
+            const int cell = record.move(i);
+            assert(cell >= 0 && cell < 9 && board.isValidMove(cell / 3, cell % 3));
+            const char symbol = (i % 2 == 0) ? 'X' : 'O';
+            board.makeMove(cell / 3, cell % 3, symbol);
+            if (board.winCheck(symbol)) winner = symbol;
+            else if (board.tieCheck()) winner = 'T';
+        }
+        assert(winner != ' ' && winner == record.result());
+
+        const int x = static_cast<int>(typeOf(record.xPlayer()));
+        const int o = static_cast<int>(typeOf(record.oPlayer()));
+        auto& r = tally[x * Tournament::PLAYER_TYPE_COUNT + o];
+        if (winner == 'X') r.xWins++;
+        else if (winner == 'O') r.oWins++;
+        else r.draws++;
+
+        // Blocks keep their chunk's order, so the first record with a seed is
+        // the chunk's first game: fresh players from that seed play it again
+        // (Random vs Random chunks are played all at once on a BoardBatch)
+        bool batched = record.xPlayer() == GameRecord::PlayerKind::Random &&
+                       record.oPlayer() == GameRecord::PlayerKind::Random;
+        bool firstOfChunk = std::find(seedsSeen.begin(), seedsSeen.end(), record.seed) == seedsSeen.end();
+        if (firstOfChunk && !batched) {
+            seedsSeen.push_back(record.seed);
+            auto xPlayer = Tournament::createPlayer(typeOf(record.xPlayer()), 'X', GameRecord::playerSeed(record.seed, 0));
+            auto oPlayer = Tournament::createPlayer(typeOf(record.oPlayer()), 'O', GameRecord::playerSeed(record.seed, 1));
+            GameRecord again;
+            char result = Tournament::playGame(*xPlayer, *oPlayer, &again);
+            assert(result == record.result() && again.moveCount() == record.moveCount());
+            for (int i = 0; i < record.moveCount(); i++) {
+                assert(again.move(i) == record.move(i));
+            }
+            replayed++;
+        }
+    }
+    assert(replayed == 24 * 4);
+    for (int x = 0; x < Tournament::PLAYER_TYPE_COUNT; x++) {
+        for (int o = 0; o < Tournament::PLAYER_TYPE_COUNT; o++) {
+            const auto& expected = unrecorded.result(static_cast<Tournament::PlayerType>(x),
+                                                     static_cast<Tournament::PlayerType>(o));
+            const auto& counted = tally[x * Tournament::PLAYER_TYPE_COUNT + o];
+            assert(counted.xWins == expected.xWins && counted.oWins == expected.oWins &&
+                   counted.draws == expected.draws);
+        }
+    }
+    reader.close();
+
+    // TicTacToe appends to the same file; each game gets its own seed
+    opened = writer.open(path);
+    assert(opened);
+    {
+        TicTacToe game;
+        game.setQuiet(true);
+        game.setPlayers(3, 2);
+        game.setRecorder(&writer, 77);
+        for (int i = 0; i < 20; i++) {
+            game.playSingleGame();
+        }
+        assert(writer.recordsWritten() == 0);   // still buffered
+        game.setRecorder(nullptr);
+        assert(writer.recordsWritten() == 20 && writer.blocksWritten() == 1);
+    }
+    writer.close();
+
+    // A torn record at the end (a write cut short) is not a game
+    {
+        std::ofstream torn(path, std::ios::binary | std::ios::app);
+        torn.write("\x01\x02\x03\x04\x05", 5);
+    }
+
+    mapped = reader.open(path);
+    assert(mapped && reader.size() == 25 * 200 + 20);
+    for (std::size_t i = 25 * 200; i < reader.size(); i++) {
+        const GameRecord& record = reader[i];
+        assert(record.xPlayer() == GameRecord::PlayerKind::Unbeatable);
+        assert(record.oPlayer() == GameRecord::PlayerKind::Regular);
+        assert(i == 25 * 200 || record.seed != reader[i - 1].seed);
+
+        UnbeatableAIPlayer xPlayer('X');
+        RegularAIPlayer oPlayer('O');
+        xPlayer.setSeed(GameRecord::playerSeed(record.seed, 0));
+        oPlayer.setSeed(GameRecord::playerSeed(record.seed, 1));
+        GameRecord again;
+        char result = Tournament::playGame(xPlayer, oPlayer, &again);
+        assert(result == record.result() && result != 'O');
+        assert(std::equal(std::begin(again.moves), std::end(again.moves), std::begin(record.moves)));
+    }
+    reader.close();
+
+    // Other files are refused by both sides
+    const std::string otherPath = (std::filesystem::temp_directory_path() / "ai_tests_not_games.txt").string();
+    {
+        std::ofstream other(otherPath);
+        other << "not a game-record file, just some text\n";
+    }
+    opened = writer.open(otherPath);
+    assert(!opened && !writer.getError().empty());
+    opened = reader.open(otherPath);
+    assert(!opened && !reader.getError().empty());
+    opened = reader.open(otherPath + ".missing");
+    assert(!opened && !reader.isOpen());
+    std::ofstream(otherPath, std::ios::trunc).close();   // empty: nothing to map
+    opened = reader.open(otherPath);
+    assert(!opened && !reader.isOpen() && !reader.getError().empty());
+    std::filesystem::remove(otherPath);
+    std::filesystem::remove(path);
+
+    std::cout << "PASSED (" << 25 * 200 + 20 << " games)\n";
+}
+
+void testOpeningBook_LearnsAndGuidesPlayers() {
+    std::cout << "Test 26 (OpeningBook): learned from recorded games, consulted before searching... ";
+
+    // Learn from a recorded tournament
+    const std::string recordPath = (std::filesystem::temp_directory_path() / "ai_tests_book_games.tttrec").string();
+    std::filesystem::remove(recordPath);
+    GameRecordWriter writer;
+    bool opened = writer.open(recordPath);
+    assert(opened);
+    Tournament::Config config;
+    config.gamesPerPairing = 200;
+    config.chunkSize = 20;
+    config.threads = 2;
+    config.seed = 3;
+    config.recorder = &writer;
+    Tournament tournament(config);
+    tournament.run();
+    writer.close();
+
+    GameRecordReader reader;
+    bool mapped = reader.open(recordPath);
+    assert(mapped);
+
+    // `book` sees every game, `strongBook` only those between perfect players
+    OpeningBook book;
+    OpeningBook strongBook;
+    auto strong = [](GameRecord::PlayerKind kind) {
+        return kind == GameRecord::PlayerKind::Unbeatable || kind == GameRecord::PlayerKind::MiniMax ||
+               kind == GameRecord::PlayerKind::Perfect;
+    };
+    for (const GameRecord& record : reader) {
+        book.addGame(record);
+        if (strong(record.xPlayer()) && strong(record.oPlayer())) {
+            strongBook.addGame(record);
+        }
+    }
+    assert(book.gamesAdded() == static_cast<long long>(reader.size()));
+    assert(strongBook.gamesAdded() == 9 * 200);
+    reader.close();
+    std::filesystem::remove(recordPath);
+
+    // Every game passes through the empty board; mirrored openings share counts
+    Board empty;
+    assert(book.statsFor(empty).games() == book.gamesAdded());
+    Board corner;
+    corner.applyMove(0, 0, 'X');
+    Board otherCorner;
+    otherCorner.applyMove(2, 2, 'X');
+    const OpeningBook::Stats a = book.statsFor(corner);
+    const OpeningBook::Stats b = book.statsFor(otherCorner);
+    assert(a.games() > 0 && a.xWins == b.xWins && a.oWins == b.oWins && a.draws == b.draws);
+
+    // Perfect players only draw, so every move the strong book suggests from
+    // a position it knows keeps the game-theoretic value
+    int bookMoves = 0;
+    forEachReachablePosition([&](const Board& position, char) {
+        if (strongBook.statsFor(position).games() < strongBook.getOptions().minGames) return;
+        const int cell = strongBook.bestMove(position);
+        if (cell < 0) return;
+        assert(position.isValidMove(cell / 3, cell % 3));
+        assert(SolvedGame::lookup(position).optimalMoves & (1u << cell));
+        bookMoves++;
+    });
+    assert(bookMoves > 0);
+
+    // Players consult the book first: its move, no search
+    const int opening = strongBook.bestMove(empty);
+    assert(opening >= 0);
+    {
+        MiniMaxAIPlayer minimax('X');
+        minimax.setOpeningBook(&strongBook);
+        Board board;
+        minimax.makeMove(board);
+        assert(board.getCellValue(opening / 3, opening % 3) == 'X');
+        assert(minimax.getLastSearchStats().nodes == 0);
+        assert(minimax.getLastSearchStats().principalVariation.size() == 1);
+
+        MCTSAIPlayer mcts('X');
+        mcts.setOpeningBook(&strongBook);
+        Board mctsBoard;
+        mcts.makeMove(mctsBoard);
+        assert(mctsBoard.getCellValue(opening / 3, opening % 3) == 'X');
+        assert(mcts.getLastSearchStats().playouts == 0);
+
+        // Out of the book (past maxPly) the search runs as before
+        OpeningBook::Options shallow;
+        shallow.maxPly = 1;
+        shallow.minGames = 1;
+        OpeningBook oneMove(3, 3, 3, shallow);
+        const int centerFirst[] = {4, 0, 8, 2, 6, 3, 5};
+        oneMove.addGame(centerFirst, 7, 'X');
+        minimax.setOpeningBook(&oneMove);
+        Board afterOne;
+        afterOne.applyMove(1, 1, 'X');
+        minimax.makeMove(afterOne);
+        assert(minimax.getLastSearchStats().nodes > 0);
+    }
+
+    // An Unbeatable player following the book still never loses
+    UnbeatableAIPlayer bookX('X');
+    UnbeatableAIPlayer bookO('O');
+    bookX.setOpeningBook(&strongBook);
+    bookO.setOpeningBook(&strongBook);
+    RandomAIPlayer randomX('X');
+    RandomAIPlayer randomO('O');
+    randomX.setSeed(11);
+    randomO.setSeed(12);
+    for (int i = 0; i < 300; i++) {
+        assert(Tournament::playGame(bookX, randomO) != 'O');
+        assert(Tournament::playGame(randomX, bookO) != 'X');
+    }
+
+    // Wins and blocks come before the book: this one-game book has O answer
+    // X4 O0 X1 with (0,2), which lets X complete the middle column
+    OpeningBook::Options oneGame;
+    oneGame.minGames = 1;
+    OpeningBook lostGame(3, 3, 3, oneGame);
+    const int lostForO[] = {4, 0, 1, 2, 7};
+    lostGame.addGame(lostForO, 5, 'X');
+    Board threatened;
+    threatened.applyMove(1, 1, 'X');
+    threatened.applyMove(0, 0, 'O');
+    threatened.applyMove(0, 1, 'X');
+    assert(lostGame.bestMove(threatened) == 2);
+    {
+        UnbeatableAIPlayer unbeatable('O');
+        MiniMaxAIPlayer minimax('O');
+        MCTSAIPlayer mcts('O');
+        AIPlayer* players[] = {&unbeatable, &minimax, &mcts};
+        for (AIPlayer* player : players) {
+            player->setOpeningBook(&lostGame);
+            Board board = threatened;
+            player->makeMove(board);
+            assert(board.getCellValue(2, 1) == 'O');
+        }
+    }
+
+    // m,n,k boards: games fed in one orientation answer the mirrored position
+    OpeningBook::Options loose;
+    loose.minGames = 1;
+    OpeningBook mnkBook(4, 4, 3, loose);
+    const int winning[] = {0, 5, 1, 9, 2};   // X takes the top row
+    const int losing[] = {1, 5, 0, 6, 8, 4};  // O takes the second row
+    for (int i = 0; i < 3; i++) {
+        mnkBook.addGame(winning, 5, 'X');
+        mnkBook.addGame(losing, 6, 'O');
+    }
+    assert(mnkBook.size() > 0 && mnkBook.gamesAdded() == 6);
+    MNKBoard mnkEmpty(4, 4, 3);
+    assert(mnkBook.bestMove(mnkEmpty) == 0);   // the corner won every game it was played
+    MNKBoard rotated(4, 4, 3);
+    rotated.applyMove(3, 3, 'X');              // corner 0 turned 180 degrees
+    assert(mnkBook.bestMove(rotated) == 10);   // ...and O's answer (1,1) with it
+    assert(mnkBook.bestMove(MNKBoard(5, 5, 4)) == -1);
+    {
+        MiniMaxAIPlayer minimax('O');
+        minimax.setOpeningBook(&mnkBook);
+        MNKBoard board = rotated;
+        minimax.makeMove(board);
+        assert(board.getCellValue(2, 2) == 'O' && minimax.getLastSearchStats().nodes == 0);
+
+        MCTSAIPlayer mcts('O');
+        mcts.setOpeningBook(&mnkBook);
+        MNKBoard mctsBoard = rotated;
+        mcts.makeMove(mctsBoard);
+        assert(mctsBoard.getCellValue(2, 2) == 'O' && mcts.getLastSearchStats().playouts == 0);
+    }
+
+    // Files: a saved book loads back identical, whatever board the reader had
+    const std::string bookPath = (std::filesystem::temp_directory_path() / "ai_tests_3x3k3.book").string();
+    bool saved = strongBook.save(bookPath);
+    assert(saved);
+    OpeningBook loaded(5, 5, 4);
+    bool loadedOk = loaded.load(bookPath);
+    assert(loadedOk && loaded.getRows() == 3 && loaded.getCols() == 3 && loaded.getK() == 3);
+    assert(loaded.size() == strongBook.size() && loaded.gamesAdded() == strongBook.gamesAdded());
+    forEachReachablePosition([&](const Board& position, char) {
+        assert(loaded.bestMove(position) == strongBook.bestMove(position));
+    });
+    OpeningBook merged;
+    bool mergedOk = merged.merge(loaded);
+    mergedOk = merged.merge(loaded) && mergedOk;
+    assert(mergedOk);
+    assert(merged.statsFor(empty).games() == 2 * strongBook.statsFor(empty).games());
+    mergedOk = merged.merge(mnkBook);
+    assert(!mergedOk);
+
+    {
+        std::ofstream truncated(bookPath, std::ios::binary | std::ios::app);
+        truncated.write("\x01\x02", 2);
+    }
+    loadedOk = loaded.load(bookPath);
+    assert(!loadedOk && !loaded.getError().empty());
+    loadedOk = loaded.load(bookPath + ".missing");
+    assert(!loadedOk);
+    std::filesystem::remove(bookPath);
+
+    std::cout << "PASSED (" << strongBook.size() << " positions, " << bookMoves << " book moves checked)\n";
+}
+
+// Reference for Test 27: UnbeatableAI's rules as first written, with a
+// board copy per candidate move. Returns the cell (row * 3 + col) it plays.
+// ------------------------------------------------------------
+int referenceUnbeatableMove(const Board& board, char me) {
+    const char opp = (me == 'X') ? 'O' : 'X';
+
+    auto winsAt = [](const Board& b, int cell, char s) {
+        if (!b.isValidMove(cell / 3, cell % 3)) {return false;}
+        Board temp = b;
+        temp.applyMove(cell / 3, cell % 3, s);
+        return temp.winCheck(s);
+    };
+    auto isFork = [&](const Board& b, int cell, char s) {
+        if (!b.isValidMove(cell / 3, cell % 3)) {return false;}
+        Board temp = b;
+        temp.applyMove(cell / 3, cell % 3, s);
+        int wins = 0;
+        for (int next = 0; next < 9; next++) {
+            if (winsAt(temp, next, s)) {wins++;}
+        }
+        return wins >= 2;
+    };
+    auto anyFork = [&](const Board& b, char s) {
+        for (int cell = 0; cell < 9; cell++) {
+            if (isFork(b, cell, s)) {return true;}
+        }
+        return false;
+    };
+
+    // 1-2) Win, then block
+    for (char s : {me, opp}) {
+        for (int cell = 0; cell < 9; cell++) {
+            if (winsAt(board, cell, s)) {return cell;}
+        }
+    }
+
+    // 3) Center against opposite corners: take an edge
+    if (board.getCellValue(1, 1) == me &&
+        ((board.getCellValue(0, 0) == opp && board.getCellValue(2, 2) == opp) ||
+         (board.getCellValue(0, 2) == opp && board.getCellValue(2, 0) == opp))) {
+        for (int cell : {1, 3, 5, 7}) {
+            if (board.isValidMove(cell / 3, cell % 3)) {return cell;}
+        }
+    }
+
+    // 4) Fork
+    for (int cell = 0; cell < 9; cell++) {
+        if (isFork(board, cell, me)) {return cell;}
+    }
+
+    // 5) Block the opponent's fork: a move after which they have none,
+    //    or else one of their fork squares
+    if (anyFork(board, opp)) {
+        for (int cell = 0; cell < 9; cell++) {
+            if (!board.isValidMove(cell / 3, cell % 3)) {continue;}
+            Board temp = board;
+            temp.applyMove(cell / 3, cell % 3, me);
+            if (!anyFork(temp, opp)) {return cell;}
+        }
+        for (int cell = 0; cell < 9; cell++) {
+            if (isFork(board, cell, opp)) {return cell;}
+        }
+    }
+
+    // 6-9) Center, opposite corner, corner, edge
+    if (board.isValidMove(1, 1)) {return 4;}
+    const int opposite[4][2] = {{0, 8}, {8, 0}, {2, 6}, {6, 2}};
+    for (const auto& pair : opposite) {
+        if (board.getCellValue(pair[0] / 3, pair[0] % 3) == opp &&
+            board.isValidMove(pair[1] / 3, pair[1] % 3)) {
+            return pair[1];
+        }
+    }
+    for (int cell : {0, 2, 6, 8, 1, 3, 5, 7}) {
+        if (board.isValidMove(cell / 3, cell % 3)) {return cell;}
+    }
+    return -1;
+}
+
+void testUnbeatableAI_MatchesReferenceEverywhere() {
+    std::cout << "Test 27 (UnbeatableAI): same move as the board-copying rules in every position... ";
+
+    // With no wins or blocks, it plays a fork: (1,0) threatens both (2,0) and (1,2)
+    //        X O _
+    //        _ X _
+    //        _ _ O
+    Board f;
+    f.applyMove(0, 0, 'X');
+    f.applyMove(0, 1, 'O');
+    f.applyMove(1, 1, 'X');
+    f.applyMove(2, 2, 'O');
+
+    UnbeatableAIPlayer forker('X');
+    forker.makeMove(f);
+    assert(f.getCellValue(1, 0) == 'X');
+
+    UnbeatableAIPlayer xPlayer('X');
+    UnbeatableAIPlayer oPlayer('O');
+    int positions = 0;
+
+    forEachReachablePosition([&](const Board& start, char toMove) {
+        Board b = start;
+        (toMove == 'X' ? xPlayer : oPlayer).makeMove(b);
+        const int played = std::countr_zero(static_cast<unsigned>(b.getEmptyMask() ^ start.getEmptyMask()));
+        assert(played == referenceUnbeatableMove(start, toMove));
+        positions++;
+    });
+    assert(positions == 4520);
+
+    std::cout << "PASSED (" << positions << " positions)\n";
+}
+
 // Heavy simulation tests for UnbeatableAI
 // ============================================================
 void simulate_Unbeatable_vs_Unbeatable() {
@@ -600,6 +2479,31 @@ int main() {
     testRegularAI_TakesWinningMove();
     testUnbeatableAI_BlocksImmediateThreat();
     testAIs_DoNotOverwriteOccupiedCells();
+    testMiniMax_AlphaBetaMatchesFullSearch();
+    testMiniMax_AlphaBetaPrunesEmptyBoard();
+    testMiniMax_TranspositionTable();
+    testSolvedGame_MatchesMiniMaxAndPerfectPlayer();
+    testSolvedGame_UnbeatableNeverGivesUpValue();
+    testMNK_HelpersAndMiniMax();
+    testTournament_MultithreadedMatrix();
+    testRng_SeededPlayersReplayGames();
+    testSearchStats_MiniMaxReportsWork();
+    testMiniMax_ParallelRootSplit();
+    testMiniMax_IterativeDeepeningBudgets();
+    testMCTS_PlaysSoundlyAndScales();
+    testMiniMax_BatchEvaluation();
+    testPositionDatabase_BuildMapAndPlay();
+#ifdef __linux__
+    testGameServer_ConcurrentGames();
+#endif
+    testTicTacToe_ReplaysWithoutAllocating();
+    testBoardBatch_DrivesTournamentAndMCTS();
+    testMetaBoard_MCTSPlaysUltimate();
+    testQubic_ThreatSearchPlays();
+    testProofNumberSolver_ProvesValues();
+    testGameRecord_WriteFromThreadsAndReplay();
+    testOpeningBook_LearnsAndGuidesPlayers();
+    testUnbeatableAI_MatchesReferenceEverywhere();
 
     std::cout << "\n=== Heavy Unbeatable-AI Simulations ===\n\n";
 
@@ -2,9 +2,17 @@
 // Created by lib_laptop on 11/29/2025.
 //
 
+#include <bit>
 #include <iostream>
 #include <cassert>
+#include <vector>
 #include "Board.h"
+#include "BoardBatch.h"
+#include "Rng.h"
+#include "MNKBoard.h"
+#include "MetaBoard.h"
+#include "QubicBoard.h"
+#include "WinLines.h"
 
 int main() {
 
@@ -72,6 +80,441 @@ int main() {
         assert(b.tieCheck());      // Should be a tie
     }
 
+    // =============================================================
+    // Test 4: Column and diagonal wins are detected for both symbols
+    // =============================================================
+    {
+        Board col;
+        col.applyMove(0, 2, 'O');
+        col.applyMove(1, 2, 'O');
+        col.applyMove(2, 2, 'O');
+        assert(col.winCheck('O'));
+        assert(!col.winCheck('X'));
+
+        Board diag;
+        diag.applyMove(0, 0, 'X');
+        diag.applyMove(1, 1, 'X');
+        diag.applyMove(2, 2, 'X');
+        assert(diag.winCheck('X'));
+
+        Board anti;
+        anti.applyMove(0, 2, 'X');
+        anti.applyMove(1, 1, 'X');
+        anti.applyMove(2, 0, 'X');
+        assert(anti.winCheck('X'));
+
+        // Two in a row plus an opponent piece is not a win
+        Board blocked;
+        blocked.applyMove(0, 0, 'X');
+        blocked.applyMove(0, 1, 'X');
+        blocked.applyMove(0, 2, 'O');
+        assert(!blocked.winCheck('X'));
+        assert(!blocked.winCheck('O'));
+    }
+
+    // =============================================================
+    // Test 5: Occupied and out-of-range cells are rejected
+    // =============================================================
+    {
+        Board b;
+        b.applyMove(1, 1, 'X');
+        b.applyMove(1, 1, 'O');   // ignored: already occupied
+
+        assert(b.getCellValue(1, 1) == 'X');
+        assert(!b.isValidMove(1, 1));
+        assert(!b.isValidMove(-1, 0));
+        assert(!b.isValidMove(0, 3));
+        assert(!b.isValidMove(3, 0));
+        assert(b.getFilledCells() == 1);
+    }
+
+    // =============================================================
+    // Test 6: Masks mirror the grid and the state stays compact
+    // =============================================================
+    {
+        static_assert(sizeof(Board) == 4, "Board should be two 9-bit masks");
+
+        Board b;
+        b.applyMove(0, 0, 'X');   // bit 0
+        b.applyMove(2, 2, 'O');   // bit 8
+
+        assert(b.getMask('X') == 0x001);
+        assert(b.getMask('O') == 0x100);
+        assert(b.getOccupiedMask() == 0x101);
+        assert(b.getEmptyMask() == (Board::FULL_MASK & ~0x101));
+
+        Board copy = b;
+        assert(copy.getCellValue(0, 0) == 'X');
+        assert(copy.getCellValue(2, 2) == 'O');
+        assert(copy.getCellValue(1, 1) == ' ');
+    }
+
+    // =============================================================
+    // Test 7: MNKBoard behaves like Board on 3x3, k = 3
+    // =============================================================
+    {
+        MNKBoard b;
+        assert(b.getRows() == 3 && b.getCols() == 3 && b.getK() == 3);
+        assert(!b.winCheck('X') && !b.tieCheck());
+
+        b.applyMove(0, 2, 'X');
+        b.applyMove(1, 1, 'X');
+        assert(b.wouldWin(2, 0, 'X'));    // completes the anti-diagonal
+        assert(!b.wouldWin(2, 0, 'O'));
+        b.applyMove(2, 0, 'X');
+        assert(b.winCheck('X'));
+        assert(!b.winCheck('O'));
+        assert(b.getLastRow() == 2 && b.getLastCol() == 0);
+
+        // Same tie pattern as Test 3
+        MNKBoard tie;
+        const char* rows[3] = {"XOX", "XOO", "OXX"};
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                tie.applyMove(r, c, rows[r][c]);
+            }
+        }
+        assert(!tie.winCheck('X') && !tie.winCheck('O'));
+        assert(tie.tieCheck());
+        assert(!tie.isValidMove(1, 1) && !tie.isValidMove(3, 0));
+    }
+
+    // =============================================================
+    // Test 8: Gomoku-sized board, five in a row through the last stone
+    // =============================================================
+    {
+        MNKBoard b(15, 15, 5);
+
+        // Four on a diagonal is not enough...
+        for (int i = 0; i < 4; ++i) {
+            b.applyMove(3 + i, 10 - i, 'O');
+        }
+        assert(!b.winCheck('O'));
+
+        // ...an X on the extension spot blocks one end...
+        b.applyMove(7, 6, 'X');
+        assert(!b.isValidMove(7, 6));
+
+        // ...and the stone on the other end makes five
+        assert(b.wouldWin(2, 11, 'O'));
+        b.applyMove(2, 11, 'O');
+        assert(b.winCheck('O'));
+        assert(b.getFilledCells() == 6);
+
+        // Runs along a board edge are counted correctly
+        MNKBoard edge(15, 15, 5);
+        for (int c = 10; c < 15; ++c) {
+            edge.applyMove(14, c, 'X');
+        }
+        assert(edge.winCheck('X'));
+
+        // Out-of-range sizes are clamped, and only X and O can be placed
+        MNKBoard tiny(0, -4, 7);
+        assert(tiny.getRows() == 1 && tiny.getCols() == 1 && tiny.getK() == 1);
+        MNKBoard huge(100, 15, 40);
+        assert(huge.getRows() == MNKBoard::MAX_DIM && huge.getK() == MNKBoard::MAX_DIM);
+        tiny.applyMove(0, 0, '#');
+        assert(tiny.isValidMove(0, 0) && tiny.getFilledCells() == 0);
+    }
+
+    // =============================================================
+    // Test 9: makeMove/unmakeMove keep the hash, line counts and winner in step
+    // =============================================================
+    {
+        Board b;
+        const std::uint64_t emptyHash = b.getHash();
+
+        // Same position by two move orders: same hash
+        Board other;
+        b.makeMove(0, 0, 'X');
+        b.makeMove(1, 1, 'O');
+        b.makeMove(0, 1, 'X');
+        other.applyMove(0, 1, 'X');
+        other.applyMove(1, 1, 'O');
+        other.applyMove(0, 0, 'X');
+        assert(b.getHash() == other.getHash());
+        assert(b.getHash() != emptyHash);
+
+        assert(b.getLineCount(0, 'X') == 2);   // top row
+        assert(b.getLineCount(4, 'O') == 1);   // middle column
+        assert(b.getLineCount(6, 'O') == 1);   // main diagonal
+        assert(b.getLineCount(6, 'X') == 1);
+
+        // Completing the top row wins; taking it back un-wins
+        b.makeMove(0, 2, 'X');
+        assert(b.winCheck('X') && !b.winCheck('O'));
+        assert(b.getLineCount(0, 'X') == 3);
+        b.unmakeMove(0, 2);
+        assert(!b.winCheck('X'));
+        assert(b.isValidMove(0, 2));
+        assert(b.getHash() == other.getHash());
+
+        // Undo everything, in a different order than played
+        b.unmakeMove(1, 1);
+        b.unmakeMove(0, 0);
+        b.unmakeMove(0, 1);
+        assert(b.getHash() == emptyHash);
+        assert(b.getFilledCells() == 0);
+        for (int line = 0; line < 8; ++line) {
+            assert(b.getLineCount(line, 'X') == 0 && b.getLineCount(line, 'O') == 0);
+        }
+
+        // Both sides can hold a line at once (not reachable in a game, but the
+        // flags are per side)
+        Board both;
+        for (int c = 0; c < 3; ++c) {
+            both.makeMove(0, c, 'X');
+            both.makeMove(2, c, 'O');
+        }
+        assert(both.winCheck('X') && both.winCheck('O'));
+        both.unmakeMove(2, 1);
+        assert(both.winCheck('X') && !both.winCheck('O'));
+    }
+
+    // =============================================================
+    // Test 10: compile-time line tables for several sizes
+    // =============================================================
+    {
+        // 3x3 reproduces the classic table, in the same order
+        constexpr std::uint16_t classic[8] = {0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054};
+        for (int line = 0; line < 8; ++line) {
+            assert(Board::WIN_LINES[line] == classic[line]);
+        }
+        static_assert(Board::Lines::CELL_LINES[4].count == 4);   // the center is on 4 lines
+        static_assert(Board::Lines::CELL_LINES[1].count == 2);   // an edge on 2
+
+        // Line counts: 4x4 k=4, Connect Four's 6x7 k=4, 8x8 k=5 (64 cells)
+        static_assert(WinLines<4, 4, 4>::COUNT == 10);
+        static_assert(WinLines<6, 7, 4>::COUNT == 69);
+        static_assert(WinLines<8, 8, 5>::COUNT == 96);
+        static_assert(WinLines<3, 5, 4>::COUNT == 3 * 2);   // too short for columns/diagonals
+
+        // The bit tests agree with MNKBoard on random 6x7 positions
+        using C4 = WinLines<6, 7, 4>;
+        std::uint64_t seed = 12345;
+        auto next = [&seed] {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            return seed >> 33;
+        };
+        for (int game = 0; game < 200; ++game) {
+            MNKBoard b(6, 7, 4);
+            C4::Mask masks[2] = {0, 0};
+            int filled = static_cast<int>(next() % 20);
+            for (int i = 0; i < filled; ++i) {
+                int cell = static_cast<int>(next() % 42);
+                if (!b.isValidMove(cell / 7, cell % 7)) continue;
+                const int side = i % 2;
+                b.applyMove(cell / 7, cell % 7, side == 0 ? 'X' : 'O');
+                masks[side] |= C4::Mask{1} << cell;
+            }
+            const C4::Mask empty = C4::FULL_MASK & ~(masks[0] | masks[1]);
+            // MNKBoard remembers only the first side to make a line
+            if (b.winCheck('X')) assert(C4::hasLine(masks[0]));
+            if (b.winCheck('O')) assert(C4::hasLine(masks[1]));
+            if (!b.winCheck('X') && !b.winCheck('O')) assert(!C4::hasLine(masks[0]) && !C4::hasLine(masks[1]));
+
+            for (int side = 0; side < 2; ++side) {
+                const char symbol = side == 0 ? 'X' : 'O';
+                const C4::Mask wins = C4::winningCells(masks[side], empty);
+                for (int cell = 0; cell < 42; ++cell) {
+                    const bool isEmpty = (empty >> cell) & 1;
+                    const bool expected = isEmpty && b.wouldWin(cell / 7, cell % 7, symbol);
+                    assert(((wins >> cell) & 1) == expected);
+                    if (isEmpty) {
+                        assert(C4::wouldWin(masks[side], cell) == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    // =============================================================
+    // Test 11: BoardBatch agrees with Board on every path (SIMD and scalar)
+    // =============================================================
+    {
+        // Every X/O mask pair with no overlap, including unreachable ones;
+        // 19683 boards also leaves a tail shorter than one register
+        BoardBatch batch(19683);
+        std::size_t n = 0;
+        for (int code = 0; code < 19683; ++code) {
+            Board b;
+            for (int cell = 0, rest = code; cell < 9; ++cell, rest /= 3) {
+                if (rest % 3 == 1) b.makeMove(cell / 3, cell % 3, 'X');
+                if (rest % 3 == 2) b.makeMove(cell / 3, cell % 3, 'O');
+            }
+            batch.set(n++, b);
+        }
+
+        std::vector<char> status(batch.size());
+        std::vector<std::uint16_t> empty(batch.size());
+        for (auto path : {BoardBatch::Path::Scalar, BoardBatch::Path::Sse2, BoardBatch::Path::Avx2}) {
+            if (!BoardBatch::supports(path)) continue;
+            batch.classify(status.data(), path);
+            batch.emptyMasks(empty.data(), path);
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                const Board b = batch.get(i);
+                char expected = BoardBatch::IN_PROGRESS;
+                if (b.winCheck('X')) expected = 'X';
+                else if (b.winCheck('O')) expected = 'O';
+                else if (b.tieCheck()) expected = 'T';
+                assert(status[i] == expected);
+                assert(empty[i] == b.getEmptyMask());
+            }
+        }
+        assert(BoardBatch::supports(BoardBatch::bestPath()));
+
+        // Random games end in a legal final position with the reported result
+        BoardBatch games(1000);
+        games.set(0, batch.get(1));   // X already on the first cell: O moves next
+        Rng rng(7);
+        std::vector<char> results(games.size());
+        BoardBatch::Totals totals = games.playRandomGames(rng, results.data());
+        assert(totals.xWins + totals.oWins + totals.draws == 1000);
+        assert(totals.xWins > totals.oWins && totals.draws > 0);   // the first player's edge
+        for (std::size_t i = 0; i < games.size(); ++i) {
+            const Board b = games.get(i);
+            const int xs = std::popcount(static_cast<unsigned>(b.getMask('X')));
+            const int os = std::popcount(static_cast<unsigned>(b.getMask('O')));
+            assert(xs == os || xs == os + 1);
+            assert(results[i] != BoardBatch::IN_PROGRESS);
+            assert(b.winCheck(results[i]) || (results[i] == 'T' && b.tieCheck()));
+            assert(!(b.winCheck('X') && b.winCheck('O')));
+        }
+        assert(games.get(0).getCellValue(0, 0) == 'X');
+    }
+
+    // =============================================================
+    // Test 12: MetaBoard (Ultimate TicTacToe) rules
+    // =============================================================
+    {
+        MetaBoard m;
+        std::uint8_t moves[MetaBoard::CELLS];
+        assert(m.getTargetBoard() == MetaBoard::ANY_BOARD);
+        assert(m.generateMoves(moves) == 81 && m.countMoves() == 81);
+        assert(!m.isValidMove(9, 0) && !m.isValidMove(0, -1));
+
+        // X plays the top-right cell of the center sub-board: O is sent to sub-board 2
+        m.applyMove(3, 5, 'X');
+        assert(m.getCellValue(3, 5) == 'X' && m.getSubBoard(4).getCellValue(0, 2) == 'X');
+        assert(m.getTargetBoard() == 2);
+        assert(m.countMoves() == 9 && m.isValidMove(0, 6) && !m.isValidMove(0, 0));
+        const int count = m.generateMoves(moves);
+        for (int i = 0; i < count; ++i) {
+            assert(moves[i] / 9 < 3 && moves[i] % 9 >= 6);   // all inside sub-board 2
+            assert(m.nthMove(i) == moves[i]);
+        }
+
+        // X takes the diagonal of sub-board 0: that meta cell is X's and closed
+        MetaBoard w;
+        for (int i = 0; i < 3; ++i) {
+            w.makeMove(i, i, 'X');
+        }
+        assert(w.getSubBoardResult(0) == 'X' && w.getWonMask('X') == 0x001);
+        assert(!(w.getOpenMask() & 0x001) && !w.winCheck('X'));
+        assert(w.getTargetBoard() == 8);            // last move was inner cell 8
+
+        // Moves take back in place, restoring the target board
+        w.makeMove(7, 6, 'O');                      // sub-board 6, inner cell 3
+        assert(w.getTargetBoard() == 3);
+        w.unmakeMove(7, 6, 8);
+        assert(w.getTargetBoard() == 8 && w.getCellValue(7, 6) == ' ');
+
+        // Being sent to a closed sub-board frees the choice: any open sub-board
+        w.makeMove(6, 6, 'O');                      // inner cell 0 -> sub-board 0, already won
+        assert(w.getTargetBoard() == MetaBoard::ANY_BOARD);
+        assert(w.countMoves() == 81 - 9 - 1);
+        assert(!w.isValidMove(1, 0) && w.isValidMove(4, 4));
+
+        // Three sub-boards on the diagonal win the game; unmaking the last move takes it back
+        MetaBoard g;
+        for (int b : {0, 4, 8}) {
+            for (int i = 0; i < 3; ++i) {
+                g.makeMove((b / 3) * 3 + i, (b % 3) * 3 + i, 'X');
+            }
+        }
+        assert(g.winCheck('X') && !g.winCheck('O') && !g.tieCheck());
+        assert(g.countMoves() == 0 && !g.isValidMove(1, 7));
+        g.unmakeMove(8, 8, MetaBoard::ANY_BOARD);
+        assert(!g.winCheck('X') && g.getSubBoardResult(8) == ' ' && g.getWonMask('X') == 0x011);
+        static_assert(sizeof(MetaBoard) <= 48);
+    }
+
+    // =============================================================
+    // Test 13: QubicBoard (4x4x4) lines, wins and threat masks
+    // =============================================================
+    {
+        // 76 distinct lines of four; corners and the 8 inner cells lie on 7, the rest on 4
+        static_assert(QubicBoard::LINES.size() == 76);
+        int sevens = 0;
+        for (int cell = 0; cell < QubicBoard::CELLS; ++cell) {
+            const int count = QubicBoard::CELL_LINES[cell].count;
+            assert(count == 4 || count == 7);
+            if (count == 7) sevens++;
+        }
+        assert(sevens == 16);
+        for (std::uint64_t line : QubicBoard::LINES) {
+            assert(std::popcount(line) == 4);
+        }
+
+        // A space diagonal wins; taking its last piece back undoes the win
+        QubicBoard q;
+        assert(!q.isValidMove(4, 0, 0) && q.isValidMove(3, 3, 3));
+        for (int i = 0; i < 3; ++i) {
+            q.applyMove(i, i, i, 'X');
+            assert(!q.winCheck('X'));
+        }
+        assert(QubicBoard::winningCells(q.getMask('X'), q.getEmptyMask()) == (1ull << 63));
+        q.applyMove(3, 3, 3, 'X');
+        assert(q.winCheck('X') && !q.winCheck('O') && !q.tieCheck());
+        assert(q.getCellValue(3, 3, 3) == 'X' && q.getFilledCells() == 4);
+        q.unmakeMove(63);
+        assert(!q.winCheck('X') && q.getCell(63) == ' ');
+
+        // A blocked line is no threat; two half-open lines through one cell are a fork
+        QubicBoard f;
+        for (int cell : {1, 2, 4, 8}) f.makeMove(cell, 'X');    // row 0 and column 0 of layer 0
+        f.makeMove(3, 'O');                                        // blocks the row
+        const std::uint64_t x = f.getMask('X');
+        assert(QubicBoard::winningCells(x, f.getEmptyMask()) == 0);
+        assert(!(QubicBoard::forkCells(x, f.getEmptyMask()) & 1));
+        f.unmakeMove(3);
+        assert(QubicBoard::forkCells(x, f.getEmptyMask()) & 1);     // cell 0 threatens 3 and 12
+        assert(QubicBoard::wouldWin(x | 1, 3) && !QubicBoard::hasLine(x | 1));
+    }
+
+    // =============================================================
+    // Test 14: MNKBoard makeMove/unmakeMove restore cells, count and winner
+    // =============================================================
+    {
+        MNKBoard b(6, 7, 4);
+        for (int c = 0; c < 3; ++c) {
+            b.makeMove(5, c, 'X');
+        }
+        assert(!b.winCheck('X') && b.getFilledCells() == 3);
+
+        b.makeMove(5, 3, 'X');
+        assert(b.winCheck('X') && b.getLastRow() == 5 && b.getLastCol() == 3);
+        b.unmakeMove(5, 3);
+        assert(!b.winCheck('X') && b.isValidMove(5, 3) && b.getFilledCells() == 3);
+        assert(b.getLastRow() == -1 && b.getLastCol() == -1);
+
+        // Moves made and taken back leave the same position as never playing them
+        b.makeMove(2, 2, 'O');
+        b.makeMove(4, 4, 'X');
+        b.unmakeMove(4, 4);
+        b.unmakeMove(2, 2);
+        MNKBoard same(6, 7, 4);
+        for (int c = 0; c < 3; ++c) {
+            same.applyMove(5, c, 'X');
+        }
+        for (int r = 0; r < 6; ++r) {
+            for (int c = 0; c < 7; ++c) {
+                assert(b.getCellValue(r, c) == same.getCellValue(r, c));
+            }
+        }
+        assert(b.wouldWin(5, 3, 'X') && !b.tieCheck());
+    }
+
     std::cout << "All Board tests passed!\n";
     return 0;
 }
\ No newline at end of file
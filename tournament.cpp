@@ -0,0 +1,65 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "GameRecord.h"
+#include "Tournament.h"
+
+/**
+ * Headless tournament runner.
+ *
+ * Usage: tournament [--games N] [--chunk C] [--threads T] [--seed S] [--record FILE]
+ *   --games    games per pairing (default 1000)
+ *   --chunk    games per job (default 250)
+ *   --threads  worker threads (default: one per hardware thread)
+ *   --seed     base seed, so a run can be reproduced (default 1)
+ *   --record   append every game to a game-record file (see GameRecord.h)
+ */
+int main(int argc, char* argv[]) {
+    Tournament::Config config;
+    const char* recordPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--games") == 0 && hasValue) {
+            config.gamesPerPairing = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--chunk") == 0 && hasValue) {
+            config.chunkSize = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            config.threads = static_cast<std::size_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--record") == 0 && hasValue) {
+            recordPath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--games N] [--chunk C] [--threads T] [--seed S] [--record FILE]\n";
+            return 2;
+        }
+    }
+    if (config.gamesPerPairing <= 0 || config.chunkSize <= 0) {
+        std::cerr << "tournament: --games and --chunk must be positive\n";
+        return 2;
+    }
+
+    GameRecordWriter recorder;
+    if (recordPath != nullptr) {
+        if (!recorder.open(recordPath)) {
+            std::cerr << recorder.getError() << "\n";
+            return 1;
+        }
+        config.recorder = &recorder;
+    }
+
+    Tournament tournament(config);
+    tournament.run();
+    tournament.printMatrix(std::cout);
+
+    if (recordPath != nullptr) {
+        std::cout << recorder.recordsWritten() << " games recorded to " << recordPath
+                  << " in " << recorder.blocksWritten() << " blocks\n";
+        if (!recorder.ok()) {
+            std::cerr << "some games could not be written to " << recordPath << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}